@@ -0,0 +1,246 @@
+#include <math.h>
+#include <stdlib.h>
+#include "ahrs.h"
+
+#define DEG_TO_RAD 0.01745329252f
+#define RAD_TO_DEG 57.29577951f
+
+struct ahrs_t
+{
+    ahrs_config_t config;
+    float q0, q1, q2, q3;       // 四元数 w, x, y, z
+    float ix, iy, iz;           // Mahony 积分项（rad/s）
+    bool initialized;           // 是否已用加速度初始化
+};
+
+static inline float inv_sqrt(float x)
+{
+    return 1.0f / sqrtf(x);
+}
+
+static void ahrs_normalize(struct ahrs_t *a)
+{
+    float n = inv_sqrt(a->q0 * a->q0 + a->q1 * a->q1 + a->q2 * a->q2 + a->q3 * a->q3);
+    a->q0 *= n;
+    a->q1 *= n;
+    a->q2 *= n;
+    a->q3 *= n;
+}
+
+// 由重力方向直接求 roll/pitch，yaw 取 0
+static void ahrs_init_from_acce(struct ahrs_t *a, float ax, float ay, float az)
+{
+    const float roll = atan2f(ay, az);
+    const float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+    const float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+    const float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+
+    a->q0 = cr * cp;
+    a->q1 = sr * cp;
+    a->q2 = cr * sp;
+    a->q3 = -sr * sp;
+    a->initialized = true;
+}
+
+static void ahrs_update_madgwick(struct ahrs_t *a, float ax, float ay, float az, float gx, float gy, float gz, float dt)
+{
+    float q0 = a->q0, q1 = a->q1, q2 = a->q2, q3 = a->q3;
+
+    // 陀螺仪积分得到的四元数变化率
+    float qd0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float qd1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float qd2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float qd3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    const float an = ax * ax + ay * ay + az * az;
+    if (an > 0.0f)
+    {
+        const float rn = inv_sqrt(an);
+        ax *= rn;
+        ay *= rn;
+        az *= rn;
+
+        const float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+        const float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+        const float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+        const float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+
+        // 目标函数梯度
+        float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+        float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+        float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+        float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+        const float sn = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if (sn > 0.0f)
+        {
+            const float rs = inv_sqrt(sn) * a->config.beta;
+            qd0 -= s0 * rs;
+            qd1 -= s1 * rs;
+            qd2 -= s2 * rs;
+            qd3 -= s3 * rs;
+        }
+    }
+
+    a->q0 = q0 + qd0 * dt;
+    a->q1 = q1 + qd1 * dt;
+    a->q2 = q2 + qd2 * dt;
+    a->q3 = q3 + qd3 * dt;
+    ahrs_normalize(a);
+}
+
+static void ahrs_update_mahony(struct ahrs_t *a, float ax, float ay, float az, float gx, float gy, float gz, float dt)
+{
+    const float q0 = a->q0, q1 = a->q1, q2 = a->q2, q3 = a->q3;
+
+    const float an = ax * ax + ay * ay + az * az;
+    if (an > 0.0f)
+    {
+        const float rn = inv_sqrt(an);
+        ax *= rn;
+        ay *= rn;
+        az *= rn;
+
+        // 估计的重力方向（的一半）
+        const float vx = q1 * q3 - q0 * q2;
+        const float vy = q0 * q1 + q2 * q3;
+        const float vz = q0 * q0 - 0.5f + q3 * q3;
+
+        // 测量与估计重力方向的叉积即误差
+        const float ex = ay * vz - az * vy;
+        const float ey = az * vx - ax * vz;
+        const float ez = ax * vy - ay * vx;
+
+        if (a->config.ki > 0.0f)
+        {
+            a->ix += 2.0f * a->config.ki * ex * dt;
+            a->iy += 2.0f * a->config.ki * ey * dt;
+            a->iz += 2.0f * a->config.ki * ez * dt;
+            gx += a->ix;
+            gy += a->iy;
+            gz += a->iz;
+        }
+        else
+        {
+            a->ix = a->iy = a->iz = 0.0f;
+        }
+
+        gx += 2.0f * a->config.kp * ex;
+        gy += 2.0f * a->config.kp * ey;
+        gz += 2.0f * a->config.kp * ez;
+    }
+
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    a->q0 = q0 + (-q1 * gx - q2 * gy - q3 * gz);
+    a->q1 = q1 + (q0 * gx + q2 * gz - q3 * gy);
+    a->q2 = q2 + (q0 * gy - q1 * gz + q3 * gx);
+    a->q3 = q3 + (q0 * gz + q1 * gy - q2 * gx);
+    ahrs_normalize(a);
+}
+
+ahrs_handle_t ahrs_create(const ahrs_config_t *const config)
+{
+    if (!config || (config->algorithm != AHRS_ALGO_MADGWICK && config->algorithm != AHRS_ALGO_MAHONY))
+    {
+        return NULL;
+    }
+
+    struct ahrs_t *a = calloc(1, sizeof(*a));
+    if (!a)
+    {
+        return NULL;
+    }
+    a->config = *config;
+    ahrs_reset(a);
+    return a;
+}
+
+void ahrs_delete(ahrs_handle_t ahrs)
+{
+    free(ahrs);
+}
+
+void ahrs_reset(ahrs_handle_t ahrs)
+{
+    if (!ahrs)
+    {
+        return;
+    }
+    ahrs->q0 = 1.0f;
+    ahrs->q1 = ahrs->q2 = ahrs->q3 = 0.0f;
+    ahrs->ix = ahrs->iy = ahrs->iz = 0.0f;
+    ahrs->initialized = false;
+}
+
+esp_err_t ahrs_set_gains(ahrs_handle_t ahrs, const ahrs_config_t *const config)
+{
+    if (!ahrs || !config || config->algorithm != ahrs->config.algorithm)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ahrs->config = *config;
+    return ESP_OK;
+}
+
+esp_err_t ahrs_update(ahrs_handle_t ahrs, const mpu6050_acce_value_t *const acce_value,
+                      const mpu6050_gyro_value_t *const gyro_value, float dt)
+{
+    if (!ahrs || !acce_value || !gyro_value || !(dt > 0.0f))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!ahrs->initialized)
+    {
+        ahrs_init_from_acce(ahrs, acce_value->acce_x, acce_value->acce_y, acce_value->acce_z);
+        return ESP_OK;
+    }
+
+    const float gx = gyro_value->gyro_x * DEG_TO_RAD;
+    const float gy = gyro_value->gyro_y * DEG_TO_RAD;
+    const float gz = gyro_value->gyro_z * DEG_TO_RAD;
+
+    if (ahrs->config.algorithm == AHRS_ALGO_MADGWICK)
+    {
+        ahrs_update_madgwick(ahrs, acce_value->acce_x, acce_value->acce_y, acce_value->acce_z, gx, gy, gz, dt);
+    }
+    else
+    {
+        ahrs_update_mahony(ahrs, acce_value->acce_x, acce_value->acce_y, acce_value->acce_z, gx, gy, gz, dt);
+    }
+    return ESP_OK;
+}
+
+esp_err_t ahrs_get_quaternion(ahrs_handle_t ahrs, ahrs_quaternion_t *const quaternion)
+{
+    if (!ahrs || !quaternion)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    quaternion->w = ahrs->q0;
+    quaternion->x = ahrs->q1;
+    quaternion->y = ahrs->q2;
+    quaternion->z = ahrs->q3;
+    return ESP_OK;
+}
+
+esp_err_t ahrs_get_euler(ahrs_handle_t ahrs, ahrs_euler_t *const euler)
+{
+    if (!ahrs || !euler)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const float q0 = ahrs->q0, q1 = ahrs->q1, q2 = ahrs->q2, q3 = ahrs->q3;
+
+    float sinp = 2.0f * (q0 * q2 - q1 * q3);
+    if (sinp > 1.0f)
+        sinp = 1.0f;
+    if (sinp < -1.0f)
+        sinp = -1.0f;
+
+    euler->roll = atan2f(q0 * q1 + q2 * q3, 0.5f - q1 * q1 - q2 * q2) * RAD_TO_DEG;
+    euler->pitch = asinf(sinp) * RAD_TO_DEG;
+    euler->yaw = atan2f(q1 * q2 + q0 * q3, 0.5f - q2 * q2 - q3 * q3) * RAD_TO_DEG;
+    return ESP_OK;
+}
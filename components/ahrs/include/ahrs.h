@@ -0,0 +1,127 @@
+/**
+ * @file
+ * @brief 四元数姿态解算（AHRS），支持 Madgwick 与 Mahony 两种更新算法
+ *
+ * 输入与 mpu6050_complimentory_filter 相同（加速度 g、角速度 °/s），输出四元数及
+ * roll/pitch/yaw（度）。仅有六轴数据，yaw 由陀螺仪积分得到，会随零偏缓慢漂移。
+ *
+ * 欧拉角按右手定则：绕 +Y 轴正转（与 gyro_y 为正同向）时 pitch 增大，此时 acce_x 为负。
+ * mpu6050_complimentory_filter() 的俯仰角取 atan2(acce_x, acce_z)，静止倾斜时与本模块
+ * 符号相反（pitch_cf = -pitch_ahrs），roll 两者一致。两种结果混用时需对 pitch 取反。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "esp_err.h"
+#include "mpu6050.h"
+
+    typedef enum
+    {
+        AHRS_ALGO_MADGWICK = 0, /*!< 梯度下降校正，增益 beta */
+        AHRS_ALGO_MAHONY = 1,   /*!< PI 互补校正，增益 kp / ki */
+    } ahrs_algorithm_t;
+
+    typedef struct
+    {
+        ahrs_algorithm_t algorithm;
+        float beta; /*!< Madgwick 增益，典型值 0.03~0.1 */
+        float kp;   /*!< Mahony 比例增益，典型值 0.5~2.0 */
+        float ki;   /*!< Mahony 积分增益（陀螺仪零偏估计），0 表示关闭 */
+    } ahrs_config_t;
+
+    typedef struct
+    {
+        float w;
+        float x;
+        float y;
+        float z;
+    } ahrs_quaternion_t;
+
+    typedef struct
+    {
+        float roll;  /*!< 绕 X 轴（度） */
+        float pitch; /*!< 绕 Y 轴（度），右手定则，与互补滤波的 pitch 符号相反 */
+        float yaw;   /*!< 绕 Z 轴（度），相对上电/复位时的朝向 */
+    } ahrs_euler_t;
+
+    typedef struct ahrs_t *ahrs_handle_t;
+
+    /**
+     * @brief 创建 AHRS 实例，姿态在第一次 ahrs_update() 时由加速度初始化
+     *
+     * @param config algorithm and gains
+     * @return
+     *     - NULL Fail
+     *     - Others Success
+     */
+    ahrs_handle_t ahrs_create(const ahrs_config_t *const config);
+
+    /**
+     * @brief 删除 AHRS 实例
+     *
+     * @param ahrs AHRS handle
+     */
+    void ahrs_delete(ahrs_handle_t ahrs);
+
+    /**
+     * @brief 重置姿态（yaw 归零，roll/pitch 在下一次更新时由加速度重新初始化）
+     *
+     * @param ahrs AHRS handle
+     */
+    void ahrs_reset(ahrs_handle_t ahrs);
+
+    /**
+     * @brief 运行时调整增益，不改变算法
+     *
+     * @param ahrs AHRS handle
+     * @param config new gains; config->algorithm must match the running algorithm
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL or algorithm mismatch
+     */
+    esp_err_t ahrs_set_gains(ahrs_handle_t ahrs, const ahrs_config_t *const config);
+
+    /**
+     * @brief 用一帧六轴数据更新姿态
+     *
+     * @param ahrs AHRS handle
+     * @param acce_value accelerometer measurements (g)
+     * @param gyro_value gyroscope measurements (°/s)
+     * @param dt time since previous sample (s), from sample timestamps
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL or dt is not positive
+     */
+    esp_err_t ahrs_update(ahrs_handle_t ahrs, const mpu6050_acce_value_t *const acce_value,
+                          const mpu6050_gyro_value_t *const gyro_value, float dt);
+
+    /**
+     * @brief 获取当前姿态四元数
+     *
+     * @param ahrs AHRS handle
+     * @param quaternion unit quaternion (body to earth)
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t ahrs_get_quaternion(ahrs_handle_t ahrs, ahrs_quaternion_t *const quaternion);
+
+    /**
+     * @brief 获取当前姿态欧拉角
+     *
+     * @param ahrs AHRS handle
+     * @param euler roll/pitch/yaw in degrees
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t ahrs_get_euler(ahrs_handle_t ahrs, ahrs_euler_t *const euler);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,360 @@
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "i2c_bus_mgr.h"
+
+#define I2C_MGR_DEFAULT_SCL_HZ 400000u
+
+static const char *TAG = "I2C_MGR";
+
+typedef struct
+{
+    i2c_master_dev_handle_t dev; // NULL 表示空闲项
+    uint32_t scl_hz;
+    i2c_mgr_priority_t priority;
+    i2c_mgr_dev_stats_t stats;
+} i2c_mgr_entry_t;
+
+static i2c_mgr_entry_t s_entries[I2C_MGR_MAX_DEVICES];
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED; // 保护 s_entries、窗口起点与仲裁状态
+static int64_t s_window_start_us;
+static esp_timer_handle_t s_log_timer;
+
+// 仲裁：持有总线即持有 s_bus_mutex。等待者阻塞在这个互斥锁上，由内核把持有者提升到等待者的
+// 优先级并在释放时恢复，与任务持有的其他互斥锁的优先级继承互不干扰。
+// 设备优先级：高优先级设备的事务直接等 s_bus_mutex；低优先级设备先经 s_low_lane 排成一队，
+// 同一时刻只有队首在等总线，且只要还有高优先级事务在等，队首就让出总线，
+// 等 s_high_drained 通知后再来
+static SemaphoreHandle_t s_bus_mutex;
+static SemaphoreHandle_t s_low_lane;
+static SemaphoreHandle_t s_high_drained;
+static uint16_t s_high_waiting; // 等待总线的高优先级事务数
+static bool s_low_yielding;     // 低优先级队首正在让路，等 s_high_drained
+
+static i2c_mgr_entry_t *i2c_mgr_find(i2c_master_dev_handle_t dev)
+{
+    for (int i = 0; i < I2C_MGR_MAX_DEVICES; i++)
+    {
+        if (s_entries[i].dev == dev)
+        {
+            return &s_entries[i];
+        }
+    }
+    return NULL;
+}
+
+// 设备挂载在初始化阶段进行，在此顺带创建仲裁用的互斥锁与信号量
+static esp_err_t i2c_mgr_arbiter_init(void)
+{
+    if (NULL == s_bus_mutex)
+    {
+        s_bus_mutex = xSemaphoreCreateMutex();
+    }
+    if (NULL == s_low_lane)
+    {
+        s_low_lane = xSemaphoreCreateMutex();
+    }
+    if (NULL == s_high_drained)
+    {
+        s_high_drained = xSemaphoreCreateBinary();
+    }
+    return (s_bus_mutex && s_low_lane && s_high_drained) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static i2c_mgr_priority_t i2c_mgr_priority_of(i2c_master_dev_handle_t dev)
+{
+    portENTER_CRITICAL(&s_lock);
+    i2c_mgr_entry_t *e = i2c_mgr_find(dev);
+    i2c_mgr_priority_t prio = e ? e->priority : I2C_MGR_PRIO_LOW;
+    portEXIT_CRITICAL(&s_lock);
+    return prio;
+}
+
+// 取得总线使用权，返回等待的微秒数
+static uint32_t i2c_mgr_acquire(i2c_mgr_priority_t prio)
+{
+    const int64_t start_us = esp_timer_get_time();
+
+    if (I2C_MGR_PRIO_LOW != prio)
+    {
+        portENTER_CRITICAL(&s_lock);
+        s_high_waiting++;
+        portEXIT_CRITICAL(&s_lock);
+
+        xSemaphoreTake(s_bus_mutex, portMAX_DELAY);
+
+        bool wake_low = false;
+        portENTER_CRITICAL(&s_lock);
+        if (0 == --s_high_waiting && s_low_yielding)
+        {
+            s_low_yielding = false;
+            wake_low = true;
+        }
+        portEXIT_CRITICAL(&s_lock);
+        if (wake_low)
+        {
+            xSemaphoreGive(s_high_drained);
+        }
+    }
+    else
+    {
+        xSemaphoreTake(s_low_lane, portMAX_DELAY);
+        for (;;)
+        {
+            xSemaphoreTake(s_bus_mutex, portMAX_DELAY);
+            portENTER_CRITICAL(&s_lock);
+            const bool yield = s_high_waiting > 0;
+            s_low_yielding = yield;
+            portEXIT_CRITICAL(&s_lock);
+            if (!yield)
+            {
+                break;
+            }
+            // 最后一个高优先级事务取得总线时通知，只会通知这一次
+            xSemaphoreGive(s_bus_mutex);
+            xSemaphoreTake(s_high_drained, portMAX_DELAY);
+        }
+    }
+    return (uint32_t)(esp_timer_get_time() - start_us);
+}
+
+static void i2c_mgr_release(i2c_mgr_priority_t prio)
+{
+    xSemaphoreGive(s_bus_mutex);
+    if (I2C_MGR_PRIO_LOW == prio)
+    {
+        xSemaphoreGive(s_low_lane);
+    }
+}
+
+esp_err_t i2c_mgr_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config,
+                             const i2c_mgr_device_config_t *mgr_config, i2c_master_dev_handle_t *ret_handle)
+{
+    if (mgr_config && mgr_config->priority >= I2C_MGR_PRIO_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = i2c_mgr_arbiter_init();
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    ret = i2c_master_bus_add_device(bus_handle, dev_config, ret_handle);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    i2c_mgr_entry_t *e = i2c_mgr_find(NULL);
+    if (e)
+    {
+        memset(e, 0, sizeof(*e));
+        e->dev = *ret_handle;
+        e->scl_hz = dev_config->scl_speed_hz ? dev_config->scl_speed_hz : I2C_MGR_DEFAULT_SCL_HZ;
+        e->stats.name = (mgr_config && mgr_config->name) ? mgr_config->name : "i2c";
+        e->stats.address = dev_config->device_address;
+        e->priority = mgr_config ? mgr_config->priority : I2C_MGR_PRIO_LOW;
+    }
+    if (0 == s_window_start_us)
+    {
+        s_window_start_us = esp_timer_get_time();
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (!e)
+    {
+        ESP_LOGW(TAG, "device 0x%02x not tracked, table full", dev_config->device_address);
+    }
+    return ESP_OK;
+}
+
+esp_err_t i2c_mgr_rm_device(i2c_master_dev_handle_t handle)
+{
+    portENTER_CRITICAL(&s_lock);
+    i2c_mgr_entry_t *e = handle ? i2c_mgr_find(handle) : NULL;
+    if (e)
+    {
+        e->dev = NULL;
+    }
+    portEXIT_CRITICAL(&s_lock);
+    return i2c_master_bus_rm_device(handle);
+}
+
+// 记录一次传输；clocks 为 SCL 时钟数，包含 START/STOP 与每字节的 ACK 位
+static void i2c_mgr_account(i2c_master_dev_handle_t dev, esp_err_t ret, size_t bytes, uint32_t clocks,
+                            int64_t start_us, uint32_t wait_us)
+{
+    const uint32_t latency = (uint32_t)(esp_timer_get_time() - start_us);
+
+    portENTER_CRITICAL(&s_lock);
+    i2c_mgr_entry_t *e = i2c_mgr_find(dev);
+    if (e)
+    {
+        i2c_mgr_dev_stats_t *st = &e->stats;
+        st->transactions++;
+        st->errors += (ESP_OK != ret);
+        st->bytes += bytes;
+        st->wire_us += (uint64_t)clocks * 1000000u / e->scl_hz;
+        st->call_us += latency;
+        if (latency > st->max_latency_us)
+        {
+            st->max_latency_us = latency;
+        }
+        st->wait_us += wait_us;
+        if (wait_us > st->max_wait_us)
+        {
+            st->max_wait_us = wait_us;
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+esp_err_t i2c_mgr_transmit(i2c_master_dev_handle_t handle, const uint8_t *write_buffer, size_t write_size,
+                           int xfer_timeout_ms)
+{
+    const int64_t start_us = esp_timer_get_time();
+    const i2c_mgr_priority_t prio = i2c_mgr_priority_of(handle);
+    const uint32_t wait_us = i2c_mgr_acquire(prio);
+    esp_err_t ret = i2c_master_transmit(handle, write_buffer, write_size, xfer_timeout_ms);
+    i2c_mgr_release(prio);
+    // START + 地址字节 + 数据 + STOP
+    i2c_mgr_account(handle, ret, write_size, 2 + 9 * (1 + write_size), start_us, wait_us);
+    return ret;
+}
+
+esp_err_t i2c_mgr_transmit_receive(i2c_master_dev_handle_t handle, const uint8_t *write_buffer,
+                                   size_t write_size, uint8_t *read_buffer, size_t read_size,
+                                   int xfer_timeout_ms)
+{
+    const int64_t start_us = esp_timer_get_time();
+    const i2c_mgr_priority_t prio = i2c_mgr_priority_of(handle);
+    const uint32_t wait_us = i2c_mgr_acquire(prio);
+    esp_err_t ret = i2c_master_transmit_receive(handle, write_buffer, write_size, read_buffer, read_size,
+                                                xfer_timeout_ms);
+    i2c_mgr_release(prio);
+    // START + 写地址 + 写数据 + 重复 START + 读地址 + 读数据 + STOP
+    i2c_mgr_account(handle, ret, write_size + read_size, 3 + 9 * (2 + write_size + read_size), start_us,
+                    wait_us);
+    return ret;
+}
+
+esp_err_t i2c_mgr_multi_buffer_transmit(i2c_master_dev_handle_t handle,
+                                        i2c_master_transmit_multi_buffer_info_t *buffer_info_array,
+                                        size_t array_size, int xfer_timeout_ms)
+{
+    size_t bytes = 0;
+    for (size_t i = 0; buffer_info_array && i < array_size; i++)
+    {
+        bytes += buffer_info_array[i].buffer_size;
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+    const i2c_mgr_priority_t prio = i2c_mgr_priority_of(handle);
+    const uint32_t wait_us = i2c_mgr_acquire(prio);
+    esp_err_t ret = i2c_master_multi_buffer_transmit(handle, buffer_info_array, array_size, xfer_timeout_ms);
+    i2c_mgr_release(prio);
+    // 与 i2c_mgr_transmit() 相同，只有一组 START/地址/STOP
+    i2c_mgr_account(handle, ret, bytes, 2 + 9 * (1 + bytes), start_us, wait_us);
+    return ret;
+}
+
+void i2c_mgr_get_report(i2c_mgr_report_t *const out, bool reset)
+{
+    const int64_t now = esp_timer_get_time();
+    uint64_t wire_us = 0;
+
+    memset(out, 0, sizeof(*out));
+    portENTER_CRITICAL(&s_lock);
+    out->window_us = now - s_window_start_us;
+    for (int i = 0; i < I2C_MGR_MAX_DEVICES; i++)
+    {
+        if (s_entries[i].dev)
+        {
+            out->devices[out->device_count++] = s_entries[i].stats;
+            wire_us += s_entries[i].stats.wire_us;
+            if (reset)
+            {
+                const char *name = s_entries[i].stats.name;
+                const uint16_t address = s_entries[i].stats.address;
+                memset(&s_entries[i].stats, 0, sizeof(s_entries[i].stats));
+                s_entries[i].stats.name = name;
+                s_entries[i].stats.address = address;
+            }
+        }
+    }
+    if (reset)
+    {
+        s_window_start_us = now;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    out->utilization = out->window_us > 0 ? (float)wire_us / (float)out->window_us : 0;
+}
+
+static void i2c_mgr_log_cb(void *arg)
+{
+    i2c_mgr_report_t report;
+    i2c_mgr_get_report(&report, true);
+
+    ESP_LOGI(TAG, "bus %.1f%% busy over %lld ms", report.utilization * 100.0f,
+             (long long)(report.window_us / 1000));
+    for (uint8_t i = 0; i < report.device_count; i++)
+    {
+        const i2c_mgr_dev_stats_t *st = &report.devices[i];
+        ESP_LOGI(TAG, "  %-8s 0x%02x %6lu tx %8llu B wire %6llu us (%.1f%%) call %6llu us max %lu us "
+                      "wait max %lu us err %lu",
+                 st->name, st->address, (unsigned long)st->transactions, (unsigned long long)st->bytes,
+                 (unsigned long long)st->wire_us,
+                 report.window_us > 0 ? st->wire_us * 100.0f / report.window_us : 0.0f,
+                 (unsigned long long)st->call_us, (unsigned long)st->max_latency_us,
+                 (unsigned long)st->max_wait_us, (unsigned long)st->errors);
+    }
+}
+
+esp_err_t i2c_mgr_start_log(uint32_t period_ms)
+{
+    if (0 == period_ms)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_log_timer)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const esp_timer_create_args_t args = {
+        .callback = i2c_mgr_log_cb,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "i2c_mgr_log",
+    };
+    esp_err_t ret = esp_timer_create(&args, &s_log_timer);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    // 丢弃启动前积累的数据，第一份报告覆盖完整的一个周期
+    i2c_mgr_report_t discard;
+    i2c_mgr_get_report(&discard, true);
+    ret = esp_timer_start_periodic(s_log_timer, (uint64_t)period_ms * 1000u);
+    if (ESP_OK != ret)
+    {
+        esp_timer_delete(s_log_timer);
+        s_log_timer = NULL;
+    }
+    return ret;
+}
+
+void i2c_mgr_stop_log(void)
+{
+    if (s_log_timer)
+    {
+        esp_timer_stop(s_log_timer);
+        esp_timer_delete(s_log_timer);
+        s_log_timer = NULL;
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief 共享 I2C 总线的优先级仲裁与事务统计
+ *
+ * 驱动通过 i2c_mgr_add_device() 挂设备，并用 i2c_mgr_transmit() / i2c_mgr_transmit_receive()
+ * 代替 i2c_master_*。每次传输都会记录到所属设备：
+ *   - 事务数、字节数与出错次数；
+ *   - 线上时间：按 SCL 频率估算，每字节 9 个时钟，外加 START/STOP；
+ *   - 调用耗时：包括排队与驱动开销，同时记录最大值。
+ * 统计窗口内全部设备线上时间之和除以窗口长度，即为总线占用率。
+ *
+ * 所有经过本组件的传输都要先取得总线使用权。总线忙时按设备优先级排队：只要还有高优先级设备
+ * 的事务在等，低优先级设备就不会取得总线；同一设备优先级内按任务优先级先后。显示等长传输
+ * 应拆成若干事务发送，每段之间都是让出点，这样 IMU 读取最多只需等待一段的时间，不必等完整帧。每个设备的等待时间单独统计。
+ *
+ * 总线使用权是一个 FreeRTOS 互斥锁，等待者阻塞其上时由内核做优先级继承：低优先级的显示刷新
+ * 任务持有总线期间，IMU 任务来等待，刷新任务就临时提升到 IMU 任务的优先级，不会被中等优先级
+ * 任务抢占而让 IMU 跟着一起等（优先级反转）。本组件从不调用 vTaskPrioritySet()。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/i2c_master.h"
+
+#define I2C_MGR_MAX_DEVICES 8 /*!< 可统计的设备数 */
+
+    typedef enum
+    {
+        I2C_MGR_PRIO_LOW = 0, /*!< 吞吐型设备，如显示屏 */
+        I2C_MGR_PRIO_HIGH,    /*!< 时延敏感设备，如 IMU */
+        I2C_MGR_PRIO_MAX,
+    } i2c_mgr_priority_t;
+
+    typedef struct
+    {
+        const char *name;            /*!< 日志中的设备名，需在设备存续期间有效 */
+        i2c_mgr_priority_t priority; /*!< 等待总线时的优先级 */
+    } i2c_mgr_device_config_t;
+
+    typedef struct
+    {
+        const char *name;        /*!< 设备名 */
+        uint16_t address;        /*!< 7 位地址 */
+        uint32_t transactions;   /*!< 事务数 */
+        uint32_t errors;         /*!< 失败的事务数 */
+        uint64_t bytes;          /*!< 收发字节数（含寄存器地址/控制字节，不含器件地址） */
+        uint64_t wire_us;        /*!< 估算的线上时间 */
+        uint64_t call_us;        /*!< 调用耗时之和 */
+        uint32_t max_latency_us; /*!< 单次调用最大耗时 */
+        uint64_t wait_us;        /*!< 等待总线使用权的时间之和 */
+        uint32_t max_wait_us;    /*!< 单次最长等待 */
+    } i2c_mgr_dev_stats_t;
+
+    typedef struct
+    {
+        int64_t window_us;    /*!< 统计窗口长度 */
+        float utilization;    /*!< 窗口内总线占用率（0 ~ 1） */
+        uint8_t device_count; /*!< devices 中的有效项数 */
+        i2c_mgr_dev_stats_t devices[I2C_MGR_MAX_DEVICES];
+    } i2c_mgr_report_t;
+
+    /**
+     * @brief 挂设备并登记统计项，参数与 i2c_master_bus_add_device() 相同
+     *
+     * 登记表已满时设备仍会挂上，但不计入统计，并按 I2C_MGR_PRIO_LOW 参与仲裁。
+     *
+     * @param bus_handle I2C bus
+     * @param dev_config device config, scl_speed_hz is used for the wire time estimate
+     * @param mgr_config name and priority, may be NULL
+     * @param ret_handle device handle
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG Invalid priority
+     *     - ESP_ERR_NO_MEM Out of memory for the arbiter
+     *     - Others Error from i2c_master_bus_add_device()
+     */
+    esp_err_t i2c_mgr_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config,
+                                 const i2c_mgr_device_config_t *mgr_config, i2c_master_dev_handle_t *ret_handle);
+
+    /**
+     * @brief 注销统计项并从总线上移除设备
+     */
+    esp_err_t i2c_mgr_rm_device(i2c_master_dev_handle_t handle);
+
+    /**
+     * @brief 带仲裁与统计的 i2c_master_transmit()
+     *
+     * xfer_timeout_ms 只约束线上传输，等待总线使用权的时间不受其限制。
+     */
+    esp_err_t i2c_mgr_transmit(i2c_master_dev_handle_t handle, const uint8_t *write_buffer, size_t write_size,
+                               int xfer_timeout_ms);
+
+    /**
+     * @brief 带仲裁与统计的 i2c_master_transmit_receive()
+     */
+    esp_err_t i2c_mgr_transmit_receive(i2c_master_dev_handle_t handle, const uint8_t *write_buffer,
+                                       size_t write_size, uint8_t *read_buffer, size_t read_size,
+                                       int xfer_timeout_ms);
+
+    /**
+     * @brief 带仲裁与统计的 i2c_master_multi_buffer_transmit()
+     *
+     * 多个缓冲区在同一个事务中依次发出，适合在负载前加控制字节而不拷贝负载。
+     */
+    esp_err_t i2c_mgr_multi_buffer_transmit(i2c_master_dev_handle_t handle,
+                                            i2c_master_transmit_multi_buffer_info_t *buffer_info_array,
+                                            size_t array_size, int xfer_timeout_ms);
+
+    /**
+     * @brief 获取当前窗口的统计
+     *
+     * @param out report
+     * @param reset 为 true 时清零统计并开始新窗口
+     */
+    void i2c_mgr_get_report(i2c_mgr_report_t *const out, bool reset);
+
+    /**
+     * @brief 每 period_ms 打印一次报告并开始新窗口
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG period_ms is 0
+     *     - ESP_ERR_INVALID_STATE Already started
+     *     - Others Error from esp_timer
+     */
+    esp_err_t i2c_mgr_start_log(uint32_t period_ms);
+
+    /**
+     * @brief 停止周期打印
+     */
+    void i2c_mgr_stop_log(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,255 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "imu_filter.h"
+
+#define IMU_FILTER_PI 3.14159265358979f
+#define IMU_FILTER_COEF_SHIFT 14         // Q14 系数，可表示 [-2, 2)，覆盖 a1/b1 的取值范围
+#define IMU_FILTER_RAW_BLOCK 32          // process_raw 每次转置的帧数
+
+// 一节二阶滤波器的系数（已按 a0 归一化）
+typedef struct
+{
+    float b0, b1, b2, a1, a2;
+} imu_biquad_f32_t;
+
+typedef struct
+{
+    int32_t b0, b1, b2, a1, a2; // Q14
+} imu_biquad_q15_t;
+
+// Q15 内核使用直接 I 型，状态即最近两个输入/输出，外加截位误差反馈
+typedef struct
+{
+    int16_t x1, x2, y1, y2;
+    int32_t err;
+} imu_biquad_q15_state_t;
+
+struct imu_filter_t
+{
+    uint8_t stage_count;
+    imu_biquad_f32_t coef_f32[IMU_FILTER_MAX_STAGES];
+    imu_biquad_q15_t coef_q15[IMU_FILTER_MAX_STAGES];
+    // 按 [节][通道] 排列，同一节的六个通道相邻
+    float state_f32[IMU_FILTER_MAX_STAGES][IMU_FILTER_CHANNELS][2];
+    imu_biquad_q15_state_t state_q15[IMU_FILTER_MAX_STAGES][IMU_FILTER_CHANNELS];
+};
+
+static bool imu_filter_design(const imu_filter_stage_config_t *stage, float fs, imu_biquad_f32_t *out)
+{
+    if (stage->freq_hz <= 0 || stage->freq_hz >= fs * 0.5f || stage->q <= 0)
+    {
+        return false;
+    }
+
+    const float w0 = 2.0f * IMU_FILTER_PI * stage->freq_hz / fs;
+    const float cw = cosf(w0);
+    const float alpha = sinf(w0) / (2.0f * stage->q);
+    const float inv_a0 = 1.0f / (1.0f + alpha);
+
+    switch (stage->type)
+    {
+    case IMU_FILTER_LOWPASS:
+        out->b0 = (1.0f - cw) * 0.5f * inv_a0;
+        out->b1 = (1.0f - cw) * inv_a0;
+        out->b2 = out->b0;
+        break;
+    case IMU_FILTER_NOTCH:
+        out->b0 = inv_a0;
+        out->b1 = -2.0f * cw * inv_a0;
+        out->b2 = inv_a0;
+        break;
+    default:
+        return false;
+    }
+    out->a1 = -2.0f * cw * inv_a0;
+    out->a2 = (1.0f - alpha) * inv_a0;
+    return true;
+}
+
+static inline int32_t imu_filter_to_q14(float v)
+{
+    return (int32_t)lroundf(v * (1 << IMU_FILTER_COEF_SHIFT));
+}
+
+imu_filter_handle_t imu_filter_create(const imu_filter_config_t *const config)
+{
+    if (NULL == config || config->sample_rate_hz <= 0 || 0 == config->stage_count ||
+        config->stage_count > IMU_FILTER_MAX_STAGES)
+    {
+        return NULL;
+    }
+
+    struct imu_filter_t *f = calloc(1, sizeof(*f));
+    if (!f)
+    {
+        return NULL;
+    }
+
+    f->stage_count = config->stage_count;
+    for (uint8_t i = 0; i < config->stage_count; i++)
+    {
+        imu_biquad_f32_t *c = &f->coef_f32[i];
+        if (!imu_filter_design(&config->stages[i], config->sample_rate_hz, c))
+        {
+            free(f);
+            return NULL;
+        }
+        f->coef_q15[i].b0 = imu_filter_to_q14(c->b0);
+        f->coef_q15[i].b1 = imu_filter_to_q14(c->b1);
+        f->coef_q15[i].b2 = imu_filter_to_q14(c->b2);
+        f->coef_q15[i].a1 = imu_filter_to_q14(c->a1);
+        f->coef_q15[i].a2 = imu_filter_to_q14(c->a2);
+    }
+    return f;
+}
+
+void imu_filter_delete(imu_filter_handle_t filter)
+{
+    free(filter);
+}
+
+void imu_filter_reset(imu_filter_handle_t filter)
+{
+    if (filter)
+    {
+        memset(filter->state_f32, 0, sizeof(filter->state_f32));
+        memset(filter->state_q15, 0, sizeof(filter->state_q15));
+    }
+}
+
+// 转置直接 II 型，状态与系数在循环内保存在局部变量中
+static void imu_biquad_f32_run(const imu_biquad_f32_t *c, float state[2], float *data, size_t count)
+{
+    const float b0 = c->b0, b1 = c->b1, b2 = c->b2, a1 = c->a1, a2 = c->a2;
+    float s1 = state[0], s2 = state[1];
+
+    for (size_t n = 0; n < count; n++)
+    {
+        const float x = data[n];
+        const float y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+        data[n] = y;
+    }
+    state[0] = s1;
+    state[1] = s2;
+}
+
+static void imu_biquad_q15_run(const imu_biquad_q15_t *c, imu_biquad_q15_state_t *st, int16_t *data, size_t count)
+{
+    const int32_t b0 = c->b0, b1 = c->b1, b2 = c->b2, a1 = c->a1, a2 = c->a2;
+    int32_t x1 = st->x1, x2 = st->x2, y1 = st->y1, y2 = st->y2;
+    int32_t err = st->err;
+
+    for (size_t n = 0; n < count; n++)
+    {
+        const int32_t x = data[n];
+        // 五项 Q15×Q14 乘积之和可能超出 32 位，用 64 位累加
+        int64_t acc = (int64_t)b0 * x + (int64_t)b1 * x1 + (int64_t)b2 * x2 - (int64_t)a1 * y1 - (int64_t)a2 * y2;
+        acc += err; // 把上次截掉的余数加回，低截止频率时可明显降低量化噪声
+        int32_t y = (int32_t)(acc >> IMU_FILTER_COEF_SHIFT);
+        err = (int32_t)(acc - ((int64_t)y << IMU_FILTER_COEF_SHIFT));
+        if (y > INT16_MAX)
+        {
+            y = INT16_MAX;
+        }
+        else if (y < INT16_MIN)
+        {
+            y = INT16_MIN;
+        }
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        data[n] = (int16_t)y;
+    }
+    st->x1 = (int16_t)x1;
+    st->x2 = (int16_t)x2;
+    st->y1 = (int16_t)y1;
+    st->y2 = (int16_t)y2;
+    st->err = err;
+}
+
+esp_err_t imu_filter_process_f32(imu_filter_handle_t filter, float *const channels[IMU_FILTER_CHANNELS],
+                                 size_t count)
+{
+    if (NULL == filter || NULL == channels)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int ch = 0; ch < IMU_FILTER_CHANNELS; ch++)
+    {
+        if (NULL == channels[ch])
+        {
+            continue;
+        }
+        for (uint8_t i = 0; i < filter->stage_count; i++)
+        {
+            imu_biquad_f32_run(&filter->coef_f32[i], filter->state_f32[i][ch], channels[ch], count);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t imu_filter_process_q15(imu_filter_handle_t filter, int16_t *const channels[IMU_FILTER_CHANNELS],
+                                 size_t count)
+{
+    if (NULL == filter || NULL == channels)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int ch = 0; ch < IMU_FILTER_CHANNELS; ch++)
+    {
+        if (NULL == channels[ch])
+        {
+            continue;
+        }
+        for (uint8_t i = 0; i < filter->stage_count; i++)
+        {
+            imu_biquad_q15_run(&filter->coef_q15[i], &filter->state_q15[i][ch], channels[ch], count);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t imu_filter_process_raw(imu_filter_handle_t filter, mpu6050_raw_motion_value_t *const frames,
+                                 size_t count)
+{
+    if (NULL == filter || NULL == frames)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int16_t soa[IMU_FILTER_CHANNELS][IMU_FILTER_RAW_BLOCK];
+    int16_t *const channels[IMU_FILTER_CHANNELS] = {soa[0], soa[1], soa[2], soa[3], soa[4], soa[5]};
+
+    for (size_t base = 0; base < count; base += IMU_FILTER_RAW_BLOCK)
+    {
+        const size_t n = (count - base) < IMU_FILTER_RAW_BLOCK ? (count - base) : IMU_FILTER_RAW_BLOCK;
+        mpu6050_raw_motion_value_t *block = &frames[base];
+
+        for (size_t i = 0; i < n; i++)
+        {
+            soa[0][i] = block[i].raw_acce.raw_acce_x;
+            soa[1][i] = block[i].raw_acce.raw_acce_y;
+            soa[2][i] = block[i].raw_acce.raw_acce_z;
+            soa[3][i] = block[i].raw_gyro.raw_gyro_x;
+            soa[4][i] = block[i].raw_gyro.raw_gyro_y;
+            soa[5][i] = block[i].raw_gyro.raw_gyro_z;
+        }
+        imu_filter_process_q15(filter, channels, n);
+        for (size_t i = 0; i < n; i++)
+        {
+            block[i].raw_acce.raw_acce_x = soa[0][i];
+            block[i].raw_acce.raw_acce_y = soa[1][i];
+            block[i].raw_acce.raw_acce_z = soa[2][i];
+            block[i].raw_gyro.raw_gyro_x = soa[3][i];
+            block[i].raw_gyro.raw_gyro_y = soa[4][i];
+            block[i].raw_gyro.raw_gyro_z = soa[5][i];
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @brief 六轴 IMU 级联双二阶（biquad）滤波器组，提供浮点与 Q15 两种内核
+ *
+ * 六个通道（加速度 X/Y/Z、角速度 X/Y/Z）共用同一组级联系数，状态与数据均按
+ * 结构体数组（SoA）排列：每个通道的样本连续存放，内核对一个通道一次处理一整批样本，
+ * 系数和状态可常驻寄存器。适合在 FIFO 批量读出后整批滤波，用于融合前抑制电机振动。
+ *
+ * 系数按 RBJ Audio EQ Cookbook 设计，支持低通与陷波。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "mpu6050.h"
+
+#define IMU_FILTER_CHANNELS 6   /*!< 通道顺序：acce_x/y/z、gyro_x/y/z */
+#define IMU_FILTER_MAX_STAGES 4 /*!< 最多级联的二阶节数 */
+
+    typedef enum
+    {
+        IMU_FILTER_LOWPASS = 0, /*!< 二阶低通，q 取 0.7071 为巴特沃斯 */
+        IMU_FILTER_NOTCH = 1,   /*!< 陷波，q 越大陷波越窄 */
+    } imu_filter_type_t;
+
+    typedef struct
+    {
+        imu_filter_type_t type;
+        float freq_hz; /*!< 截止/中心频率，需低于采样率的一半 */
+        float q;       /*!< 品质因数，需大于 0 */
+    } imu_filter_stage_config_t;
+
+    typedef struct
+    {
+        float sample_rate_hz; /*!< 输入采样率（即 MPU6050 ODR） */
+        uint8_t stage_count;  /*!< 级联节数，1 ~ IMU_FILTER_MAX_STAGES */
+        imu_filter_stage_config_t stages[IMU_FILTER_MAX_STAGES];
+    } imu_filter_config_t;
+
+    typedef struct imu_filter_t *imu_filter_handle_t;
+
+    /**
+     * @brief 创建滤波器组并计算浮点与 Q15 系数
+     *
+     * @param config sample rate and stage list
+     * @return
+     *     - NULL Fail (out of memory or invalid config)
+     *     - Others Success
+     */
+    imu_filter_handle_t imu_filter_create(const imu_filter_config_t *const config);
+
+    /**
+     * @brief 释放滤波器组
+     *
+     * @param filter filter handle
+     */
+    void imu_filter_delete(imu_filter_handle_t filter);
+
+    /**
+     * @brief 清零所有通道的浮点与 Q15 状态
+     *
+     * @param filter filter handle
+     */
+    void imu_filter_reset(imu_filter_handle_t filter);
+
+    /**
+     * @brief 浮点内核：原地滤波一批 SoA 样本
+     *
+     * @param filter filter handle
+     * @param channels IMU_FILTER_CHANNELS 个通道指针，每个指向 count 个样本，可为 NULL 跳过该通道
+     * @param count 每通道样本数
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t imu_filter_process_f32(imu_filter_handle_t filter, float *const channels[IMU_FILTER_CHANNELS],
+                                     size_t count);
+
+    /**
+     * @brief Q15 内核：原地滤波一批 SoA 原始样本（int16 即满量程的 Q15 表示）
+     *
+     * 系数为 Q14，64 位累加，输出饱和到 int16。与浮点内核状态独立。
+     *
+     * @param filter filter handle
+     * @param channels IMU_FILTER_CHANNELS 个通道指针，每个指向 count 个样本，可为 NULL 跳过该通道
+     * @param count 每通道样本数
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t imu_filter_process_q15(imu_filter_handle_t filter, int16_t *const channels[IMU_FILTER_CHANNELS],
+                                     size_t count);
+
+    /**
+     * @brief 原地滤波一批原始帧（例如 mpu6050_fifo_read_frames() 的输出）
+     *
+     * 内部按块转置为 SoA 后调用 Q15 内核，温度通道不处理。
+     *
+     * @param filter filter handle
+     * @param frames raw frames
+     * @param count number of frames
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t imu_filter_process_raw(imu_filter_handle_t filter, mpu6050_raw_motion_value_t *const frames,
+                                     size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,371 @@
+#include <stdlib.h>
+#include <string.h>
+#include "imu_record.h"
+#include "mpu6050_calib.h"
+
+#define IMU_RECORD_MAGIC 0x524D5549u // "IMUR"，小端序
+#define IMU_RECORD_DEFAULT_BUFFER 512
+
+struct imu_record_writer_t
+{
+    imu_record_writer_config_t config;
+    uint8_t *buf;
+    size_t used;
+    bool started;
+    bool failed; // sink 出错，文件末尾可能有半条记录，不能再追加
+    int64_t last_timestamp_us;
+};
+
+struct imu_record_reader_t
+{
+    imu_record_source_t source;
+    void *ctx;
+    imu_record_header_t header;
+    int64_t timestamp_us;
+};
+
+// 小端序读写，不依赖结构体布局与主机字节序
+static inline void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v)
+{
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline void put_u64(uint8_t *p, uint64_t v)
+{
+    put_u32(p, (uint32_t)v);
+    put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static inline void put_f32(uint8_t *p, float v)
+{
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    put_u32(p, u);
+}
+
+static inline uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get_u32(const uint8_t *p)
+{
+    return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+static inline uint64_t get_u64(const uint8_t *p)
+{
+    return get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+}
+
+static inline float get_f32(const uint8_t *p)
+{
+    uint32_t u = get_u32(p);
+    float v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+esp_err_t imu_record_header_from_sensor(mpu6050_handle_t sensor, int64_t base_timestamp_us,
+                                        imu_record_header_t *const out)
+{
+    if (NULL == sensor || NULL == out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->version = IMU_RECORD_VERSION;
+    out->base_timestamp_us = base_timestamp_us;
+    mpu6050_get_full_scale(sensor, &out->acce_fs, &out->gyro_fs);
+    mpu6050_get_sample_period(sensor, &out->sample_period_us);
+    mpu6050_get_acce_sensitivity(sensor, &out->acce_sensitivity);
+    mpu6050_get_gyro_sensitivity(sensor, &out->gyro_sensitivity);
+    mpu6050_get_software_bias(sensor, out->acce_bias, out->gyro_bias);
+    return ESP_OK;
+}
+
+imu_record_writer_handle_t imu_record_writer_create(const imu_record_writer_config_t *const config)
+{
+    if (NULL == config || NULL == config->sink)
+    {
+        return NULL;
+    }
+    const size_t size = config->buffer_size ? config->buffer_size : IMU_RECORD_DEFAULT_BUFFER;
+    if (size < IMU_RECORD_HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    struct imu_record_writer_t *w = calloc(1, sizeof(*w));
+    if (!w)
+    {
+        return NULL;
+    }
+    w->buf = malloc(size);
+    if (!w->buf)
+    {
+        free(w);
+        return NULL;
+    }
+    w->config = *config;
+    w->config.buffer_size = size;
+    return w;
+}
+
+void imu_record_writer_delete(imu_record_writer_handle_t writer)
+{
+    if (writer)
+    {
+        free(writer->buf);
+        free(writer);
+    }
+}
+
+esp_err_t imu_record_writer_flush(imu_record_writer_handle_t writer)
+{
+    if (NULL == writer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (writer->failed)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (0 == writer->used)
+    {
+        return ESP_OK;
+    }
+
+    esp_err_t ret = writer->config.sink(writer->config.ctx, writer->buf, writer->used);
+    if (ESP_OK != ret)
+    {
+        // 不知道写出了多少，重试会在半条记录后面接上完整记录，读取时整体错位
+        writer->failed = true;
+        return ret;
+    }
+    writer->used = 0;
+    return ESP_OK;
+}
+
+esp_err_t imu_record_writer_begin(imu_record_writer_handle_t writer, const imu_record_header_t *const header)
+{
+    if (NULL == writer || NULL == header)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t *p = writer->buf;
+    memset(p, 0, IMU_RECORD_HEADER_SIZE);
+    put_u32(p + 0, IMU_RECORD_MAGIC);
+    put_u16(p + 4, IMU_RECORD_VERSION);
+    put_u16(p + 6, IMU_RECORD_HEADER_SIZE);
+    p[8] = (uint8_t)header->acce_fs;
+    p[9] = (uint8_t)header->gyro_fs;
+    put_u32(p + 12, header->sample_period_us);
+    put_u64(p + 16, (uint64_t)header->base_timestamp_us);
+    put_f32(p + 24, header->acce_sensitivity);
+    put_f32(p + 28, header->gyro_sensitivity);
+    for (int i = 0; i < 3; i++)
+    {
+        put_f32(p + 32 + 4 * i, header->acce_bias[i]);
+        put_f32(p + 44 + 4 * i, header->gyro_bias[i]);
+    }
+
+    writer->used = IMU_RECORD_HEADER_SIZE;
+    writer->started = true;
+    writer->failed = false;
+    writer->last_timestamp_us = header->base_timestamp_us;
+    return imu_record_writer_flush(writer);
+}
+
+esp_err_t imu_record_writer_append(imu_record_writer_handle_t writer, const mpu6050_sample_t *samples,
+                                   size_t count)
+{
+    if (NULL == writer || NULL == samples)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!writer->started || writer->failed)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // 先检查整批时间戳，参数错误时不留下半批数据
+    int64_t last = writer->last_timestamp_us;
+    for (size_t i = 0; i < count; i++)
+    {
+        const int64_t delta = samples[i].timestamp_us - last;
+        if (delta < 0 || delta > (int64_t)UINT32_MAX)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+        last = samples[i].timestamp_us;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const mpu6050_sample_t *s = &samples[i];
+        const int64_t delta = s->timestamp_us - writer->last_timestamp_us;
+        if (writer->used + IMU_RECORD_ENTRY_SIZE > writer->config.buffer_size)
+        {
+            esp_err_t ret = imu_record_writer_flush(writer);
+            if (ESP_OK != ret)
+            {
+                return ret;
+            }
+        }
+
+        uint8_t *p = writer->buf + writer->used;
+        put_u32(p + 0, (uint32_t)delta);
+        put_u16(p + 4, (uint16_t)s->raw.raw_acce.raw_acce_x);
+        put_u16(p + 6, (uint16_t)s->raw.raw_acce.raw_acce_y);
+        put_u16(p + 8, (uint16_t)s->raw.raw_acce.raw_acce_z);
+        put_u16(p + 10, (uint16_t)s->raw.raw_temp);
+        put_u16(p + 12, (uint16_t)s->raw.raw_gyro.raw_gyro_x);
+        put_u16(p + 14, (uint16_t)s->raw.raw_gyro.raw_gyro_y);
+        put_u16(p + 16, (uint16_t)s->raw.raw_gyro.raw_gyro_z);
+        writer->used += IMU_RECORD_ENTRY_SIZE;
+        writer->last_timestamp_us = s->timestamp_us;
+    }
+    return ESP_OK;
+}
+
+esp_err_t imu_record_reader_open(imu_record_source_t source, void *ctx, imu_record_reader_handle_t *const out,
+                                 imu_record_header_t *const header)
+{
+    if (NULL == source || NULL == out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t p[IMU_RECORD_HEADER_SIZE];
+    esp_err_t ret = source(ctx, p, IMU_RECORD_HEADER_SIZE);
+    if (ESP_ERR_NOT_FOUND == ret)
+    {
+        return ESP_ERR_INVALID_VERSION; // 连头部都不完整
+    }
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    if (IMU_RECORD_MAGIC != get_u32(p) || IMU_RECORD_VERSION != get_u16(p + 4) ||
+        IMU_RECORD_HEADER_SIZE != get_u16(p + 6) || p[8] > ACCE_FS_16G || p[9] > GYRO_FS_2000DPS)
+    {
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    struct imu_record_reader_t *r = calloc(1, sizeof(*r));
+    if (!r)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    r->source = source;
+    r->ctx = ctx;
+    r->header.version = IMU_RECORD_VERSION;
+    r->header.acce_fs = (mpu6050_acce_fs_t)p[8];
+    r->header.gyro_fs = (mpu6050_gyro_fs_t)p[9];
+    r->header.sample_period_us = get_u32(p + 12);
+    r->header.base_timestamp_us = (int64_t)get_u64(p + 16);
+    r->header.acce_sensitivity = get_f32(p + 24);
+    r->header.gyro_sensitivity = get_f32(p + 28);
+    for (int i = 0; i < 3; i++)
+    {
+        r->header.acce_bias[i] = get_f32(p + 32 + 4 * i);
+        r->header.gyro_bias[i] = get_f32(p + 44 + 4 * i);
+    }
+    r->timestamp_us = r->header.base_timestamp_us;
+
+    if (header)
+    {
+        *header = r->header;
+    }
+    *out = r;
+    return ESP_OK;
+}
+
+void imu_record_reader_close(imu_record_reader_handle_t reader)
+{
+    free(reader);
+}
+
+mpu6050_handle_t imu_record_reader_create_sensor(imu_record_reader_handle_t reader)
+{
+    if (NULL == reader)
+    {
+        return NULL;
+    }
+
+    mpu6050_handle_t sensor = mpu6050_create(NULL, 0);
+    if (!sensor)
+    {
+        return NULL;
+    }
+
+    // 记录的是原始数据，换算时按记录当时的方式扣除软件零偏
+    mpu6050_calib_t calib = {.hw_offsets = false};
+    memcpy(calib.acce_bias, reader->header.acce_bias, sizeof(calib.acce_bias));
+    memcpy(calib.gyro_bias, reader->header.gyro_bias, sizeof(calib.gyro_bias));
+    if (ESP_OK != mpu6050_config(sensor, reader->header.acce_fs, reader->header.gyro_fs) ||
+        ESP_OK != mpu6050_set_calibration(sensor, &calib))
+    {
+        mpu6050_delete(sensor);
+        return NULL;
+    }
+    return sensor;
+}
+
+esp_err_t imu_record_reader_next(imu_record_reader_handle_t reader, mpu6050_handle_t sensor,
+                                 mpu6050_sample_t *const sample)
+{
+    if (NULL == reader || NULL == sample)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t p[IMU_RECORD_ENTRY_SIZE];
+    esp_err_t ret = reader->source(reader->ctx, p, sizeof(p));
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    reader->timestamp_us += get_u32(p);
+    sample->timestamp_us = reader->timestamp_us;
+    sample->raw.raw_acce.raw_acce_x = (int16_t)get_u16(p + 4);
+    sample->raw.raw_acce.raw_acce_y = (int16_t)get_u16(p + 6);
+    sample->raw.raw_acce.raw_acce_z = (int16_t)get_u16(p + 8);
+    sample->raw.raw_temp = (int16_t)get_u16(p + 10);
+    sample->raw.raw_gyro.raw_gyro_x = (int16_t)get_u16(p + 12);
+    sample->raw.raw_gyro.raw_gyro_y = (int16_t)get_u16(p + 14);
+    sample->raw.raw_gyro.raw_gyro_z = (int16_t)get_u16(p + 16);
+
+    if (sensor)
+    {
+        return mpu6050_convert_motion(sensor, &sample->raw, &sample->acce, &sample->gyro, &sample->temp);
+    }
+    return ESP_OK;
+}
+
+esp_err_t imu_record_mem_read(void *ctx, void *data, size_t len)
+{
+    imu_record_mem_source_t *src = (imu_record_mem_source_t *)ctx;
+    if (NULL == src || NULL == data)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (src->size - src->pos < len)
+    {
+        return ESP_ERR_NOT_FOUND; // 末尾不足一条记录视为结束
+    }
+    memcpy(data, src->data + src->pos, len);
+    src->pos += len;
+    return ESP_OK;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file
+ * @brief MPU6050 原始数据的紧凑二进制记录格式、流式写入与回放
+ *
+ * 文件由一个 56 字节头部和若干 18 字节记录组成，全部为小端序：
+ *
+ *   头部：magic "IMUR" | version u16 | header_size u16 | acce_fs u8 | gyro_fs u8 | reserved u16 |
+ *         sample_period_us u32 | base_timestamp_us i64 | acce_sensitivity f32 | gyro_sensitivity f32 |
+ *         acce_bias f32[3] | gyro_bias f32[3]
+ *   记录：delta_us u32 | acce_x/y/z i16 | temp i16 | gyro_x/y/z i16
+ *
+ * delta_us 为与上一条记录（第一条为 base_timestamp_us）的时间差。记录内容与 14 字节突发读取
+ * 的寄存器顺序一致（硬件偏置已包含在内），头部保存记录时驱动在换算中扣除的软件零偏。
+ * 回放时用 imu_record_reader_create_sensor() 创建的离线句柄按头部量程与零偏换算，
+ * 可直接喂给 mpu6050_complimentory_filter() 和其他姿态算法，结果与在板上运行一致。
+ *
+ * 写出失败时无法得知 sink 已写入多少字节，文件末尾可能是半条记录。写入器此后拒绝继续追加，
+ * 保证文件只有末尾可能不完整；读取器把末尾不足一条的数据视为结束（ESP_ERR_NOT_FOUND）。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "mpu6050.h"
+
+#define IMU_RECORD_VERSION 1u
+#define IMU_RECORD_HEADER_SIZE 56u /*!< 序列化后的头部字节数 */
+#define IMU_RECORD_ENTRY_SIZE 18u  /*!< 序列化后的单条记录字节数 */
+
+    typedef struct
+    {
+        uint16_t version;           /*!< 格式版本，读取时填写 */
+        mpu6050_acce_fs_t acce_fs;  /*!< 加速度计量程 */
+        mpu6050_gyro_fs_t gyro_fs;  /*!< 陀螺仪量程 */
+        uint32_t sample_period_us;  /*!< 采样周期（仅供参考，回放以记录时间戳为准） */
+        int64_t base_timestamp_us;  /*!< 时间戳基准 */
+        float acce_sensitivity;     /*!< LSB/g */
+        float gyro_sensitivity;     /*!< LSB/(°/s) */
+        float acce_bias[3];         /*!< 换算时扣除的加速度计零偏（g），见 mpu6050_get_software_bias() */
+        float gyro_bias[3];         /*!< 换算时扣除的陀螺仪零偏（°/s） */
+    } imu_record_header_t;
+
+    /**
+     * @brief 写出回调，需完整写入 len 字节
+     */
+    typedef esp_err_t (*imu_record_sink_t)(void *ctx, const void *data, size_t len);
+
+    /**
+     * @brief 读取回调，需完整读出 len 字节；数据已结束或剩余不足 len 字节时返回 ESP_ERR_NOT_FOUND
+     */
+    typedef esp_err_t (*imu_record_source_t)(void *ctx, void *data, size_t len);
+
+    typedef struct
+    {
+        imu_record_sink_t sink; /*!< 写出回调 */
+        void *ctx;              /*!< 透传给 sink */
+        size_t buffer_size;     /*!< 写缓冲字节数，0 使用默认值 512，至少能容纳头部 */
+    } imu_record_writer_config_t;
+
+    typedef struct imu_record_writer_t *imu_record_writer_handle_t;
+    typedef struct imu_record_reader_t *imu_record_reader_handle_t;
+
+    /**
+     * @brief 内存数据源，配合 imu_record_mem_read() 回放整块读入的记录
+     */
+    typedef struct
+    {
+        const uint8_t *data;
+        size_t size;
+        size_t pos;
+    } imu_record_mem_source_t;
+
+    /**
+     * @brief 用传感器当前量程、采样周期与软件零偏填写头部
+     *
+     * @param sensor object handle of mpu6050
+     * @param base_timestamp_us timestamp base, normally the first sample's timestamp
+     * @param out header
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t imu_record_header_from_sensor(mpu6050_handle_t sensor, int64_t base_timestamp_us,
+                                            imu_record_header_t *const out);
+
+    /**
+     * @brief 创建写入器
+     *
+     * @param config sink and buffer size
+     * @return
+     *     - NULL Fail
+     *     - Others Success
+     */
+    imu_record_writer_handle_t imu_record_writer_create(const imu_record_writer_config_t *const config);
+
+    /**
+     * @brief 释放写入器，不会自动 flush
+     */
+    void imu_record_writer_delete(imu_record_writer_handle_t writer);
+
+    /**
+     * @brief 开始一段新记录：丢弃未写出的数据、清除写出错误并写入头部
+     *
+     * 写出出错后再次开始时 sink 应指向新的文件，旧文件末尾可能残留半条记录。
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - Others Error from the sink
+     */
+    esp_err_t imu_record_writer_begin(imu_record_writer_handle_t writer, const imu_record_header_t *const header);
+
+    /**
+     * @brief 追加采样（只记录时间戳与原始数据），缓冲满时调用 sink
+     *
+     * 时间戳先对整批检查，参数错误时一条也不追加。sink 出错时本批中之前的采样可能已部分写出，
+     * 写入器进入出错状态，之后的 append/flush 返回 ESP_ERR_INVALID_STATE，直到重新 begin。
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL, or timestamps go backwards / gap exceeds 32 bits
+     *     - ESP_ERR_INVALID_STATE imu_record_writer_begin() not called, or an earlier write failed
+     *     - Others Error from the sink
+     */
+    esp_err_t imu_record_writer_append(imu_record_writer_handle_t writer, const mpu6050_sample_t *samples,
+                                       size_t count);
+
+    /**
+     * @brief 写出缓冲区中的全部数据，出错后同样进入出错状态
+     */
+    esp_err_t imu_record_writer_flush(imu_record_writer_handle_t writer);
+
+    /**
+     * @brief 打开记录并解析头部
+     *
+     * @param source read callback
+     * @param ctx passed to source
+     * @param out reader handle
+     * @param header parsed header, may be NULL
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_ERR_INVALID_VERSION Not a record or unsupported version
+     *     - ESP_ERR_NO_MEM Out of memory
+     *     - Others Error from the source
+     */
+    esp_err_t imu_record_reader_open(imu_record_source_t source, void *ctx, imu_record_reader_handle_t *const out,
+                                     imu_record_header_t *const header);
+
+    /**
+     * @brief 释放读取器
+     */
+    void imu_record_reader_close(imu_record_reader_handle_t reader);
+
+    /**
+     * @brief 创建与记录量程、软件零偏一致的离线传感器句柄，用 mpu6050_delete() 释放
+     *
+     * @return
+     *     - NULL Fail
+     *     - Others Success
+     */
+    mpu6050_handle_t imu_record_reader_create_sensor(imu_record_reader_handle_t reader);
+
+    /**
+     * @brief 读取下一条记录
+     *
+     * sensor 非 NULL 时用它换算物理量（通常来自 imu_record_reader_create_sensor()），
+     * 否则只填写 timestamp_us 与 raw。
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_ERR_NOT_FOUND End of record, including a truncated last record
+     *     - Others Error from the source
+     */
+    esp_err_t imu_record_reader_next(imu_record_reader_handle_t reader, mpu6050_handle_t sensor,
+                                     mpu6050_sample_t *const sample);
+
+    /**
+     * @brief imu_record_source_t 的内存实现，ctx 为 imu_record_mem_source_t
+     */
+    esp_err_t imu_record_mem_read(void *ctx, void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
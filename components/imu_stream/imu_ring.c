@@ -0,0 +1,78 @@
+#include <string.h>
+#include "imu_ring.h"
+
+#define IMU_RING_MASK (IMU_RING_CAPACITY - 1u)
+
+void imu_ring_push(imu_ring_t *ring, const mpu6050_sample_t *sample)
+{
+    const uint32_t head = ring->head; // 唯一写者，无需原子读
+    ring->samples[head & IMU_RING_MASK] = *sample;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void imu_ring_push_batch(imu_ring_t *ring, const mpu6050_sample_t *samples, size_t count)
+{
+    // 逐帧发布：读者只为序号 head 这一个槽位留了余量，若先写完整批再更新 head，
+    // 读者可能把正被覆盖的 count - 1 个槽位当作有效帧读走
+    uint32_t head = ring->head;
+    for (size_t i = 0; i < count; i++)
+    {
+        ring->samples[head & IMU_RING_MASK] = samples[i];
+        head++;
+        __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+    }
+}
+
+void imu_ring_reader_init(imu_ring_reader_t *reader, const imu_ring_t *ring)
+{
+    reader->ring = ring;
+    reader->cursor = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    reader->overruns = 0;
+}
+
+uint32_t imu_ring_available(const imu_ring_reader_t *reader)
+{
+    return __atomic_load_n(&reader->ring->head, __ATOMIC_ACQUIRE) - reader->cursor;
+}
+
+size_t imu_ring_read(imu_ring_reader_t *reader, mpu6050_sample_t *out, size_t max_count)
+{
+    const imu_ring_t *ring = reader->ring;
+    const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    // 序号 head 的槽位可能正被写入（与 head - CAPACITY 同槽），因此最多保留 CAPACITY - 1 帧
+    if (head - reader->cursor >= IMU_RING_CAPACITY)
+    {
+        const uint32_t skip = head - reader->cursor - (IMU_RING_CAPACITY - 1);
+        reader->overruns += skip;
+        reader->cursor += skip;
+    }
+
+    uint32_t n = head - reader->cursor;
+    if (n > max_count)
+    {
+        n = (uint32_t)max_count;
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out[i] = ring->samples[(reader->cursor + i) & IMU_RING_MASK];
+    }
+
+    // 拷贝期间生产者可能已绕回覆盖了开头几帧，丢弃这些可能被撕裂的帧
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    const uint32_t head_after = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t lost = 0;
+    if (head_after - reader->cursor >= IMU_RING_CAPACITY)
+    {
+        lost = head_after - reader->cursor - (IMU_RING_CAPACITY - 1);
+        if (lost > n)
+        {
+            lost = n;
+        }
+        memmove(out, &out[lost], (n - lost) * sizeof(*out));
+        reader->overruns += lost;
+    }
+
+    reader->cursor += n;
+    return n - lost;
+}
@@ -0,0 +1,40 @@
+#include <string.h>
+#include "imu_snapshot.h"
+
+void imu_snapshot_publish(imu_snapshot_channel_t *channel, const imu_snapshot_t *snapshot)
+{
+    // 临界区很短（一次几十字节的拷贝），保证写入期间不被本核任务抢占，
+    // 另一个核上的读者最多自旋这一小段时间
+    portENTER_CRITICAL(&channel->writer_lock);
+    const uint32_t seq = channel->seq;
+    __atomic_store_n(&channel->seq, seq + 1, __ATOMIC_RELAXED); // 奇数：写入中
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&channel->data, snapshot, sizeof(channel->data));
+    __atomic_store_n(&channel->seq, seq + 2, __ATOMIC_RELEASE); // 偶数：稳定
+    portEXIT_CRITICAL(&channel->writer_lock);
+}
+
+bool imu_snapshot_read(const imu_snapshot_channel_t *channel, imu_snapshot_t *out)
+{
+    uint32_t begin, end;
+
+    do
+    {
+        begin = __atomic_load_n(&channel->seq, __ATOMIC_ACQUIRE);
+        if (begin == 0)
+        {
+            return false;
+        }
+        if (begin & 1u)
+        {
+            continue; // 写者正在写入，重试
+        }
+        memcpy(out, &channel->data, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        end = __atomic_load_n(&channel->seq, __ATOMIC_RELAXED);
+        if (begin == end)
+        {
+            return true;
+        }
+    } while (1);
+}
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @brief 单生产者/多消费者的 IMU 采样环形缓冲区（静态分配、无锁）
+ *
+ * 采集任务是唯一的生产者，每个消费者持有独立的读游标，可一次批量读取多帧；
+ * 消费者落后超过容量时丢弃最旧的数据并累计到 overruns，生产者从不等待消费者。
+ * 慢速消费者（如 20Hz 的 OLED）与快速消费者（如 1kHz 的控制）共享同一路采集数据，不增加总线访问。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "mpu6050.h"
+
+#ifndef IMU_RING_CAPACITY
+#define IMU_RING_CAPACITY 128 /*!< 缓冲区帧数，必须是2的幂；1kHz 下约可缓存 128ms */
+#endif
+
+    _Static_assert((IMU_RING_CAPACITY & (IMU_RING_CAPACITY - 1)) == 0, "IMU_RING_CAPACITY must be a power of two");
+
+    /**
+     * @brief 环形缓冲区，静态分配并用 IMU_RING_INIT 初始化
+     */
+    typedef struct
+    {
+        uint32_t head; /*!< 已写入的总帧数（单调递增，自然回绕） */
+        mpu6050_sample_t samples[IMU_RING_CAPACITY];
+    } imu_ring_t;
+
+#define IMU_RING_INIT \
+    {                 \
+        .head = 0,    \
+    }
+
+    /**
+     * @brief 消费者读游标，每个消费者一个，由消费者自己的任务使用
+     */
+    typedef struct
+    {
+        const imu_ring_t *ring;
+        uint32_t cursor;   /*!< 下一帧要读取的序号 */
+        uint32_t overruns; /*!< 因落后而丢失的帧数（累计） */
+    } imu_ring_reader_t;
+
+    /**
+     * @brief 写入一帧（只允许一个生产者任务调用）
+     *
+     * @param ring ring buffer
+     * @param sample sample to append
+     */
+    void imu_ring_push(imu_ring_t *ring, const mpu6050_sample_t *sample);
+
+    /**
+     * @brief 批量写入多帧，例如一次 FIFO 读取的结果（只允许一个生产者任务调用）
+     *
+     * 每写一帧发布一次，与逐帧调用 imu_ring_push() 等价，读者不会读到正被覆盖的帧。
+     * count 不受容量限制：超过 IMU_RING_CAPACITY 时较早的帧被本批后面的帧覆盖，
+     * 未及时读取的读者将其计入 overruns。
+     *
+     * @param ring ring buffer
+     * @param samples samples to append, oldest first
+     * @param count number of samples
+     */
+    void imu_ring_push_batch(imu_ring_t *ring, const mpu6050_sample_t *samples, size_t count);
+
+    /**
+     * @brief 初始化读游标，从当前写入位置开始（只读取之后写入的帧）
+     *
+     * @param reader reader cursor
+     * @param ring ring buffer
+     */
+    void imu_ring_reader_init(imu_ring_reader_t *reader, const imu_ring_t *ring);
+
+    /**
+     * @brief 当前可读帧数（可能大于实际能读到的数量，超过容量的部分会计入 overruns）
+     *
+     * @param reader reader cursor
+     * @return number of unread samples
+     */
+    uint32_t imu_ring_available(const imu_ring_reader_t *reader);
+
+    /**
+     * @brief 批量读取最多 max_count 帧，按时间顺序（最旧在前）
+     *
+     * @param reader reader cursor
+     * @param out destination buffer
+     * @param max_count capacity of out
+     * @return number of samples copied to out
+     */
+    size_t imu_ring_read(imu_ring_reader_t *reader, mpu6050_sample_t *out, size_t max_count);
+
+#ifdef __cplusplus
+}
+#endif
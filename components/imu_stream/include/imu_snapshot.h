@@ -0,0 +1,69 @@
+/**
+ * @file
+ * @brief 单写者/多读者的 IMU 状态快照（seqlock），读者无锁、不阻塞写者
+ *
+ * 采样任务每帧调用 imu_snapshot_publish() 发布最新状态；任意数量的读者任务（可在另一个核上）
+ * 调用 imu_snapshot_read() 得到一致的副本，不会读到 roll/pitch 来自不同帧的“撕裂”数据。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "mpu6050.h"
+
+    typedef struct
+    {
+        int64_t timestamp_us;        /*!< 对应采样的采集时刻 */
+        mpu6050_acce_value_t acce;   /*!< 加速度（g） */
+        mpu6050_gyro_value_t gyro;   /*!< 角速度（°/s） */
+        mpu6050_temp_value_t temp;   /*!< 温度（°C） */
+        complimentary_angle_t angle; /*!< 姿态角（度） */
+    } imu_snapshot_t;
+
+    /**
+     * @brief 快照通道，静态分配并用 IMU_SNAPSHOT_CHANNEL_INIT 初始化
+     *
+     * seq 为偶数表示数据稳定，奇数表示写者正在写入；0 表示尚未发布过。
+     */
+    typedef struct
+    {
+        uint32_t seq;
+        portMUX_TYPE writer_lock; /*!< 仅写者使用，保证写入期间不被本核抢占 */
+        imu_snapshot_t data;
+    } imu_snapshot_channel_t;
+
+#define IMU_SNAPSHOT_CHANNEL_INIT                   \
+    {                                               \
+        .seq = 0,                                   \
+        .writer_lock = portMUX_INITIALIZER_UNLOCKED, \
+    }
+
+    /**
+     * @brief 发布一份新快照（只允许一个写者任务调用）
+     *
+     * @param channel snapshot channel
+     * @param snapshot state to publish
+     */
+    void imu_snapshot_publish(imu_snapshot_channel_t *channel, const imu_snapshot_t *snapshot);
+
+    /**
+     * @brief 读取最新快照的一致副本，无锁，可被任意任务并发调用
+     *
+     * @param channel snapshot channel
+     * @param out copy of the latest published snapshot
+     * @return
+     *     - true  out holds a consistent snapshot
+     *     - false nothing has been published yet
+     */
+    bool imu_snapshot_read(const imu_snapshot_channel_t *channel, imu_snapshot_t *out);
+
+#ifdef __cplusplus
+}
+#endif
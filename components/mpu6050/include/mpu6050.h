@@ -37,6 +37,43 @@ extern "C"
         GYRO_FS_2000DPS = 3,
     } mpu6050_gyro_fs_t;
 
+    // 数字低通滤波器（CONFIG.DLPF_CFG），带宽越低噪声越小、延迟越大
+    // DLPF 关闭（260Hz）时陀螺仪内部输出率为 8kHz，其余档位为 1kHz
+    typedef enum
+    {
+        MPU6050_DLPF_260HZ = 0, /*!< Accel 260Hz / Gyro 256Hz, delay ~0ms   */
+        MPU6050_DLPF_184HZ = 1, /*!< Accel 184Hz / Gyro 188Hz, delay ~2ms   */
+        MPU6050_DLPF_94HZ = 2,  /*!< Accel 94Hz / Gyro 98Hz, delay ~3ms     */
+        MPU6050_DLPF_44HZ = 3,  /*!< Accel 44Hz / Gyro 42Hz, delay ~5ms     */
+        MPU6050_DLPF_21HZ = 4,  /*!< Accel 21Hz / Gyro 20Hz, delay ~8.5ms   */
+        MPU6050_DLPF_10HZ = 5,  /*!< Accel 10Hz / Gyro 10Hz, delay ~13.8ms  */
+        MPU6050_DLPF_5HZ = 6,   /*!< Accel 5Hz / Gyro 5Hz, delay ~19ms      */
+    } mpu6050_dlpf_t;
+
+    // 输出数据率配置
+    typedef struct
+    {
+        mpu6050_dlpf_t dlpf; /*!< 低通滤波档位 */
+        uint16_t odr_hz;     /*!< 目标输出数据率（Hz），驱动据此计算 SMPLRT_DIV */
+    } mpu6050_rate_config_t;
+
+    // 低功耗循环模式下加速度计的唤醒频率（PWR_MGMT_2.LP_WAKE_CTRL）
+    typedef enum
+    {
+        MPU6050_LP_WAKE_1_25HZ = 0, /*!< 1.25Hz */
+        MPU6050_LP_WAKE_5HZ = 1,    /*!< 5Hz    */
+        MPU6050_LP_WAKE_20HZ = 2,   /*!< 20Hz   */
+        MPU6050_LP_WAKE_40HZ = 3,   /*!< 40Hz   */
+    } mpu6050_lp_wake_t;
+
+    // 静止待机（idle）配置：仅加速度计循环采样，运动检测中断唤醒
+    typedef struct
+    {
+        uint8_t motion_threshold;    /*!< MOT_THR，1 LSB = 2mg（高通滤波后的加速度） */
+        uint8_t motion_duration;     /*!< MOT_DUR，超过阈值需持续的采样数（1 LSB = 1ms） */
+        mpu6050_lp_wake_t wake_freq; /*!< 循环模式唤醒频率 */
+    } mpu6050_idle_config_t;
+
     // 中断配置定义
     // 定义了中断引脚的工作模式、活动电平、锁存行为和清除方式
     typedef enum
@@ -78,6 +115,14 @@ extern "C"
     extern const uint8_t MPU6050_FIFO_OVERFLOW_INT_BIT; /*!< FIFO Overflow interrupt bit            */
     extern const uint8_t MPU6050_MOT_DETECT_INT_BIT;    /*!< MOTION DETECTION interrupt bit         */
     extern const uint8_t MPU6050_ALL_INTERRUPTS;        /*!< All interrupts supported by mpu6050    */
+    // FIFO 通道位定义（FIFO_EN 寄存器），帧内数据按寄存器地址顺序排列：ACCEL、TEMP、GYRO_X/Y/Z
+    extern const uint8_t MPU6050_FIFO_ACCE_BIT;   /*!< Accelerometer X/Y/Z into FIFO (6 bytes) */
+    extern const uint8_t MPU6050_FIFO_TEMP_BIT;   /*!< Temperature into FIFO (2 bytes)         */
+    extern const uint8_t MPU6050_FIFO_GYRO_X_BIT; /*!< Gyroscope X into FIFO (2 bytes)         */
+    extern const uint8_t MPU6050_FIFO_GYRO_Y_BIT; /*!< Gyroscope Y into FIFO (2 bytes)         */
+    extern const uint8_t MPU6050_FIFO_GYRO_Z_BIT; /*!< Gyroscope Z into FIFO (2 bytes)         */
+    extern const uint8_t MPU6050_FIFO_GYRO_BITS;  /*!< Gyroscope X/Y/Z into FIFO               */
+    extern const uint8_t MPU6050_FIFO_ALL_BITS;   /*!< Every channel, 14-byte frames           */
 
     typedef struct
     {
@@ -93,6 +138,16 @@ extern "C"
         int16_t raw_gyro_z;
     } mpu6050_raw_gyro_value_t;
 
+    /**
+     * @brief 一次突发读取得到的原始数据，字段顺序与寄存器 0x3B~0x48 一致
+     */
+    typedef struct
+    {
+        mpu6050_raw_acce_value_t raw_acce;
+        int16_t raw_temp;
+        mpu6050_raw_gyro_value_t raw_gyro;
+    } mpu6050_raw_motion_value_t;
+
     typedef struct
     {
         float acce_x;
@@ -118,6 +173,18 @@ extern "C"
         float pitch;
     } complimentary_angle_t;
 
+    /**
+     * @brief 带采集时间戳的一帧完整采样（原始值与换算值）
+     */
+    typedef struct
+    {
+        int64_t timestamp_us;           /*!< 采样时刻，esp_timer_get_time() 单调时间（微秒） */
+        mpu6050_raw_motion_value_t raw; /*!< 原始寄存器值 */
+        mpu6050_acce_value_t acce;      /*!< 加速度（g） */
+        mpu6050_gyro_value_t gyro;      /*!< 角速度（°/s） */
+        mpu6050_temp_value_t temp;      /*!< 温度（°C） */
+    } mpu6050_sample_t;
+
     typedef void *mpu6050_handle_t;
 
     typedef gpio_isr_t mpu6050_isr_t;
@@ -135,7 +202,11 @@ extern "C"
     // 创建和删除传感器对象
     /**
      * @brief 创建并初始化MPU6050传感器对象，返回传感器句柄。
-     * @param port I2C端口号
+     *
+     * bus_handle 为 NULL 时创建离线句柄：不访问总线，配置类函数只更新缓存，
+     * 读数据类函数返回 ESP_ERR_INVALID_STATE。用于回放记录数据时复用换算与滤波函数。
+     *
+     * @param bus_handle I2C 总线句柄，NULL 表示离线
      * @param dev_addr 设备地址（通常为0x68或0x69）
      * @return
      *     - NULL Fail
@@ -174,6 +245,37 @@ extern "C"
      *     - ESP_FAIL Fail
      */
     esp_err_t mpu6050_sleep(mpu6050_handle_t sensor);
+
+    /**
+     * @brief 进入静止待机（idle）模式
+     *
+     * 关闭陀螺仪与温度传感器，加速度计按 wake_freq 循环采样；原有中断源被暂存并替换为
+     * 运动检测中断，主机不再需要轮询总线。运动检测依赖 INT 引脚，需先调用
+     * mpu6050_config_interrupts()。中途失败时自动恢复到进入前的状态。
+     *
+     * @param sensor object handle of mpu6050
+     * @param idle_config motion threshold/duration and wake frequency
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL or out of range
+     *     - ESP_ERR_INVALID_STATE Already idle
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_enter_idle(mpu6050_handle_t sensor, const mpu6050_idle_config_t *const idle_config);
+
+    /**
+     * @brief 退出 idle 模式，恢复全速采样
+     *
+     * 恢复陀螺仪、温度传感器与进入 idle 前的中断源。陀螺仪约需 30ms 稳定。
+     * 由于 idle 期间没有采样，互补滤波会在下一次调用时由加速度计重新初始化角度。
+     * 未处于 idle 时直接返回 ESP_OK。
+     *
+     * @param sensor object handle of mpu6050
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_exit_idle(mpu6050_handle_t sensor);
     // 传感器配置
     /**
      * @brief 配置加速度计和陀螺仪的量程（如±2g、±4g、±8g、±16g和±250°/s、±500°/s等）
@@ -186,7 +288,65 @@ extern "C"
      */
     esp_err_t mpu6050_config(mpu6050_handle_t sensor, const mpu6050_acce_fs_t acce_fs, const mpu6050_gyro_fs_t gyro_fs);
     /**
-     * @brief 获取加速度计的灵敏度（用于将原始数据转换为物理单位）。
+     * @brief 配置数字低通滤波器和输出数据率（SMPLRT_DIV、CONFIG 一次突发写入）
+     *
+     * 采样率 = 陀螺仪输出率 / (1 + SMPLRT_DIV)，陀螺仪输出率在 DLPF 关闭时为 8kHz，否则为 1kHz。
+     * 分频系数取最接近 odr_hz 的整数并限制在 0~255，实际速率通过 effective_odr_hz 返回。
+     * 加速度计输出率最高 1kHz，超过时加速度数据会重复。
+     *
+     * @param sensor object handle of mpu6050
+     * @param rate_config DLPF mode and target output data rate
+     * @param effective_odr_hz resulting output data rate (Hz), may be NULL
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL or out of range
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_config_rate(mpu6050_handle_t sensor, const mpu6050_rate_config_t *const rate_config,
+                                  float *const effective_odr_hz);
+    /**
+     * @brief 从寄存器重新同步量程缓存。
+     *
+     * 驱动在 mpu6050_config() 成功后缓存量程和比例因子，换算时不再访问总线。
+     * 仅当寄存器被驱动之外的途径修改（或器件未复位、沿用旧配置）时才需要调用。
+     *
+     * @param sensor object handle of mpu6050
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_sync_sensitivity(mpu6050_handle_t sensor);
+
+    /**
+     * @brief 从器件重新载入配置寄存器影子副本。
+     *
+     * 驱动在 mpu6050_create() 时载入一次影子副本，此后每次写寄存器同步更新，
+     * 唤醒、休眠、中断开关等位操作只需一次写事务。器件可能被复位（掉电、
+     * DEVICE_RESET、外部主机改写）后调用本函数，量程、DLPF 与采样周期缓存一并刷新。
+     *
+     * @param sensor object handle of mpu6050
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG sensor is NULL
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_refresh_shadow(mpu6050_handle_t sensor);
+
+    /**
+     * @brief 开启或关闭影子副本校验模式。
+     *
+     * 开启后每次位操作都先从器件读回寄存器当前值（同时刷新影子），
+     * 适合器件状态不可信的调试或恢复阶段；默认关闭。
+     *
+     * @param sensor object handle of mpu6050
+     * @param enable true 开启校验模式
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG sensor is NULL
+     */
+    esp_err_t mpu6050_set_shadow_verify(mpu6050_handle_t sensor, bool enable);
+    /**
+     * @brief 获取加速度计的灵敏度（用于将原始数据转换为物理单位），返回缓存值，不访问总线。
      * @param sensor object handle of mpu6050
      * @param acce_sensitivity accelerometer sensitivity
      * @return
@@ -195,7 +355,7 @@ extern "C"
      */
     esp_err_t mpu6050_get_acce_sensitivity(mpu6050_handle_t sensor, float *const acce_sensitivity);
     /**
-     * @brief 获取陀螺仪的灵敏度
+     * @brief 获取陀螺仪的灵敏度，返回缓存值，不访问总线。
      * @param sensor object handle of mpu6050
      * @param gyro_sensitivity gyroscope sensitivity
      * @return
@@ -204,6 +364,18 @@ extern "C"
      */
     esp_err_t mpu6050_get_gyro_sensitivity(mpu6050_handle_t sensor, float *const gyro_sensitivity);
 
+    /**
+     * @brief 获取当前量程，返回缓存值，不访问总线。
+     * @param sensor object handle of mpu6050
+     * @param acce_fs accelerometer full scale, may be NULL
+     * @param gyro_fs gyroscope full scale, may be NULL
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG sensor is NULL
+     */
+    esp_err_t mpu6050_get_full_scale(mpu6050_handle_t sensor, mpu6050_acce_fs_t *const acce_fs,
+                                     mpu6050_gyro_fs_t *const gyro_fs);
+
     //
     //
     //
@@ -230,6 +402,8 @@ extern "C"
     /**
      * @brief 注册中断服务例程（ISR）处理MPU6050中断。.
      *
+     * 失败时已添加的 GPIO handler 会被移除，调用方无需清理。
+     *
      * @param sensor object handle of mpu6050
      * @param isr function to handle interrupts produced by mpu6050
      *
@@ -398,6 +572,144 @@ extern "C"
      */
     esp_err_t mpu6050_get_temp(mpu6050_handle_t sensor, mpu6050_temp_value_t *const temp_value);
 
+    /**
+     * @brief 单次 I2C 事务突发读取 ACCEL_XOUT_H..GYRO_ZOUT_L（0x3B~0x48，共14字节）
+     *
+     * @param sensor object handle of mpu6050
+     * @param raw_motion raw accelerometer, temperature and gyroscope measurements
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_get_raw_motion(mpu6050_handle_t sensor, mpu6050_raw_motion_value_t *const raw_motion);
+
+    /**
+     * @brief 用缓存的量程将原始数据换算为物理单位，不访问总线
+     *
+     * @param sensor object handle of mpu6050
+     * @param raw_motion raw measurements, e.g. from mpu6050_get_raw_motion()
+     * @param acce_value accelerometer measurements
+     * @param gyro_value gyroscope measurements
+     * @param temp_value temperature measurements
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t mpu6050_convert_motion(mpu6050_handle_t sensor, const mpu6050_raw_motion_value_t *const raw_motion,
+                                     mpu6050_acce_value_t *const acce_value, mpu6050_gyro_value_t *const gyro_value,
+                                     mpu6050_temp_value_t *const temp_value);
+
+    /**
+     * @brief 突发读取并换算加速度、陀螺仪和温度，替代依次调用 get_acce/get_gyro/get_temp
+     *
+     * @param sensor object handle of mpu6050
+     * @param acce_value accelerometer measurements
+     * @param gyro_value gyroscope measurements
+     * @param temp_value temperature measurements
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_get_motion(mpu6050_handle_t sensor, mpu6050_acce_value_t *const acce_value,
+                                 mpu6050_gyro_value_t *const gyro_value, mpu6050_temp_value_t *const temp_value);
+
+    /**
+     * @brief 突发读取一帧并打上 esp_timer 单调时间戳
+     *
+     * @param sensor object handle of mpu6050
+     * @param sample timestamped raw and scaled measurements
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_get_sample(mpu6050_handle_t sensor, mpu6050_sample_t *const sample);
+
+    /**
+     * @brief 获取当前输出数据周期（由 mpu6050_config_rate() 设定，上电默认 125us）
+     *
+     * @param sensor object handle of mpu6050
+     * @param period_us sample period in microseconds
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t mpu6050_get_sample_period(mpu6050_handle_t sensor, uint32_t *const period_us);
+
+    // FIFO 流式采集
+    /**
+     * @brief 开启硬件 FIFO：清空 FIFO，写入 FIFO_EN 选择通道，再置位 USER_CTRL.FIFO_EN
+     *
+     * 采样率由 SMPLRT_DIV 决定，传感器按该速率把选中通道的数据压入 1024 字节 FIFO，
+     * 主机只需周期性调用 mpu6050_fifo_read_frames() 批量取出。
+     *
+     * @param sensor object handle of mpu6050
+     * @param channels bit mask of MPU6050_FIFO_*_BIT
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG No channel selected or unknown channel bits
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_fifo_start(mpu6050_handle_t sensor, uint8_t channels);
+    /**
+     * @brief 关闭硬件 FIFO 并清空其中数据
+     *
+     * @param sensor object handle of mpu6050
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_fifo_stop(mpu6050_handle_t sensor);
+    /**
+     * @brief 清空 FIFO（丢弃未读数据并恢复帧对齐），保持当前通道配置继续采集
+     *
+     * @param sensor object handle of mpu6050
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_fifo_reset(mpu6050_handle_t sensor);
+    /**
+     * @brief 读取 FIFO_COUNT（FIFO 中的字节数）
+     *
+     * @param sensor object handle of mpu6050
+     * @param count number of bytes stored in FIFO
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_fifo_get_count(mpu6050_handle_t sensor, uint16_t *const count);
+    /**
+     * @brief 一次突发读取 FIFO 中最多 max_frames 个完整帧
+     *
+     * 帧按 FIFO 顺序（最旧在前）解析到 frames，未启用的通道填0。解析在 frames 内原地完成，
+     * 无需额外缓冲区。FIFO 溢出（或字节数不再是帧长整数倍）时自动清空 FIFO 并返回
+     * ESP_ERR_INVALID_STATE，调用方丢弃本批数据后继续读取即可。
+     * 第 i 帧的采集时刻为 timestamp_us - (out_frames - 1 - i) * 采样周期（见 mpu6050_get_sample_period()）。
+     *
+     * @param sensor object handle of mpu6050
+     * @param frames caller-provided buffer of at least max_frames entries
+     * @param max_frames capacity of frames
+     * @param out_frames number of frames written to frames
+     * @param timestamp_us monotonic capture time of the last returned frame, may be NULL
+     *
+     * @return
+     *     - ESP_OK Success (out_frames may be 0)
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_ERR_INVALID_STATE FIFO not started, or overflow detected and FIFO was reset
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_fifo_read_frames(mpu6050_handle_t sensor, mpu6050_raw_motion_value_t *const frames,
+                                       size_t max_frames, size_t *const out_frames, int64_t *const timestamp_us);
+
     //
     //
     //
@@ -413,17 +725,45 @@ extern "C"
     /**
      * @brief Use complimentory filter to calculate roll and pitch
      *
+     * 积分步长 dt 由相邻两次采样的时间戳计算，与调用时刻无关。每帧采样只应滤波一次，
+     * 时间戳未前进的调用会被拒绝。
+     *
+     * 启用 CONFIG_MPU6050_FIXED_POINT_FILTER 时滤波状态以 Q16 保存在句柄内，
+     * complimentary_angle 只作输出；浮点版本则以它作为上一次的角度。
+     * 有原始数据时优先用 mpu6050_complimentory_filter_raw()，省去换算。
+     *
      * @param sensor object handle of mpu6050
      * @param acce_value accelerometer measurements
      * @param gyro_value gyroscope measurements
+     * @param timestamp_us monotonic capture time of the sample (mpu6050_sample_t::timestamp_us)
      * @param complimentary_angle complimentary angle
      *
      * @return
      *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG timestamp_us is not later than the previous sample
      *     - ESP_FAIL Fail
      */
     esp_err_t mpu6050_complimentory_filter(mpu6050_handle_t sensor, const mpu6050_acce_value_t *const acce_value,
-                                           const mpu6050_gyro_value_t *const gyro_value, complimentary_angle_t *const complimentary_angle);
+                                           const mpu6050_gyro_value_t *const gyro_value, int64_t timestamp_us,
+                                           complimentary_angle_t *const complimentary_angle);
+    /**
+     * @brief 以原始采样（如 FIFO 帧）运行互补滤波，零偏与量程按句柄当前设置处理
+     *
+     * 定点版本中加速度直接以 LSB 参与 atan2，角速度用缓存的 Q32 比例因子换算，
+     * 整个更新不含浮点运算（输出角度除外）；浮点版本等价于 mpu6050_convert_motion()
+     * 后调用 mpu6050_complimentory_filter()。
+     *
+     * @param sensor object handle of mpu6050
+     * @param raw_motion raw measurements (temperature is ignored)
+     * @param timestamp_us monotonic capture time of the sample
+     * @param complimentary_angle complimentary angle
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG timestamp_us is not later than the previous sample
+     */
+    esp_err_t mpu6050_complimentory_filter_raw(mpu6050_handle_t sensor, const mpu6050_raw_motion_value_t *const raw_motion,
+                                               int64_t timestamp_us, complimentary_angle_t *const complimentary_angle);
 
 #ifdef __cplusplus
 }
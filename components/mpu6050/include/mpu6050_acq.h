@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief MPU6050 数据就绪（DATA_RDY）中断驱动的采集任务
+ *
+ * INT 引脚的 DATA_RDY 中断在 ISR 中记录 esp_timer 时间戳并通过任务通知唤醒专用高优先级任务，
+ * 任务对每个采样只做一次 14 字节突发读取，再通过回调交给上层。采样节拍由传感器的
+ * SMPLRT_DIV 决定，不受 vTaskDelay 的 tick 粒度和调度负载影响。
+ *
+ * 启用 idle 后，角速度持续低于阈值一段时间即让传感器进入加速度计循环采样模式，
+ * 任务停止访问总线；运动检测中断把任务唤醒并恢复全速采样。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "mpu6050.h"
+
+    /**
+     * @brief 采样回调，在采集任务上下文中执行，应尽快返回
+     *
+     * @param sample 本次采样，仅在回调期间有效
+     * @param user_ctx mpu6050_acq_config_t::user_ctx
+     */
+    typedef void (*mpu6050_acq_cb_t)(const mpu6050_sample_t *sample, void *user_ctx);
+
+    /**
+     * @brief idle 状态变化回调，在采集任务上下文中执行
+     *
+     * @param idle true 进入 idle，false 被运动唤醒
+     * @param user_ctx mpu6050_acq_config_t::user_ctx
+     */
+    typedef void (*mpu6050_acq_idle_cb_t)(bool idle, void *user_ctx);
+
+    typedef struct
+    {
+        mpu6050_int_config_t int_config; /*!< INT 引脚配置，推荐 50us 脉冲 + 任意读清除 */
+        UBaseType_t task_priority;       /*!< 采集任务优先级，应高于显示等任务 */
+        uint32_t task_stack_size;        /*!< 采集任务栈大小（字节），0 使用默认值 */
+        BaseType_t core_id;              /*!< 采集任务绑定的核，tskNO_AFFINITY 表示不绑定 */
+        mpu6050_acq_cb_t on_sample;      /*!< 每个采样调用一次 */
+        void *user_ctx;                  /*!< 透传给 on_sample / on_idle */
+        uint32_t idle_after_ms;          /*!< 连续静止多久后进入 idle，0 表示不启用 */
+        float idle_gyro_dps;             /*!< 三轴角速度绝对值均低于该值（°/s）视为静止 */
+        mpu6050_idle_config_t idle;      /*!< 进入 idle 时的运动检测配置 */
+        mpu6050_acq_idle_cb_t on_idle;   /*!< idle 状态变化时调用，可为 NULL */
+    } mpu6050_acq_config_t;
+
+    typedef struct
+    {
+        uint32_t samples;     /*!< 成功读取的采样数 */
+        uint32_t missed;      /*!< 任务来不及处理而合并掉的中断数 */
+        uint32_t read_errors; /*!< 突发读取失败次数 */
+        uint32_t idle_entries; /*!< 进入 idle 的次数 */
+        uint32_t wakeups;      /*!< 被运动检测中断唤醒的次数 */
+    } mpu6050_acq_stats_t;
+
+    typedef struct mpu6050_acq_t *mpu6050_acq_handle_t;
+
+    /**
+     * @brief 配置 INT 引脚、注册 ISR、使能 DATA_RDY 中断并启动采集任务
+     *
+     * 每个传感器同一时间只能有一个采集实例。若 GPIO ISR 服务尚未安装，会自动安装。
+     *
+     * @param sensor object handle of mpu6050
+     * @param config acquisition configuration
+     * @param out returned acquisition handle
+     *
+     * @return
+     *      - ESP_OK Success
+     *      - ESP_ERR_INVALID_ARG A parameter is NULL or not valid
+     *      - ESP_ERR_INVALID_STATE Acquisition already running on this sensor
+     *      - ESP_ERR_NO_MEM Out of memory
+     *      - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_acq_start(mpu6050_handle_t sensor, const mpu6050_acq_config_t *const config,
+                                mpu6050_acq_handle_t *const out);
+
+    /**
+     * @brief 关闭 DATA_RDY 中断，等待采集任务退出并释放资源
+     *
+     * 若传感器处于 idle，先恢复全速模式。
+     *
+     * @param acq acquisition handle
+     * @return
+     *      - ESP_OK Success
+     *      - ESP_ERR_INVALID_ARG acq is NULL
+     */
+    esp_err_t mpu6050_acq_stop(mpu6050_acq_handle_t acq);
+
+    /**
+     * @brief 获取采集统计
+     *
+     * @param acq acquisition handle
+     * @param stats statistics snapshot
+     * @return
+     *      - ESP_OK Success
+     *      - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t mpu6050_acq_get_stats(mpu6050_acq_handle_t acq, mpu6050_acq_stats_t *const stats);
+
+#ifdef __cplusplus
+}
+#endif
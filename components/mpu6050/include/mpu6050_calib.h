@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief MPU6050 零偏标定与标定结果的持久化
+ *
+ * 静止状态下对 N 个突发读取的采样求平均得到陀螺仪与加速度计零偏。零偏可写入传感器的
+ * 硬件偏置寄存器，也可以由驱动在换算时扣除（预先换算成物理单位，每个采样只多一次减法）。
+ * 标定结果通过可替换的存储接口保存，默认实现基于 NVS，主机测试时可换成内存实现。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "mpu6050.h"
+
+    // 标定时朝上（感受 +1g）的轴
+    typedef enum
+    {
+        MPU6050_CALIB_GRAVITY_Z_POS = 0, /*!< 水平放置，Z 轴朝上（默认） */
+        MPU6050_CALIB_GRAVITY_Z_NEG,     /*!< Z 轴朝下 */
+        MPU6050_CALIB_GRAVITY_X_POS,     /*!< X 轴朝上 */
+        MPU6050_CALIB_GRAVITY_X_NEG,     /*!< X 轴朝下 */
+        MPU6050_CALIB_GRAVITY_Y_POS,     /*!< Y 轴朝上 */
+        MPU6050_CALIB_GRAVITY_Y_NEG,     /*!< Y 轴朝下 */
+    } mpu6050_calib_gravity_t;
+
+    typedef struct
+    {
+        uint16_t samples;                /*!< 参与平均的采样数，0 使用默认值 256 */
+        mpu6050_calib_gravity_t gravity; /*!< 标定姿态 */
+        float max_gyro_spread_dps;       /*!< 任一轴角速度峰峰值超过该值视为被移动，0 表示不检查 */
+        bool write_hw_offsets;           /*!< true 写入硬件偏置寄存器，否则由驱动在换算时扣除 */
+    } mpu6050_calib_config_t;
+
+    /**
+     * @brief 标定结果
+     *
+     * 零偏以物理单位保存，与量程无关；hw_offsets 为 true 时同时保存写入偏置寄存器的绝对值
+     * （加速度计为出厂微调值减去零偏），重复写入结果相同。
+     */
+    typedef struct
+    {
+        float acce_bias[3];           /*!< 加速度计零偏（g），X/Y/Z */
+        float gyro_bias[3];           /*!< 陀螺仪零偏（°/s），X/Y/Z */
+        bool hw_offsets;              /*!< 零偏已写入硬件偏置寄存器，换算时不再扣除 */
+        int16_t acce_offset_regs[3];  /*!< XA/YA/ZA_OFFS 寄存器值（±16g 量程，bit0 保留） */
+        int16_t gyro_offset_regs[3];  /*!< XG/YG/ZG_OFFS 寄存器值（±1000°/s 量程） */
+        int16_t acce_factory_trim[3]; /*!< 加速度计偏置寄存器出厂值，热复位后据此恢复 */
+    } mpu6050_calib_t;
+
+    /**
+     * @brief 标定结果存储接口，load/save 返回 ESP_ERR_NOT_FOUND 表示尚无数据
+     */
+    typedef struct
+    {
+        esp_err_t (*load)(void *ctx, const char *key, void *buf, size_t len);
+        esp_err_t (*save)(void *ctx, const char *key, const void *buf, size_t len);
+        void *ctx;
+    } mpu6050_calib_store_t;
+
+    /**
+     * @brief 静止标定
+     *
+     * 先清除已生效的零偏（软件与硬件），再以传感器当前采样周期连续突发读取 samples 个采样。
+     * 标定期间传感器必须保持静止，且应在采集任务启动前调用。成功后结果立即生效。
+     *
+     * @param sensor object handle of mpu6050
+     * @param config calibration options, NULL uses defaults
+     * @param out calibration result, may be NULL
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG sensor is NULL or config out of range
+     *     - ESP_ERR_INVALID_STATE Sensor moved during calibration
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_calibrate(mpu6050_handle_t sensor, const mpu6050_calib_config_t *const config,
+                                mpu6050_calib_t *const out);
+
+    /**
+     * @brief 应用标定结果（通常来自 mpu6050_calib_load()），NULL 清除零偏
+     *
+     * 软件零偏或 NULL 时总是清除硬件偏置：陀螺仪偏置寄存器清零，加速度计偏置寄存器恢复出厂值。
+     * 出厂值取自本次上电首次读取或应用过的硬件标定结果；MCU 热复位后若未先应用硬件标定结果，
+     * 只能以当前寄存器值为准，此时加速度计偏置需要传感器重新上电才能回到出厂值。
+     *
+     * @param sensor object handle of mpu6050
+     * @param calib calibration result
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG sensor is NULL
+     *     - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_set_calibration(mpu6050_handle_t sensor, const mpu6050_calib_t *const calib);
+
+    /**
+     * @brief 读取换算时扣除的软件零偏
+     *
+     * 硬件偏置已体现在原始数据中，不计入；未标定或零偏写入硬件时为 0。
+     * 记录原始数据时连同它一起保存，回放时用 mpu6050_set_calibration() 恢复即可得到相同的物理量。
+     *
+     * @param sensor object handle of mpu6050
+     * @param acce_bias accelerometer bias (g), X/Y/Z
+     * @param gyro_bias gyroscope bias (°/s), X/Y/Z
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t mpu6050_get_software_bias(mpu6050_handle_t sensor, float acce_bias[3], float gyro_bias[3]);
+
+    /**
+     * @brief 从存储读取标定结果
+     *
+     * @param store storage backend
+     * @param key storage key, 每个传感器使用不同的 key
+     * @param out calibration result
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_ERR_NOT_FOUND No calibration stored
+     *     - ESP_ERR_INVALID_VERSION Stored data has an unknown format
+     */
+    esp_err_t mpu6050_calib_load(const mpu6050_calib_store_t *store, const char *key, mpu6050_calib_t *const out);
+
+    /**
+     * @brief 保存标定结果
+     *
+     * @param store storage backend
+     * @param key storage key
+     * @param calib calibration result
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - Others Error from the storage backend
+     */
+    esp_err_t mpu6050_calib_save(const mpu6050_calib_store_t *store, const char *key,
+                                 const mpu6050_calib_t *const calib);
+
+    /**
+     * @brief 基于 NVS 的默认存储（命名空间 "mpu6050"），调用前需已执行 nvs_flash_init()；Linux 目标不提供
+     */
+    const mpu6050_calib_store_t *mpu6050_calib_nvs_store(void);
+
+#ifdef __cplusplus
+}
+#endif
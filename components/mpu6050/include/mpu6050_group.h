@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief 同一总线上多个 MPU6050 的统一采样调度
+ *
+ * 周期性 esp_timer 在每个时隙通知一个专用任务，任务把组内所有传感器背靠背各做一次
+ * 14 字节突发读取，组成一帧时间对齐的数据交给回调。每个传感器单独记录读取时刻，
+ * 组内时间差（skew）约为单次突发读取耗时乘以传感器个数。
+ *
+ * 各传感器的 ODR 应不低于组采样率，否则同一数据会被重复读取。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "mpu6050.h"
+
+#define MPU6050_GROUP_MAX_SENSORS 4 /*!< 一个组最多包含的传感器数（单总线仅 0x68/0x69 两个地址，留出多总线余量） */
+
+    typedef struct
+    {
+        uint32_t sequence;      /*!< 帧序号，从 0 开始递增 */
+        int64_t slot_us;        /*!< 本时隙开始读取的时刻 */
+        uint8_t count;          /*!< 组内传感器个数 */
+        uint8_t valid_mask;     /*!< 第 i 位为 1 表示 samples[i] 读取成功 */
+        mpu6050_sample_t samples[MPU6050_GROUP_MAX_SENSORS]; /*!< 与创建时传入的句柄顺序一致，时间戳取各自读取的中点 */
+    } mpu6050_group_frame_t;
+
+    /**
+     * @brief 帧回调，在组采样任务上下文中执行，应尽快返回
+     *
+     * @param frame 本时隙的数据，仅在回调期间有效
+     * @param user_ctx mpu6050_group_config_t::user_ctx
+     */
+    typedef void (*mpu6050_group_cb_t)(const mpu6050_group_frame_t *frame, void *user_ctx);
+
+    typedef struct
+    {
+        const mpu6050_handle_t *sensors; /*!< 传感器句柄数组，按此顺序读取 */
+        uint8_t sensor_count;            /*!< 传感器个数，1 ~ MPU6050_GROUP_MAX_SENSORS */
+        uint32_t period_us;              /*!< 时隙周期（微秒），0 使用第一个传感器的采样周期 */
+        UBaseType_t task_priority;       /*!< 组采样任务优先级，应高于显示等任务 */
+        uint32_t task_stack_size;        /*!< 任务栈大小（字节），0 使用默认值 */
+        BaseType_t core_id;              /*!< 任务绑定的核，tskNO_AFFINITY 表示不绑定 */
+        mpu6050_group_cb_t on_frame;     /*!< 每个时隙调用一次 */
+        void *user_ctx;                  /*!< 透传给 on_frame */
+    } mpu6050_group_config_t;
+
+    typedef struct
+    {
+        uint32_t frames;      /*!< 已产生的帧数 */
+        uint32_t missed;      /*!< 任务来不及处理而合并掉的时隙数 */
+        uint32_t read_errors; /*!< 单个传感器突发读取失败次数 */
+        uint32_t max_skew_us; /*!< 同一帧内首尾传感器时间戳之差的最大值 */
+    } mpu6050_group_stats_t;
+
+    typedef struct mpu6050_group_t *mpu6050_group_handle_t;
+
+    /**
+     * @brief 创建传感器组并开始周期采样
+     *
+     * 句柄数组被复制，调用后可释放；传感器本身的生命周期由调用者管理，且需长于组。
+     *
+     * @param config group configuration
+     * @param out returned group handle
+     *
+     * @return
+     *      - ESP_OK Success
+     *      - ESP_ERR_INVALID_ARG A parameter is NULL or not valid
+     *      - ESP_ERR_NO_MEM Out of memory
+     *      - ESP_FAIL Fail
+     */
+    esp_err_t mpu6050_group_start(const mpu6050_group_config_t *const config, mpu6050_group_handle_t *const out);
+
+    /**
+     * @brief 停止定时器，等待采样任务退出并释放资源
+     *
+     * @param group group handle
+     * @return
+     *      - ESP_OK Success
+     *      - ESP_ERR_INVALID_ARG group is NULL
+     */
+    esp_err_t mpu6050_group_stop(mpu6050_group_handle_t group);
+
+    /**
+     * @brief 获取组采样统计
+     *
+     * @param group group handle
+     * @param stats statistics snapshot
+     * @return
+     *      - ESP_OK Success
+     *      - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t mpu6050_group_get_stats(mpu6050_group_handle_t group, mpu6050_group_stats_t *const stats);
+
+#ifdef __cplusplus
+}
+#endif
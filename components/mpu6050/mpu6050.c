@@ -7,25 +7,37 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
-#include <time.h>
-#include <sys/time.h>
+#include "sdkconfig.h"
 #include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
 #include "driver/i2c_master.h"
+#include "i2c_bus_mgr.h"
 #include "mpu6050.h"
+#include "mpu6050_private.h"
 
 #define ALPHA 0.99f             /*!< Weight of gyroscope */
 #define RAD_TO_DEG 57.27272727f /*!< Radians to degrees */
 
 /* MPU6050 register */
+#define MPU6050_SMPLRT_DIV 0x19u
+#define MPU6050_CONFIG 0x1Au
 #define MPU6050_GYRO_CONFIG 0x1Bu
 #define MPU6050_ACCEL_CONFIG 0x1Cu
+#define MPU6050_MOT_THR 0x1Fu
+#define MPU6050_MOT_DUR 0x20u
+#define MPU6050_FIFO_EN 0x23u
 #define MPU6050_INTR_PIN_CFG 0x37u
 #define MPU6050_INTR_ENABLE 0x38u
 #define MPU6050_INTR_STATUS 0x3Au
 #define MPU6050_ACCEL_XOUT_H 0x3Bu
 #define MPU6050_GYRO_XOUT_H 0x43u
 #define MPU6050_TEMP_XOUT_H 0x41u
+#define MPU6050_USER_CTRL 0x6Au
 #define MPU6050_PWR_MGMT_1 0x6Bu
+#define MPU6050_PWR_MGMT_2 0x6Cu
+#define MPU6050_FIFO_COUNTH 0x72u
+#define MPU6050_FIFO_R_W 0x74u
 #define MPU6050_WHO_AM_I 0x75u
 
 const uint8_t MPU6050_DATA_RDY_INT_BIT = (uint8_t)BIT0;
@@ -34,41 +46,194 @@ const uint8_t MPU6050_FIFO_OVERFLOW_INT_BIT = (uint8_t)BIT4;
 const uint8_t MPU6050_MOT_DETECT_INT_BIT = (uint8_t)BIT6;
 const uint8_t MPU6050_ALL_INTERRUPTS = (MPU6050_DATA_RDY_INT_BIT | MPU6050_I2C_MASTER_INT_BIT | MPU6050_FIFO_OVERFLOW_INT_BIT | MPU6050_MOT_DETECT_INT_BIT);
 
-typedef struct
+const uint8_t MPU6050_FIFO_ACCE_BIT = (uint8_t)BIT3;
+const uint8_t MPU6050_FIFO_TEMP_BIT = (uint8_t)BIT7;
+const uint8_t MPU6050_FIFO_GYRO_X_BIT = (uint8_t)BIT6;
+const uint8_t MPU6050_FIFO_GYRO_Y_BIT = (uint8_t)BIT5;
+const uint8_t MPU6050_FIFO_GYRO_Z_BIT = (uint8_t)BIT4;
+const uint8_t MPU6050_FIFO_GYRO_BITS = (MPU6050_FIFO_GYRO_X_BIT | MPU6050_FIFO_GYRO_Y_BIT | MPU6050_FIFO_GYRO_Z_BIT);
+const uint8_t MPU6050_FIFO_ALL_BITS = (MPU6050_FIFO_ACCE_BIT | MPU6050_FIFO_TEMP_BIT | MPU6050_FIFO_GYRO_BITS);
+
+#define MPU6050_ACCEL_HPF_MASK 0x07u        /*!< ACCEL_CONFIG: ACCEL_HPF[2:0] */
+#define MPU6050_ACCEL_HPF_HOLD 0x07u        /*!< ACCEL_HPF=7：保持当前值作为运动检测基准 */
+#define MPU6050_PWR1_DEVICE_RESET BIT7      /*!< PWR_MGMT_1: DEVICE_RESET，自动清零 */
+#define MPU6050_PWR1_SLEEP BIT6             /*!< PWR_MGMT_1: SLEEP */
+#define MPU6050_PWR1_CYCLE BIT5             /*!< PWR_MGMT_1: CYCLE */
+#define MPU6050_PWR1_TEMP_DIS BIT3          /*!< PWR_MGMT_1: TEMP_DIS */
+#define MPU6050_PWR2_LP_WAKE_MASK 0xC0u     /*!< PWR_MGMT_2: LP_WAKE_CTRL[7:6] */
+#define MPU6050_PWR2_STBY_ACCEL 0x38u       /*!< PWR_MGMT_2: STBY_XA/YA/ZA */
+#define MPU6050_PWR2_STBY_GYRO 0x07u        /*!< PWR_MGMT_2: STBY_XG/YG/ZG */
+
+#define MPU6050_FIFO_SIZE 1024u             /*!< 硬件 FIFO 容量（字节） */
+#define MPU6050_USER_CTRL_FIFO_EN BIT6      /*!< USER_CTRL: 使能 FIFO */
+#define MPU6050_USER_CTRL_FIFO_RST BIT2     /*!< USER_CTRL: 复位 FIFO（仅在 FIFO_EN=0 时有效），自动清零 */
+#define MPU6050_USER_CTRL_I2C_MST_RST BIT1  /*!< USER_CTRL: 复位辅助 I2C 主机，自动清零 */
+#define MPU6050_USER_CTRL_SIG_COND_RST BIT0 /*!< USER_CTRL: 复位信号通路，自动清零 */
+
+/* 各量程对应的灵敏度（LSB/g、LSB/(°/s)），下标为 mpu6050_acce_fs_t / mpu6050_gyro_fs_t */
+static const float acce_sensitivity_table[] = {16384, 8192, 4096, 2048};
+static const float gyro_sensitivity_table[] = {131, 65.5, 32.8, 16.4};
+
+// 返回寄存器在影子副本中的位置，非可写配置寄存器返回 NULL
+static uint8_t *mpu6050_shadow_reg(mpu6050_dev_t *s, uint32_t reg)
 {
-    i2c_master_dev_handle_t i2c_dev;
-    gpio_num_t int_pin;
-    uint16_t dev_addr;
-    uint32_t counter;
-    float dt; /*!< delay time between two measurements, dt should be small (ms level) */
-    struct timeval *timer;
-} mpu6050_dev_t;
+    switch (reg)
+    {
+    case MPU6050_SMPLRT_DIV:
+        return &s->shadow.smplrt_div;
+    case MPU6050_CONFIG:
+        return &s->shadow.config;
+    case MPU6050_GYRO_CONFIG:
+        return &s->shadow.gyro_config;
+    case MPU6050_ACCEL_CONFIG:
+        return &s->shadow.accel_config;
+    case MPU6050_FIFO_EN:
+        return &s->shadow.fifo_en;
+    case MPU6050_INTR_PIN_CFG:
+        return &s->shadow.int_pin_cfg;
+    case MPU6050_INTR_ENABLE:
+        return &s->shadow.int_enable;
+    case MPU6050_USER_CTRL:
+        return &s->shadow.user_ctrl;
+    case MPU6050_PWR_MGMT_1:
+        return &s->shadow.pwr_mgmt_1;
+    case MPU6050_PWR_MGMT_2:
+        return &s->shadow.pwr_mgmt_2;
+    default:
+        return NULL;
+    }
+}
+
+// 写入后由硬件自动清零的位，读回总是 0
+static uint8_t mpu6050_self_clearing_bits(uint32_t reg)
+{
+    switch (reg)
+    {
+    case MPU6050_USER_CTRL:
+        return MPU6050_USER_CTRL_FIFO_RST | MPU6050_USER_CTRL_I2C_MST_RST | MPU6050_USER_CTRL_SIG_COND_RST;
+    case MPU6050_PWR_MGMT_1:
+        return MPU6050_PWR1_DEVICE_RESET;
+    default:
+        return 0;
+    }
+}
+
+// 把连续读/写的寄存器值同步到影子副本（地址自增，超出配置寄存器范围的部分忽略）。
+// 自动清零的位不记入影子，否则之后的位操作会把复位位连同其他位一起再写一次
+static void mpu6050_shadow_store(mpu6050_dev_t *s, uint8_t reg, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len && reg + i <= MPU6050_PWR_MGMT_2; i++)
+    {
+        uint8_t *shadow = mpu6050_shadow_reg(s, reg + i);
+        if (shadow)
+        {
+            *shadow = data[i] & (uint8_t)~mpu6050_self_clearing_bits(reg + i);
+        }
+    }
+}
 
-static esp_err_t mpu6050_write(mpu6050_handle_t sensor,
-                               uint8_t reg,
-                               const uint8_t *data,
-                               uint8_t len)
+esp_err_t mpu6050_write(mpu6050_handle_t sensor,
+                        uint8_t reg,
+                        const uint8_t *data,
+                        uint8_t len)
 {
     mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
 
+    if (NULL == s->i2c_dev)
+    {
+        // 离线句柄：只记录到影子副本，使配置类函数照常更新缓存
+        mpu6050_shadow_store(s, reg, data, len);
+        return ESP_OK;
+    }
+
     uint8_t buf[1 + len];
     buf[0] = reg;
     memcpy(&buf[1], data, len);
 
-    return i2c_master_transmit(s->i2c_dev, buf, sizeof(buf), 1000);
+    esp_err_t ret = i2c_mgr_transmit(s->i2c_dev, buf, sizeof(buf), 1000);
+    if (ESP_OK == ret)
+    {
+        mpu6050_shadow_store(s, reg, data, len);
+    }
+    return ret;
 }
 
 /* 代替原来的 mpu6050_read() */
-static esp_err_t mpu6050_read(mpu6050_handle_t sensor,
-                              uint8_t reg,
-                              uint8_t *data,
-                              uint8_t len)
+esp_err_t mpu6050_read(mpu6050_handle_t sensor,
+                       uint8_t reg,
+                       uint8_t *data,
+                       size_t len)
 {
     mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
-    return i2c_master_transmit_receive(s->i2c_dev,
-                                       &reg, 1,
-                                       data, len,
-                                       1000);
+    if (NULL == s->i2c_dev)
+    {
+        return ESP_ERR_INVALID_STATE; // 离线句柄没有数据可读
+    }
+    esp_err_t ret = i2c_mgr_transmit_receive(s->i2c_dev,
+                                             &reg, 1,
+                                             data, len,
+                                             1000);
+    if (ESP_OK == ret)
+    {
+        // 读到的配置寄存器也顺带刷新影子副本（FIFO_R_W 等数据寄存器不在范围内）
+        mpu6050_shadow_store(s, reg, data, len);
+    }
+    return ret;
+}
+
+// 取配置寄存器当前值：影子有效且未开启校验时直接返回影子，否则读器件
+static esp_err_t mpu6050_read_config(mpu6050_handle_t sensor, uint8_t reg, uint8_t *const value)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    uint8_t *shadow = mpu6050_shadow_reg(s, reg);
+
+    if (shadow && s->shadow_valid && !s->shadow_verify)
+    {
+        *value = *shadow;
+        return ESP_OK;
+    }
+    return mpu6050_read(sensor, reg, value, 1);
+}
+
+// 清除 clear_bits、置位 set_bits；值未变化时不产生写事务
+static esp_err_t mpu6050_update_bits(mpu6050_handle_t sensor, uint8_t reg, uint8_t clear_bits, uint8_t set_bits)
+{
+    uint8_t value;
+    esp_err_t ret = mpu6050_read_config(sensor, reg, &value);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    uint8_t new_value = (uint8_t)((value & ~clear_bits) | set_bits);
+    if (new_value == value)
+    {
+        return ESP_OK;
+    }
+    return mpu6050_write(sensor, reg, &new_value, 1);
+}
+
+// 更新量程缓存并预先计算倒数比例因子
+static void mpu6050_set_fs_cache(mpu6050_dev_t *s, mpu6050_acce_fs_t acce_fs, mpu6050_gyro_fs_t gyro_fs)
+{
+    s->acce_fs = acce_fs;
+    s->gyro_fs = gyro_fs;
+    s->acce_scale = 1.0f / acce_sensitivity_table[acce_fs];
+    s->gyro_scale = 1.0f / gyro_sensitivity_table[gyro_fs];
+    mpu6050_update_fixed_scale(s);
+}
+
+void mpu6050_update_fixed_scale(mpu6050_dev_t *s)
+{
+    const float acce_lsb_per_g = acce_sensitivity_table[s->acce_fs];
+    const float gyro_lsb_per_dps = gyro_sensitivity_table[s->gyro_fs];
+
+    s->gyro_lsb_q32 = (int32_t)lroundf(4294967296.0f / gyro_lsb_per_dps);
+    for (int i = 0; i < 3; i++)
+    {
+        s->acce_bias_lsb[i] = (int16_t)lroundf(s->acce_bias[i] * acce_lsb_per_g);
+        s->gyro_bias_q8[i] = (int32_t)lroundf(s->gyro_bias[i] * gyro_lsb_per_dps * 256.0f);
+    }
 }
 
 mpu6050_handle_t mpu6050_create(i2c_master_bus_handle_t bus_handle,
@@ -80,34 +245,44 @@ mpu6050_handle_t mpu6050_create(i2c_master_bus_handle_t bus_handle,
         return NULL; // 内存分配失败，直接返回NULL
     }
 
-    /* 将 MPU6050 挂到 I2C 总线上 */
-    i2c_device_config_t dev_cfg = {
-        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
-        .device_address = dev_addr, /* 0x68 或 0x69 */
-        .scl_speed_hz = 400000,
-    };
-    esp_err_t err = i2c_master_bus_add_device(bus_handle, &dev_cfg, &s->i2c_dev);
-    if (err != ESP_OK)
+    /* 将 MPU6050 挂到 I2C 总线上，离线句柄跳过 */
+    if (bus_handle)
     {
-        free(s); // 释放已分配的设备结构体
-        return NULL;
+        i2c_device_config_t dev_cfg = {
+            .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+            .device_address = dev_addr, /* 0x68 或 0x69 */
+            .scl_speed_hz = 400000,
+        };
+        const i2c_mgr_device_config_t mgr_cfg = {
+            .name = "mpu6050",
+            .priority = I2C_MGR_PRIO_HIGH, // 采样时序优先，可在显示刷新的分段之间插队
+        };
+        esp_err_t err = i2c_mgr_add_device(bus_handle, &dev_cfg, &mgr_cfg, &s->i2c_dev);
+        if (err != ESP_OK)
+        {
+            free(s); // 释放已分配的设备结构体
+            return NULL;
+        }
     }
 
+    s->dev_addr = dev_addr;
     s->counter = 0;
     s->dt = 0;
+    // 上电复位后量程均为0（±2g、±250°/s）、SMPLRT_DIV=0、DLPF 关闭（8kHz）
+    mpu6050_set_fs_cache(s, ACCE_FS_2G, GYRO_FS_250DPS);
+    s->dlpf = MPU6050_DLPF_260HZ;
+    s->sample_period_us = 125;
 
-    // 为 timer 分配内存
-    s->timer = (struct timeval *)malloc(sizeof(struct timeval));
-    if (!s->timer)
+    // 载入影子副本并据此同步量程与采样周期；失败时影子保持无效，位操作退回先读后写
+    if (s->i2c_dev)
     {
-        // 分配失败时释放已分配的资源
-        i2c_master_bus_rm_device(s->i2c_dev);
-        free(s);
-        return NULL;
+        mpu6050_refresh_shadow(s);
+    }
+    else
+    {
+        s->shadow.pwr_mgmt_1 = MPU6050_PWR1_SLEEP; // 离线句柄的影子即全部状态，取上电默认值
+        s->shadow_valid = true;
     }
-
-    // 正确初始化 timer
-    gettimeofday(s->timer, NULL); // 传入 s->timer (struct timeval*)
 
     return s;
 }
@@ -118,7 +293,7 @@ void mpu6050_delete(mpu6050_handle_t sensor)
     if (s)
     {
         if (s->i2c_dev)
-            i2c_master_bus_rm_device(s->i2c_dev);
+            i2c_mgr_rm_device(s->i2c_dev);
         free(s);
     }
 }
@@ -128,97 +303,324 @@ esp_err_t mpu6050_get_deviceid(mpu6050_handle_t sensor, uint8_t *const deviceid)
 }
 
 esp_err_t mpu6050_wake_up(mpu6050_handle_t sensor)
+{
+    return mpu6050_update_bits(sensor, MPU6050_PWR_MGMT_1, MPU6050_PWR1_SLEEP, 0);
+}
+
+esp_err_t mpu6050_sleep(mpu6050_handle_t sensor)
+{
+    return mpu6050_update_bits(sensor, MPU6050_PWR_MGMT_1, 0, MPU6050_PWR1_SLEEP);
+}
+
+esp_err_t mpu6050_enter_idle(mpu6050_handle_t sensor, const mpu6050_idle_config_t *const idle_config)
+{
+    return mpu6050_enter_idle_ex(sensor, idle_config, NULL, NULL);
+}
+
+esp_err_t mpu6050_enter_idle_ex(mpu6050_handle_t sensor, const mpu6050_idle_config_t *const idle_config,
+                                void (*quiesced)(void *ctx), void *ctx)
 {
     esp_err_t ret;
-    uint8_t tmp;
-    ret = mpu6050_read(sensor, MPU6050_PWR_MGMT_1, &tmp, 1);
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+
+    if (NULL == s || NULL == idle_config || idle_config->wake_freq > MPU6050_LP_WAKE_40HZ)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s->idle)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ret = mpu6050_read_config(sensor, MPU6050_INTR_ENABLE, &s->idle_saved_int_enable);
     if (ESP_OK != ret)
     {
         return ret;
     }
-    tmp &= (~BIT6);
-    ret = mpu6050_write(sensor, MPU6050_PWR_MGMT_1, &tmp, 1);
+    // 此后任何一步失败都由 mpu6050_exit_idle() 回滚
+    s->idle = true;
+
+    // 先关闭原有中断源，避免循环唤醒时继续触发 DATA_RDY
+    uint8_t int_enable = 0;
+    ret = mpu6050_write(sensor, MPU6050_INTR_ENABLE, &int_enable, 1);
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+
+    if (quiesced)
+    {
+        quiesced(ctx);
+    }
+
+    // 加速度计须处于正常采样状态，高通滤波器复位后才能建立运动检测基准
+    ret = mpu6050_update_bits(sensor, MPU6050_PWR_MGMT_1, MPU6050_PWR1_SLEEP | MPU6050_PWR1_CYCLE, 0);
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+    ret = mpu6050_update_bits(sensor, MPU6050_PWR_MGMT_2, MPU6050_PWR2_STBY_ACCEL, 0);
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+    ret = mpu6050_update_bits(sensor, MPU6050_ACCEL_CONFIG, MPU6050_ACCEL_HPF_MASK, 0);
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+
+    // MOT_THR(0x1F) 与 MOT_DUR(0x20) 相邻，一次写入
+    uint8_t motion_regs[2] = {idle_config->motion_threshold, idle_config->motion_duration};
+    ret = mpu6050_write(sensor, MPU6050_MOT_THR, motion_regs, sizeof(motion_regs));
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+    int_enable = MPU6050_MOT_DETECT_INT_BIT;
+    ret = mpu6050_write(sensor, MPU6050_INTR_ENABLE, &int_enable, 1);
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+
+    // 至少等待一个加速度计采样（1ms）让高通滤波器稳定，再锁存为基准
+    esp_rom_delay_us(1000);
+    ret = mpu6050_update_bits(sensor, MPU6050_ACCEL_CONFIG, MPU6050_ACCEL_HPF_MASK, MPU6050_ACCEL_HPF_HOLD);
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+
+    // 陀螺仪待机并设置唤醒频率，最后进入循环模式并关闭温度传感器
+    ret = mpu6050_update_bits(sensor, MPU6050_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_MASK | MPU6050_PWR2_STBY_GYRO,
+                              (uint8_t)(idle_config->wake_freq << 6) | MPU6050_PWR2_STBY_GYRO);
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+    ret = mpu6050_update_bits(sensor, MPU6050_PWR_MGMT_1, 0, MPU6050_PWR1_CYCLE | MPU6050_PWR1_TEMP_DIS);
+    if (ESP_OK != ret)
+    {
+        goto err;
+    }
+    return ESP_OK;
+
+err:
+    mpu6050_exit_idle(sensor);
     return ret;
 }
 
-esp_err_t mpu6050_sleep(mpu6050_handle_t sensor)
+esp_err_t mpu6050_exit_idle(mpu6050_handle_t sensor)
 {
     esp_err_t ret;
-    uint8_t tmp;
-    ret = mpu6050_read(sensor, MPU6050_PWR_MGMT_1, &tmp, 1);
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+
+    if (NULL == s)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s->idle)
+    {
+        return ESP_OK;
+    }
+
+    ret = mpu6050_update_bits(sensor, MPU6050_PWR_MGMT_1, MPU6050_PWR1_CYCLE | MPU6050_PWR1_TEMP_DIS, 0);
     if (ESP_OK != ret)
     {
         return ret;
     }
-    tmp |= BIT6;
-    ret = mpu6050_write(sensor, MPU6050_PWR_MGMT_1, &tmp, 1);
-    return ret;
+    ret = mpu6050_update_bits(sensor, MPU6050_PWR_MGMT_2,
+                              MPU6050_PWR2_LP_WAKE_MASK | MPU6050_PWR2_STBY_ACCEL | MPU6050_PWR2_STBY_GYRO, 0);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    ret = mpu6050_update_bits(sensor, MPU6050_ACCEL_CONFIG, MPU6050_ACCEL_HPF_MASK, 0);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    ret = mpu6050_write(sensor, MPU6050_INTR_ENABLE, &s->idle_saved_int_enable, 1);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    s->idle = false;
+    // idle 期间没有采样，下次滤波由加速度计重新初始化角度，避免跨越 idle 的大 dt 积分
+    s->counter = 0;
+    return ESP_OK;
 }
 
 esp_err_t mpu6050_config(mpu6050_handle_t sensor, const mpu6050_acce_fs_t acce_fs, const mpu6050_gyro_fs_t gyro_fs)
 {
-    uint8_t config_regs[2] = {gyro_fs << 3, acce_fs << 3};
-    return mpu6050_write(sensor, MPU6050_GYRO_CONFIG, config_regs, sizeof(config_regs));
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    // 保留 ACCEL_CONFIG 中 idle 模式使用的 ACCEL_HPF 位
+    uint8_t config_regs[2] = {gyro_fs << 3,
+                              (uint8_t)((acce_fs << 3) | (s->shadow.accel_config & MPU6050_ACCEL_HPF_MASK))};
+    esp_err_t ret = mpu6050_write(sensor, MPU6050_GYRO_CONFIG, config_regs, sizeof(config_regs));
+    if (ESP_OK == ret)
+    {
+        mpu6050_set_fs_cache(s, acce_fs, gyro_fs);
+    }
+    return ret;
 }
 
-esp_err_t mpu6050_get_acce_sensitivity(mpu6050_handle_t sensor, float *const acce_sensitivity)
+esp_err_t mpu6050_config_rate(mpu6050_handle_t sensor, const mpu6050_rate_config_t *const rate_config,
+                              float *const effective_odr_hz)
 {
-    esp_err_t ret;
-    uint8_t acce_fs;
-    ret = mpu6050_read(sensor, MPU6050_ACCEL_CONFIG, &acce_fs, 1);
-    acce_fs = (acce_fs >> 3) & 0x03;
-    switch (acce_fs)
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+
+    if (NULL == s || NULL == rate_config || 0 == rate_config->odr_hz ||
+        rate_config->dlpf > MPU6050_DLPF_5HZ)
     {
-    case ACCE_FS_2G:
-        *acce_sensitivity = 16384;
-        break;
+        return ESP_ERR_INVALID_ARG;
+    }
 
-    case ACCE_FS_4G:
-        *acce_sensitivity = 8192;
-        break;
+    const uint32_t gyro_rate_hz = (MPU6050_DLPF_260HZ == rate_config->dlpf) ? 8000 : 1000;
+    uint32_t div = (gyro_rate_hz + rate_config->odr_hz / 2) / rate_config->odr_hz; // 四舍五入
+    if (div < 1)
+    {
+        div = 1;
+    }
+    if (div > 256)
+    {
+        div = 256;
+    }
 
-    case ACCE_FS_8G:
-        *acce_sensitivity = 4096;
-        break;
+    // SMPLRT_DIV(0x19) 与 CONFIG(0x1A) 相邻，一次写入；EXT_SYNC_SET 保持关闭
+    uint8_t regs[2] = {(uint8_t)(div - 1), (uint8_t)rate_config->dlpf};
+    esp_err_t ret = mpu6050_write(sensor, MPU6050_SMPLRT_DIV, regs, sizeof(regs));
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
 
-    case ACCE_FS_16G:
-        *acce_sensitivity = 2048;
-        break;
+    s->dlpf = rate_config->dlpf;
+    s->sample_period_us = div * 1000000u / gyro_rate_hz;
+    if (effective_odr_hz)
+    {
+        *effective_odr_hz = (float)gyro_rate_hz / (float)div;
+    }
+    return ESP_OK;
+}
 
-    default:
-        break;
+// 由影子副本中的 SMPLRT_DIV/CONFIG/GYRO_CONFIG/ACCEL_CONFIG 推算量程、DLPF 与采样周期
+static void mpu6050_apply_shadow(mpu6050_dev_t *s)
+{
+    mpu6050_set_fs_cache(s,
+                         (mpu6050_acce_fs_t)((s->shadow.accel_config >> 3) & 0x03),
+                         (mpu6050_gyro_fs_t)((s->shadow.gyro_config >> 3) & 0x03));
+
+    mpu6050_dlpf_t dlpf = (mpu6050_dlpf_t)(s->shadow.config & 0x07);
+    if (dlpf > MPU6050_DLPF_5HZ)
+    {
+        dlpf = MPU6050_DLPF_260HZ; // DLPF_CFG=7 为保留值，陀螺仪输出率同 260Hz 档
     }
-    return ret;
+    const uint32_t gyro_rate_hz = (MPU6050_DLPF_260HZ == dlpf) ? 8000 : 1000;
+    s->dlpf = dlpf;
+    s->sample_period_us = (s->shadow.smplrt_div + 1u) * 1000000u / gyro_rate_hz;
 }
 
-esp_err_t mpu6050_get_gyro_sensitivity(mpu6050_handle_t sensor, float *const gyro_sensitivity)
+esp_err_t mpu6050_sync_sensitivity(mpu6050_handle_t sensor)
 {
-    esp_err_t ret;
-    uint8_t gyro_fs;
-    ret = mpu6050_read(sensor, MPU6050_GYRO_CONFIG, &gyro_fs, 1);
-    gyro_fs = (gyro_fs >> 3) & 0x03;
-    switch (gyro_fs)
+    // GYRO_CONFIG(0x1B) 与 ACCEL_CONFIG(0x1C) 相邻，一次读出，读操作会同时刷新影子副本
+    uint8_t config_regs[2];
+    esp_err_t ret = mpu6050_read(sensor, MPU6050_GYRO_CONFIG, config_regs, sizeof(config_regs));
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    mpu6050_set_fs_cache((mpu6050_dev_t *)sensor,
+                         (mpu6050_acce_fs_t)((config_regs[1] >> 3) & 0x03),
+                         (mpu6050_gyro_fs_t)((config_regs[0] >> 3) & 0x03));
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_refresh_shadow(mpu6050_handle_t sensor)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    if (NULL == s)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 按地址连续的分段突发读取，读操作内部完成影子更新
+    static const struct
+    {
+        uint8_t reg;
+        uint8_t len;
+    } segments[] = {
+        {MPU6050_SMPLRT_DIV, 4},   // SMPLRT_DIV ~ ACCEL_CONFIG
+        {MPU6050_FIFO_EN, 1},      // FIFO_EN
+        {MPU6050_INTR_PIN_CFG, 2}, // INT_PIN_CFG ~ INT_ENABLE
+        {MPU6050_USER_CTRL, 3},    // USER_CTRL ~ PWR_MGMT_2
+    };
+    uint8_t buf[4];
+
+    s->shadow_valid = false;
+    for (size_t i = 0; i < sizeof(segments) / sizeof(segments[0]); i++)
     {
-    case GYRO_FS_250DPS:
-        *gyro_sensitivity = 131;
-        break;
+        esp_err_t ret = mpu6050_read(sensor, segments[i].reg, buf, segments[i].len);
+        if (ESP_OK != ret)
+        {
+            return ret;
+        }
+    }
+    s->shadow_valid = true;
 
-    case GYRO_FS_500DPS:
-        *gyro_sensitivity = 65.5;
-        break;
+    mpu6050_apply_shadow(s);
+    if (0 == (s->shadow.user_ctrl & MPU6050_USER_CTRL_FIFO_EN))
+    {
+        s->fifo_channels = 0;
+        s->fifo_frame_size = 0;
+    }
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_set_shadow_verify(mpu6050_handle_t sensor, bool enable)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    if (NULL == s)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s->shadow_verify = enable;
+    return ESP_OK;
+}
 
-    case GYRO_FS_1000DPS:
-        *gyro_sensitivity = 32.8;
-        break;
+esp_err_t mpu6050_get_acce_sensitivity(mpu6050_handle_t sensor, float *const acce_sensitivity)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    *acce_sensitivity = acce_sensitivity_table[s->acce_fs];
+    return ESP_OK;
+}
 
-    case GYRO_FS_2000DPS:
-        *gyro_sensitivity = 16.4;
-        break;
+esp_err_t mpu6050_get_gyro_sensitivity(mpu6050_handle_t sensor, float *const gyro_sensitivity)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    *gyro_sensitivity = gyro_sensitivity_table[s->gyro_fs];
+    return ESP_OK;
+}
 
-    default:
-        break;
+esp_err_t mpu6050_get_full_scale(mpu6050_handle_t sensor, mpu6050_acce_fs_t *const acce_fs,
+                                 mpu6050_gyro_fs_t *const gyro_fs)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    if (NULL == s)
+    {
+        return ESP_ERR_INVALID_ARG;
     }
-    return ret;
+    if (acce_fs)
+    {
+        *acce_fs = s->acce_fs;
+    }
+    if (gyro_fs)
+    {
+        *gyro_fs = s->gyro_fs;
+    }
+    return ESP_OK;
 }
 
 esp_err_t mpu6050_config_interrupts(mpu6050_handle_t sensor, const mpu6050_int_config_t *const interrupt_configuration)
@@ -245,13 +647,6 @@ esp_err_t mpu6050_config_interrupts(mpu6050_handle_t sensor, const mpu6050_int_c
 
     uint8_t int_pin_cfg = 0x00;
 
-    ret = mpu6050_read(sensor, MPU6050_INTR_PIN_CFG, &int_pin_cfg, 1);
-
-    if (ESP_OK != ret)
-    {
-        return ret;
-    }
-
     if (INTERRUPT_PIN_ACTIVE_LOW == interrupt_configuration->active_level)
     {
         int_pin_cfg |= BIT7;
@@ -272,7 +667,8 @@ esp_err_t mpu6050_config_interrupts(mpu6050_handle_t sensor, const mpu6050_int_c
         int_pin_cfg |= BIT4;
     }
 
-    ret = mpu6050_write(sensor, MPU6050_INTR_PIN_CFG, &int_pin_cfg, 1);
+    // 只改写引脚行为相关的 BIT7~BIT4，其余位（如 I2C_BYPASS_EN）保持不变
+    ret = mpu6050_update_bits(sensor, MPU6050_INTR_PIN_CFG, BIT7 | BIT6 | BIT5 | BIT4, int_pin_cfg);
 
     if (ESP_OK != ret)
     {
@@ -322,53 +718,22 @@ esp_err_t mpu6050_register_isr(mpu6050_handle_t sensor, const mpu6050_isr_t isr)
     }
 
     ret = gpio_intr_enable(sensor_device->int_pin);
+    if (ESP_OK != ret)
+    {
+        gpio_isr_handler_remove(sensor_device->int_pin); // 失败时不留下已挂上的 handler
+    }
 
     return ret;
 }
 
 esp_err_t mpu6050_enable_interrupts(mpu6050_handle_t sensor, uint8_t interrupt_sources)
 {
-    esp_err_t ret;
-    uint8_t enabled_interrupts = 0x00;
-
-    ret = mpu6050_read(sensor, MPU6050_INTR_ENABLE, &enabled_interrupts, 1);
-
-    if (ESP_OK != ret)
-    {
-        return ret;
-    }
-
-    if (enabled_interrupts != interrupt_sources)
-    {
-
-        enabled_interrupts |= interrupt_sources;
-
-        ret = mpu6050_write(sensor, MPU6050_INTR_ENABLE, &enabled_interrupts, 1);
-    }
-
-    return ret;
+    return mpu6050_update_bits(sensor, MPU6050_INTR_ENABLE, 0, interrupt_sources);
 }
 
 esp_err_t mpu6050_disable_interrupts(mpu6050_handle_t sensor, uint8_t interrupt_sources)
 {
-    esp_err_t ret;
-    uint8_t enabled_interrupts = 0x00;
-
-    ret = mpu6050_read(sensor, MPU6050_INTR_ENABLE, &enabled_interrupts, 1);
-
-    if (ESP_OK != ret)
-    {
-        return ret;
-    }
-
-    if (0 != (enabled_interrupts & interrupt_sources))
-    {
-        enabled_interrupts &= (~interrupt_sources);
-
-        ret = mpu6050_write(sensor, MPU6050_INTR_ENABLE, &enabled_interrupts, 1);
-    }
-
-    return ret;
+    return mpu6050_update_bits(sensor, MPU6050_INTR_ENABLE, interrupt_sources, 0);
 }
 
 esp_err_t mpu6050_get_interrupt_status(mpu6050_handle_t sensor, uint8_t *const out_intr_status)
@@ -427,46 +792,36 @@ esp_err_t mpu6050_get_raw_gyro(mpu6050_handle_t sensor, mpu6050_raw_gyro_value_t
 esp_err_t mpu6050_get_acce(mpu6050_handle_t sensor, mpu6050_acce_value_t *const acce_value)
 {
     esp_err_t ret;
-    float acce_sensitivity;
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
     mpu6050_raw_acce_value_t raw_acce;
 
-    ret = mpu6050_get_acce_sensitivity(sensor, &acce_sensitivity);
-    if (ret != ESP_OK)
-    {
-        return ret;
-    }
     ret = mpu6050_get_raw_acce(sensor, &raw_acce);
     if (ret != ESP_OK)
     {
         return ret;
     }
 
-    acce_value->acce_x = raw_acce.raw_acce_x / acce_sensitivity;
-    acce_value->acce_y = raw_acce.raw_acce_y / acce_sensitivity;
-    acce_value->acce_z = raw_acce.raw_acce_z / acce_sensitivity;
+    acce_value->acce_x = raw_acce.raw_acce_x * s->acce_scale - s->acce_bias[0];
+    acce_value->acce_y = raw_acce.raw_acce_y * s->acce_scale - s->acce_bias[1];
+    acce_value->acce_z = raw_acce.raw_acce_z * s->acce_scale - s->acce_bias[2];
     return ESP_OK;
 }
 
 esp_err_t mpu6050_get_gyro(mpu6050_handle_t sensor, mpu6050_gyro_value_t *const gyro_value)
 {
     esp_err_t ret;
-    float gyro_sensitivity;
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
     mpu6050_raw_gyro_value_t raw_gyro;
 
-    ret = mpu6050_get_gyro_sensitivity(sensor, &gyro_sensitivity);
-    if (ret != ESP_OK)
-    {
-        return ret;
-    }
     ret = mpu6050_get_raw_gyro(sensor, &raw_gyro);
     if (ret != ESP_OK)
     {
         return ret;
     }
 
-    gyro_value->gyro_x = raw_gyro.raw_gyro_x / gyro_sensitivity;
-    gyro_value->gyro_y = raw_gyro.raw_gyro_y / gyro_sensitivity;
-    gyro_value->gyro_z = raw_gyro.raw_gyro_z / gyro_sensitivity;
+    gyro_value->gyro_x = raw_gyro.raw_gyro_x * s->gyro_scale - s->gyro_bias[0];
+    gyro_value->gyro_y = raw_gyro.raw_gyro_y * s->gyro_scale - s->gyro_bias[1];
+    gyro_value->gyro_z = raw_gyro.raw_gyro_z * s->gyro_scale - s->gyro_bias[2];
     return ESP_OK;
 }
 
@@ -478,14 +833,430 @@ esp_err_t mpu6050_get_temp(mpu6050_handle_t sensor, mpu6050_temp_value_t *const
     return ret;
 }
 
+esp_err_t mpu6050_get_raw_motion(mpu6050_handle_t sensor, mpu6050_raw_motion_value_t *const raw_motion)
+{
+    if (NULL == raw_motion)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 0x3B~0x48 连续14字节：ACCEL(6) TEMP(2) GYRO(6)，一次事务读完
+    uint8_t data_rd[14];
+    esp_err_t ret = mpu6050_read(sensor, MPU6050_ACCEL_XOUT_H, data_rd, sizeof(data_rd));
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    raw_motion->raw_acce.raw_acce_x = (int16_t)((data_rd[0] << 8) + (data_rd[1]));
+    raw_motion->raw_acce.raw_acce_y = (int16_t)((data_rd[2] << 8) + (data_rd[3]));
+    raw_motion->raw_acce.raw_acce_z = (int16_t)((data_rd[4] << 8) + (data_rd[5]));
+    raw_motion->raw_temp = (int16_t)((data_rd[6] << 8) + (data_rd[7]));
+    raw_motion->raw_gyro.raw_gyro_x = (int16_t)((data_rd[8] << 8) + (data_rd[9]));
+    raw_motion->raw_gyro.raw_gyro_y = (int16_t)((data_rd[10] << 8) + (data_rd[11]));
+    raw_motion->raw_gyro.raw_gyro_z = (int16_t)((data_rd[12] << 8) + (data_rd[13]));
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_convert_motion(mpu6050_handle_t sensor, const mpu6050_raw_motion_value_t *const raw_motion,
+                                 mpu6050_acce_value_t *const acce_value, mpu6050_gyro_value_t *const gyro_value,
+                                 mpu6050_temp_value_t *const temp_value)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+
+    if (NULL == s || NULL == raw_motion || NULL == acce_value || NULL == gyro_value || NULL == temp_value)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    acce_value->acce_x = raw_motion->raw_acce.raw_acce_x * s->acce_scale - s->acce_bias[0];
+    acce_value->acce_y = raw_motion->raw_acce.raw_acce_y * s->acce_scale - s->acce_bias[1];
+    acce_value->acce_z = raw_motion->raw_acce.raw_acce_z * s->acce_scale - s->acce_bias[2];
+    gyro_value->gyro_x = raw_motion->raw_gyro.raw_gyro_x * s->gyro_scale - s->gyro_bias[0];
+    gyro_value->gyro_y = raw_motion->raw_gyro.raw_gyro_y * s->gyro_scale - s->gyro_bias[1];
+    gyro_value->gyro_z = raw_motion->raw_gyro.raw_gyro_z * s->gyro_scale - s->gyro_bias[2];
+    temp_value->temp = raw_motion->raw_temp / 340.00f + 36.53f;
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_get_motion(mpu6050_handle_t sensor, mpu6050_acce_value_t *const acce_value,
+                             mpu6050_gyro_value_t *const gyro_value, mpu6050_temp_value_t *const temp_value)
+{
+    esp_err_t ret;
+    mpu6050_raw_motion_value_t raw;
+
+    if (NULL == acce_value || NULL == gyro_value || NULL == temp_value)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = mpu6050_get_raw_motion(sensor, &raw);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    return mpu6050_convert_motion(sensor, &raw, acce_value, gyro_value, temp_value);
+}
+
+esp_err_t mpu6050_get_sample(mpu6050_handle_t sensor, mpu6050_sample_t *const sample)
+{
+    if (NULL == sample)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 数据寄存器在读事务开始时锁存，时间戳取在事务之前
+    sample->timestamp_us = esp_timer_get_time();
+    esp_err_t ret = mpu6050_get_raw_motion(sensor, &sample->raw);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+    return mpu6050_convert_motion(sensor, &sample->raw, &sample->acce, &sample->gyro, &sample->temp);
+}
+
+esp_err_t mpu6050_get_sample_period(mpu6050_handle_t sensor, uint32_t *const period_us)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    if (NULL == s || NULL == period_us)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *period_us = s->sample_period_us;
+    return ESP_OK;
+}
+
+// 按 FIFO_EN 通道组合计算帧长
+static uint8_t mpu6050_fifo_frame_size(uint8_t channels)
+{
+    uint8_t size = 0;
+    if (channels & MPU6050_FIFO_ACCE_BIT)
+        size += 6;
+    if (channels & MPU6050_FIFO_TEMP_BIT)
+        size += 2;
+    if (channels & MPU6050_FIFO_GYRO_X_BIT)
+        size += 2;
+    if (channels & MPU6050_FIFO_GYRO_Y_BIT)
+        size += 2;
+    if (channels & MPU6050_FIFO_GYRO_Z_BIT)
+        size += 2;
+    return size;
+}
+
+// 将一帧 FIFO 字节解析为原始数据，未启用的通道置0
+static void mpu6050_fifo_parse_frame(uint8_t channels, const uint8_t *p, mpu6050_raw_motion_value_t *frame)
+{
+    memset(frame, 0, sizeof(*frame));
+    if (channels & MPU6050_FIFO_ACCE_BIT)
+    {
+        frame->raw_acce.raw_acce_x = (int16_t)((p[0] << 8) + (p[1]));
+        frame->raw_acce.raw_acce_y = (int16_t)((p[2] << 8) + (p[3]));
+        frame->raw_acce.raw_acce_z = (int16_t)((p[4] << 8) + (p[5]));
+        p += 6;
+    }
+    if (channels & MPU6050_FIFO_TEMP_BIT)
+    {
+        frame->raw_temp = (int16_t)((p[0] << 8) + (p[1]));
+        p += 2;
+    }
+    if (channels & MPU6050_FIFO_GYRO_X_BIT)
+    {
+        frame->raw_gyro.raw_gyro_x = (int16_t)((p[0] << 8) + (p[1]));
+        p += 2;
+    }
+    if (channels & MPU6050_FIFO_GYRO_Y_BIT)
+    {
+        frame->raw_gyro.raw_gyro_y = (int16_t)((p[0] << 8) + (p[1]));
+        p += 2;
+    }
+    if (channels & MPU6050_FIFO_GYRO_Z_BIT)
+    {
+        frame->raw_gyro.raw_gyro_z = (int16_t)((p[0] << 8) + (p[1]));
+    }
+}
+
+// 关闭并清空 FIFO，enable 为 true 时随后重新使能
+static esp_err_t mpu6050_fifo_restart(mpu6050_handle_t sensor, bool enable)
+{
+    esp_err_t ret;
+    uint8_t user_ctrl;
+
+    ret = mpu6050_read_config(sensor, MPU6050_USER_CTRL, &user_ctrl);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    user_ctrl &= (uint8_t)~MPU6050_USER_CTRL_FIFO_EN;
+    uint8_t tmp = user_ctrl | MPU6050_USER_CTRL_FIFO_RST;
+    ret = mpu6050_write(sensor, MPU6050_USER_CTRL, &tmp, 1);
+    if (ESP_OK != ret || !enable)
+    {
+        return ret;
+    }
+
+    // FIFO_RESET 位由硬件自动清零
+    tmp = user_ctrl | MPU6050_USER_CTRL_FIFO_EN;
+    return mpu6050_write(sensor, MPU6050_USER_CTRL, &tmp, 1);
+}
+
+esp_err_t mpu6050_fifo_start(mpu6050_handle_t sensor, uint8_t channels)
+{
+    esp_err_t ret;
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+
+    if (NULL == s || 0 == channels || 0 != (channels & (uint8_t)~MPU6050_FIFO_ALL_BITS))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = mpu6050_fifo_restart(sensor, false);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    ret = mpu6050_write(sensor, MPU6050_FIFO_EN, &channels, 1);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    s->fifo_channels = channels;
+    s->fifo_frame_size = mpu6050_fifo_frame_size(channels);
+    return mpu6050_fifo_restart(sensor, true);
+}
+
+esp_err_t mpu6050_fifo_stop(mpu6050_handle_t sensor)
+{
+    esp_err_t ret;
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    uint8_t channels = 0;
+
+    ret = mpu6050_write(sensor, MPU6050_FIFO_EN, &channels, 1);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    s->fifo_channels = 0;
+    s->fifo_frame_size = 0;
+    return mpu6050_fifo_restart(sensor, false);
+}
+
+esp_err_t mpu6050_fifo_reset(mpu6050_handle_t sensor)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    return mpu6050_fifo_restart(sensor, 0 != s->fifo_channels);
+}
+
+esp_err_t mpu6050_fifo_get_count(mpu6050_handle_t sensor, uint16_t *const count)
+{
+    if (NULL == count)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t data_rd[2];
+    esp_err_t ret = mpu6050_read(sensor, MPU6050_FIFO_COUNTH, data_rd, sizeof(data_rd));
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    *count = (uint16_t)((data_rd[0] << 8) | data_rd[1]);
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_fifo_read_frames(mpu6050_handle_t sensor, mpu6050_raw_motion_value_t *const frames,
+                                   size_t max_frames, size_t *const out_frames, int64_t *const timestamp_us)
+{
+    esp_err_t ret;
+    uint16_t count;
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+
+    if (NULL == s || NULL == frames || NULL == out_frames)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_frames = 0;
+    if (0 == s->fifo_channels)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ret = mpu6050_fifo_get_count(sensor, &count);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    // FIFO_COUNT 读出时刻即最新一帧的（近似）采集时刻
+    const int64_t drain_us = esp_timer_get_time();
+    const size_t frame_size = s->fifo_frame_size;
+    // 溢出后硬件丢弃最旧的字节，帧边界随之错位，只能清空重新对齐
+    if (count >= MPU6050_FIFO_SIZE || 0 != (count % frame_size))
+    {
+        ret = mpu6050_fifo_reset(sensor);
+        return (ESP_OK == ret) ? ESP_ERR_INVALID_STATE : ret;
+    }
+
+    size_t n = count / frame_size;
+    if (n > max_frames)
+    {
+        n = max_frames;
+    }
+    if (0 == n)
+    {
+        return ESP_OK;
+    }
+
+    // 原始字节放在 frames 缓冲区尾部，再从前往后原地解析：
+    // sizeof(帧结构) >= frame_size，所以第 i 帧写入时不会覆盖尚未解析的字节
+    uint8_t *raw = (uint8_t *)frames + n * (sizeof(*frames) - frame_size);
+    ret = mpu6050_read(sensor, MPU6050_FIFO_R_W, raw, n * frame_size);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        mpu6050_raw_motion_value_t frame;
+        mpu6050_fifo_parse_frame(s->fifo_channels, &raw[i * frame_size], &frame);
+        frames[i] = frame;
+    }
+    *out_frames = n;
+    if (timestamp_us)
+    {
+        // 只读出了最旧的 n 帧时，FIFO 中还剩 count/frame_size - n 帧更新的数据
+        *timestamp_us = drain_us - (int64_t)(count / frame_size - n) * s->sample_period_us;
+    }
+    return ESP_OK;
+}
+
+#if CONFIG_MPU6050_FIXED_POINT_FILTER
+
+#define ALPHA_Q15 32440     /*!< ALPHA in Q15 */
+#define DEG_Q16(x) ((x) * 65536)
+
+// atan(r)，r ∈ [0, 1]（Q15），返回角度（度，Q16）
+// atan(r) ≈ π/4·r + r·(1 − r)·(0.2447 + 0.0663·r)，最大误差约 0.09°
+static inline int32_t mpu6050_atan_unit_q16(int32_t r)
+{
+    const int32_t lin = 90 * r;                   // 45° · r，Q15 → Q16
+    const int32_t t = (r * (32768 - r)) >> 15;    // r·(1 − r)，Q15
+    const int32_t c = 918833 + (int32_t)(((int64_t)248952 * r) >> 15); // (0.2447 + 0.0663·r) rad → 度，Q16
+    return lin + (int32_t)(((int64_t)t * c) >> 15);
+}
+
+// 整数 atan2，按八分圆折算到 [0, 1] 再查多项式，返回角度（度，Q16）
+static int32_t mpu6050_atan2_q16(int32_t y, int32_t x)
+{
+    const uint32_t ax = (x < 0) ? (uint32_t)-x : (uint32_t)x;
+    const uint32_t ay = (y < 0) ? (uint32_t)-y : (uint32_t)y;
+    int32_t angle;
+
+    if (0 == ax && 0 == ay)
+    {
+        return 0;
+    }
+    if (ay <= ax)
+    {
+        angle = mpu6050_atan_unit_q16((int32_t)((ay << 15) / ax));
+    }
+    else
+    {
+        angle = DEG_Q16(90) - mpu6050_atan_unit_q16((int32_t)((ax << 15) / ay));
+    }
+    if (x < 0)
+    {
+        angle = DEG_Q16(180) - angle;
+    }
+    return (y < 0) ? -angle : angle;
+}
+
+// 定点互补滤波的公共部分：加速度三轴同一比例即可（atan2 与比例无关），角速度为 °/s（Q16）
+static esp_err_t mpu6050_filter_update_q16(mpu6050_dev_t *sens, int32_t ax, int32_t ay, int32_t az,
+                                           int32_t rate_x_q16, int32_t rate_y_q16, int64_t timestamp_us,
+                                           complimentary_angle_t *const complimentary_angle)
+{
+    if (sens->counter > 0 && timestamp_us <= sens->last_timestamp_us)
+    {
+        return ESP_ERR_INVALID_ARG; // 同一帧重复滤波会破坏积分
+    }
+
+    const int32_t acce_roll = mpu6050_atan2_q16(ay, az);
+    const int32_t acce_pitch = mpu6050_atan2_q16(ax, az);
+
+    sens->counter++;
+    if (sens->counter == 1)
+    {
+        sens->roll_q16 = acce_roll;
+        sens->pitch_q16 = acce_pitch;
+    }
+    else
+    {
+        const int64_t dt_us = timestamp_us - sens->last_timestamp_us;
+        sens->dt = dt_us * 1e-6f;
+
+        // 角速度（Q16）乘以整数微秒得到本周期转过的角度
+        const int32_t gyro_roll = (int32_t)(((int64_t)rate_x_q16 * dt_us) / 1000000);
+        const int32_t gyro_pitch = (int32_t)(((int64_t)rate_y_q16 * dt_us) / 1000000);
+
+        sens->roll_q16 = (int32_t)(((int64_t)ALPHA_Q15 * (sens->roll_q16 + gyro_roll) + (int64_t)(32768 - ALPHA_Q15) * acce_roll) >> 15);
+        sens->pitch_q16 = (int32_t)(((int64_t)ALPHA_Q15 * (sens->pitch_q16 + gyro_pitch) + (int64_t)(32768 - ALPHA_Q15) * acce_pitch) >> 15);
+    }
+    sens->last_timestamp_us = timestamp_us;
+
+    complimentary_angle->roll = sens->roll_q16 * (1.0f / 65536);
+    complimentary_angle->pitch = sens->pitch_q16 * (1.0f / 65536);
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_complimentory_filter(mpu6050_handle_t sensor, const mpu6050_acce_value_t *const acce_value,
+                                       const mpu6050_gyro_value_t *const gyro_value, int64_t timestamp_us,
+                                       complimentary_angle_t *const complimentary_angle)
+{
+    // 加速度 g → Q12（±16g 内不溢出，atan2 中 <<15 仍在 uint32 范围内）
+    return mpu6050_filter_update_q16((mpu6050_dev_t *)sensor,
+                                     (int32_t)(acce_value->acce_x * 4096.0f),
+                                     (int32_t)(acce_value->acce_y * 4096.0f),
+                                     (int32_t)(acce_value->acce_z * 4096.0f),
+                                     (int32_t)(gyro_value->gyro_x * 65536.0f),
+                                     (int32_t)(gyro_value->gyro_y * 65536.0f),
+                                     timestamp_us, complimentary_angle);
+}
+
+esp_err_t mpu6050_complimentory_filter_raw(mpu6050_handle_t sensor, const mpu6050_raw_motion_value_t *const raw_motion,
+                                           int64_t timestamp_us, complimentary_angle_t *const complimentary_angle)
+{
+    mpu6050_dev_t *sens = (mpu6050_dev_t *)sensor;
+
+    // 原始值直接扣除 LSB 零偏，只有角速度需要换算：(raw·256 − 零偏Q8) · (°/s/LSB)Q32 >> 24 = °/s（Q16）
+    const int16_t *acce_bias = sens->acce_bias_lsb;
+    const int32_t rate_x = (int32_t)(((int64_t)(raw_motion->raw_gyro.raw_gyro_x * 256 - sens->gyro_bias_q8[0]) * sens->gyro_lsb_q32) >> 24);
+    const int32_t rate_y = (int32_t)(((int64_t)(raw_motion->raw_gyro.raw_gyro_y * 256 - sens->gyro_bias_q8[1]) * sens->gyro_lsb_q32) >> 24);
+    return mpu6050_filter_update_q16(sens,
+                                     raw_motion->raw_acce.raw_acce_x - acce_bias[0],
+                                     raw_motion->raw_acce.raw_acce_y - acce_bias[1],
+                                     raw_motion->raw_acce.raw_acce_z - acce_bias[2],
+                                     rate_x, rate_y, timestamp_us, complimentary_angle);
+}
+
+#else
+
 esp_err_t mpu6050_complimentory_filter(mpu6050_handle_t sensor, const mpu6050_acce_value_t *const acce_value,
-                                       const mpu6050_gyro_value_t *const gyro_value, complimentary_angle_t *const complimentary_angle)
+                                       const mpu6050_gyro_value_t *const gyro_value, int64_t timestamp_us,
+                                       complimentary_angle_t *const complimentary_angle)
 {
     float acce_angle[2];
     float gyro_angle[2];
     float gyro_rate[2];
     mpu6050_dev_t *sens = (mpu6050_dev_t *)sensor;
 
+    if (sens->counter > 0 && timestamp_us <= sens->last_timestamp_us)
+    {
+        return ESP_ERR_INVALID_ARG; // 同一帧重复滤波会破坏积分
+    }
+
     sens->counter++;
     if (sens->counter == 1)
     {
@@ -493,15 +1264,12 @@ esp_err_t mpu6050_complimentory_filter(mpu6050_handle_t sensor, const mpu6050_ac
         acce_angle[1] = (atan2(acce_value->acce_x, acce_value->acce_z) * RAD_TO_DEG);
         complimentary_angle->roll = acce_angle[0];
         complimentary_angle->pitch = acce_angle[1];
-        gettimeofday(sens->timer, NULL);
+        sens->last_timestamp_us = timestamp_us;
         return ESP_OK;
     }
 
-    struct timeval now, dt_t;
-    gettimeofday(&now, NULL);
-    timersub(&now, sens->timer, &dt_t);
-    sens->dt = (float)(dt_t.tv_sec) + (float)dt_t.tv_usec / 1000000;
-    gettimeofday(sens->timer, NULL);
+    sens->dt = (timestamp_us - sens->last_timestamp_us) * 1e-6f;
+    sens->last_timestamp_us = timestamp_us;
 
     acce_angle[0] = (atan2(acce_value->acce_y, acce_value->acce_z) * RAD_TO_DEG);
     acce_angle[1] = (atan2(acce_value->acce_x, acce_value->acce_z) * RAD_TO_DEG);
@@ -516,3 +1284,20 @@ esp_err_t mpu6050_complimentory_filter(mpu6050_handle_t sensor, const mpu6050_ac
 
     return ESP_OK;
 }
+
+esp_err_t mpu6050_complimentory_filter_raw(mpu6050_handle_t sensor, const mpu6050_raw_motion_value_t *const raw_motion,
+                                           int64_t timestamp_us, complimentary_angle_t *const complimentary_angle)
+{
+    mpu6050_acce_value_t acce;
+    mpu6050_gyro_value_t gyro;
+    mpu6050_temp_value_t temp;
+
+    esp_err_t ret = mpu6050_convert_motion(sensor, raw_motion, &acce, &gyro, &temp);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    return mpu6050_complimentory_filter(sensor, &acce, &gyro, timestamp_us, complimentary_angle);
+}
+
+#endif /* CONFIG_MPU6050_FIXED_POINT_FILTER */
@@ -0,0 +1,283 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "mpu6050_acq.h"
+#include "mpu6050_private.h"
+
+#define MPU6050_ACQ_DEFAULT_STACK 3072
+
+static const char *TAG = "MPU6050_ACQ";
+
+struct mpu6050_acq_t
+{
+    mpu6050_handle_t sensor;
+    mpu6050_acq_config_t config;
+    TaskHandle_t task;
+    SemaphoreHandle_t exited;  // 任务退出时释放
+    portMUX_TYPE isr_lock;     // 保护64位时间戳的读写
+    int64_t isr_timestamp_us;  // ISR 中记录的最近一次 DATA_RDY 时刻
+    volatile bool running;
+    bool idle;                 // 传感器处于 idle，下一次通知来自运动检测中断
+    int64_t still_since_us;    // 本轮静止的起始采样时间，0 表示当前未静止
+    mpu6050_acq_stats_t stats;
+};
+
+static void IRAM_ATTR mpu6050_acq_isr(void *arg)
+{
+    mpu6050_dev_t *s = (mpu6050_dev_t *)arg;
+    struct mpu6050_acq_t *acq = s->acq;
+    BaseType_t woken = pdFALSE;
+
+    portENTER_CRITICAL_ISR(&acq->isr_lock);
+    acq->isr_timestamp_us = esp_timer_get_time();
+    portEXIT_CRITICAL_ISR(&acq->isr_lock);
+
+    vTaskNotifyGiveFromISR(acq->task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void mpu6050_acq_set_idle(struct mpu6050_acq_t *acq, bool idle)
+{
+    acq->idle = idle;
+    acq->still_since_us = 0;
+    if (acq->config.on_idle)
+    {
+        acq->config.on_idle(idle, acq->config.user_ctx);
+    }
+}
+
+// DATA_RDY 已关闭、运动检测尚未开启：丢弃之前挂起的通知，之后的中断只可能是运动检测
+static void mpu6050_acq_drain_notify(void *ctx)
+{
+    ulTaskNotifyTake(pdTRUE, 0);
+}
+
+// 根据本次采样更新静止计时，静止足够久则让传感器进入 idle
+static void mpu6050_acq_check_idle(struct mpu6050_acq_t *acq, const mpu6050_sample_t *sample)
+{
+    const float limit = acq->config.idle_gyro_dps;
+    if (fabsf(sample->gyro.gyro_x) >= limit || fabsf(sample->gyro.gyro_y) >= limit ||
+        fabsf(sample->gyro.gyro_z) >= limit)
+    {
+        acq->still_since_us = 0;
+        return;
+    }
+    if (0 == acq->still_since_us)
+    {
+        acq->still_since_us = sample->timestamp_us;
+        return;
+    }
+    if (sample->timestamp_us - acq->still_since_us < (int64_t)acq->config.idle_after_ms * 1000)
+    {
+        return;
+    }
+
+    // 在开启运动检测中断之前清掉通知，否则紧接着到来的运动中断会被一并丢弃
+    esp_err_t ret = mpu6050_enter_idle_ex(acq->sensor, &acq->config.idle, mpu6050_acq_drain_notify, NULL);
+    if (ESP_OK != ret)
+    {
+        ESP_LOGW(TAG, "enter idle failed: %s", esp_err_to_name(ret));
+        acq->still_since_us = 0;
+        return;
+    }
+    acq->stats.idle_entries++;
+    mpu6050_acq_set_idle(acq, true);
+}
+
+static void mpu6050_acq_task(void *arg)
+{
+    struct mpu6050_acq_t *acq = (struct mpu6050_acq_t *)arg;
+    mpu6050_sample_t sample;
+
+    while (1)
+    {
+        uint32_t pending = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!acq->running)
+        {
+            break;
+        }
+        if (pending > 1)
+        {
+            // 上一次处理太慢，多个中断合并成一次通知，只能读到最新的一帧
+            acq->stats.missed += pending - 1;
+        }
+
+        if (acq->idle)
+        {
+            // 运动检测中断唤醒：恢复全速采样，下一次 DATA_RDY 再开始读数
+            esp_err_t ret = mpu6050_exit_idle(acq->sensor);
+            if (ESP_OK != ret)
+            {
+                ESP_LOGW(TAG, "exit idle failed: %s", esp_err_to_name(ret));
+                continue;
+            }
+            acq->stats.wakeups++;
+            mpu6050_acq_set_idle(acq, false);
+            continue;
+        }
+
+        portENTER_CRITICAL(&acq->isr_lock);
+        sample.timestamp_us = acq->isr_timestamp_us;
+        portEXIT_CRITICAL(&acq->isr_lock);
+
+        if (ESP_OK != mpu6050_get_raw_motion(acq->sensor, &sample.raw))
+        {
+            acq->stats.read_errors++;
+            continue;
+        }
+        mpu6050_convert_motion(acq->sensor, &sample.raw, &sample.acce, &sample.gyro, &sample.temp);
+        acq->stats.samples++;
+
+        if (acq->config.on_sample)
+        {
+            acq->config.on_sample(&sample, acq->config.user_ctx);
+        }
+        if (acq->config.idle_after_ms)
+        {
+            mpu6050_acq_check_idle(acq, &sample);
+        }
+    }
+
+    xSemaphoreGive(acq->exited);
+    vTaskDelete(NULL);
+}
+
+esp_err_t mpu6050_acq_start(mpu6050_handle_t sensor, const mpu6050_acq_config_t *const config,
+                            mpu6050_acq_handle_t *const out)
+{
+    esp_err_t ret;
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+
+    if (NULL == s || NULL == config || NULL == out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (NULL != s->acq)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (config->idle_after_ms && (config->idle_gyro_dps <= 0 || config->idle.wake_freq > MPU6050_LP_WAKE_40HZ))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct mpu6050_acq_t *acq = calloc(1, sizeof(*acq));
+    if (!acq)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    acq->sensor = sensor;
+    acq->config = *config;
+    spinlock_initialize(&acq->isr_lock);
+    acq->exited = xSemaphoreCreateBinary();
+    if (!acq->exited)
+    {
+        free(acq);
+        return ESP_ERR_NO_MEM;
+    }
+
+    ret = mpu6050_config_interrupts(sensor, &config->int_config);
+    if (ESP_OK != ret)
+    {
+        ESP_LOGE(TAG, "config INT pin failed: %s", esp_err_to_name(ret));
+        goto err;
+    }
+
+    // 任务需在 ISR 注册前创建，ISR 中直接向它发通知
+    acq->running = true;
+    uint32_t stack = config->task_stack_size ? config->task_stack_size : MPU6050_ACQ_DEFAULT_STACK;
+    if (pdPASS != xTaskCreatePinnedToCore(mpu6050_acq_task, "mpu6050_acq", stack, acq,
+                                          config->task_priority, &acq->task, config->core_id))
+    {
+        ret = ESP_ERR_NO_MEM;
+        goto err;
+    }
+    s->acq = acq;
+
+    // 已安装时返回 ESP_ERR_INVALID_STATE，可忽略
+    ret = gpio_install_isr_service(0);
+    if (ESP_OK != ret && ESP_ERR_INVALID_STATE != ret)
+    {
+        goto err_task;
+    }
+    ret = mpu6050_register_isr(sensor, mpu6050_acq_isr);
+    if (ESP_OK != ret)
+    {
+        goto err_task;
+    }
+    ret = mpu6050_enable_interrupts(sensor, MPU6050_DATA_RDY_INT_BIT);
+    if (ESP_OK != ret)
+    {
+        gpio_isr_handler_remove(s->int_pin);
+        goto err_task;
+    }
+
+    *out = acq;
+    return ESP_OK;
+
+err_task:
+    acq->running = false;
+    xTaskNotifyGive(acq->task);
+    xSemaphoreTake(acq->exited, portMAX_DELAY);
+    s->acq = NULL;
+err:
+    vSemaphoreDelete(acq->exited);
+    free(acq);
+    return ret;
+}
+
+esp_err_t mpu6050_acq_stop(mpu6050_acq_handle_t acq)
+{
+    if (NULL == acq)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    mpu6050_dev_t *s = (mpu6050_dev_t *)acq->sensor;
+
+    gpio_intr_disable(s->int_pin);
+
+    // 让任务在完成当前采样后退出，避免在 I2C 事务中途删除任务
+    acq->running = false;
+    xTaskNotifyGive(acq->task);
+    xSemaphoreTake(acq->exited, portMAX_DELAY);
+
+    esp_err_t ret = mpu6050_exit_idle(acq->sensor);
+    if (ESP_OK != ret)
+    {
+        ESP_LOGW(TAG, "exit idle failed: %s", esp_err_to_name(ret));
+    }
+    ret = mpu6050_disable_interrupts(acq->sensor, MPU6050_DATA_RDY_INT_BIT);
+    if (ESP_OK != ret)
+    {
+        ESP_LOGW(TAG, "disable DATA_RDY failed: %s", esp_err_to_name(ret));
+    }
+    gpio_isr_handler_remove(s->int_pin);
+
+    s->acq = NULL;
+    vSemaphoreDelete(acq->exited);
+    free(acq);
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_acq_get_stats(mpu6050_acq_handle_t acq, mpu6050_acq_stats_t *const stats)
+{
+    if (NULL == acq || NULL == stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = acq->stats;
+    return ESP_OK;
+}
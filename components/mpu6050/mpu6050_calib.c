@@ -0,0 +1,311 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "mpu6050_calib.h"
+#include "mpu6050_private.h"
+
+/* 偏置寄存器 */
+#define MPU6050_XA_OFFS_H 0x06u
+#define MPU6050_XG_OFFS_USRH 0x13u
+
+#define MPU6050_CALIB_DEFAULT_SAMPLES 256
+#define MPU6050_ACCE_OFFS_LSB_PER_G 2048.0f   /*!< 加速度计偏置寄存器按 ±16g 量程计 */
+#define MPU6050_GYRO_OFFS_LSB_PER_DPS 32.8f   /*!< 陀螺仪偏置寄存器按 ±1000°/s 量程计 */
+
+#define MPU6050_CALIB_MAGIC 0x4D504342u /*!< "MPCB" */
+#define MPU6050_CALIB_VERSION 2u /*!< 2: 增加 acce_factory_trim */
+
+static const char *TAG = "MPU6050_CALIB";
+
+// 持久化格式：头部用于识别数据是否由当前版本写入
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    mpu6050_calib_t calib;
+} mpu6050_calib_blob_t;
+
+// 按大端序写入 3 个连续的 16 位寄存器
+static esp_err_t mpu6050_write_offsets(mpu6050_handle_t sensor, uint8_t reg, const int16_t values[3])
+{
+    uint8_t buf[6];
+    for (int i = 0; i < 3; i++)
+    {
+        buf[2 * i] = (uint8_t)((uint16_t)values[i] >> 8);
+        buf[2 * i + 1] = (uint8_t)values[i];
+    }
+    return mpu6050_write(sensor, reg, buf, sizeof(buf));
+}
+
+// 首次修改加速度计偏置寄存器前读取出厂微调值，恢复和重新标定都以它为基准
+static esp_err_t mpu6050_cache_acce_trim(mpu6050_dev_t *s)
+{
+    if (s->acce_trim_cached)
+    {
+        return ESP_OK;
+    }
+
+    uint8_t buf[6];
+    esp_err_t ret = mpu6050_read(s, MPU6050_XA_OFFS_H, buf, sizeof(buf));
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        s->acce_factory_trim[i] = (int16_t)((buf[2 * i] << 8) + buf[2 * i + 1]);
+    }
+    s->acce_trim_cached = true;
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_set_calibration(mpu6050_handle_t sensor, const mpu6050_calib_t *const calib)
+{
+    esp_err_t ret;
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+
+    if (NULL == s)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (NULL != calib && calib->hw_offsets)
+    {
+        if (!s->acce_trim_cached)
+        {
+            // 热复位后偏置寄存器可能仍是上次写入的值，以标定结果里记录的出厂值为准
+            memcpy(s->acce_factory_trim, calib->acce_factory_trim, sizeof(s->acce_factory_trim));
+            s->acce_trim_cached = true;
+        }
+        ret = mpu6050_write_offsets(sensor, MPU6050_XA_OFFS_H, calib->acce_offset_regs);
+        if (ESP_OK != ret)
+        {
+            return ret;
+        }
+        ret = mpu6050_write_offsets(sensor, MPU6050_XG_OFFS_USRH, calib->gyro_offset_regs);
+        if (ESP_OK != ret)
+        {
+            return ret;
+        }
+    }
+    else
+    {
+        // 不依赖本次上电是否写过硬件偏置：MCU 热复位时传感器不掉电，寄存器里可能还有上次的值。
+        // 陀螺仪偏置寄存器出厂为 0，直接清零；加速度计恢复出厂微调值，
+        // 尚未缓存时以当前寄存器值为准（离线句柄没有寄存器可读，跳过）
+        static const int16_t zero[3] = {0};
+        ret = mpu6050_write_offsets(sensor, MPU6050_XG_OFFS_USRH, zero);
+        if (ESP_OK != ret)
+        {
+            return ret;
+        }
+        if (!s->acce_trim_cached && NULL != s->i2c_dev)
+        {
+            ret = mpu6050_cache_acce_trim(s);
+            if (ESP_OK != ret)
+            {
+                return ret;
+            }
+        }
+        if (s->acce_trim_cached)
+        {
+            ret = mpu6050_write_offsets(sensor, MPU6050_XA_OFFS_H, s->acce_factory_trim);
+            if (ESP_OK != ret)
+            {
+                return ret;
+            }
+        }
+    }
+
+    // 零偏写入硬件时换算路径不再扣除
+    const bool software = (NULL != calib && !calib->hw_offsets);
+    for (int i = 0; i < 3; i++)
+    {
+        s->acce_bias[i] = software ? calib->acce_bias[i] : 0;
+        s->gyro_bias[i] = software ? calib->gyro_bias[i] : 0;
+    }
+    mpu6050_update_fixed_scale(s);
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_get_software_bias(mpu6050_handle_t sensor, float acce_bias[3], float gyro_bias[3])
+{
+    const mpu6050_dev_t *s = (const mpu6050_dev_t *)sensor;
+
+    if (NULL == s || NULL == acce_bias || NULL == gyro_bias)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memcpy(acce_bias, s->acce_bias, sizeof(s->acce_bias));
+    memcpy(gyro_bias, s->gyro_bias, sizeof(s->gyro_bias));
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_calibrate(mpu6050_handle_t sensor, const mpu6050_calib_config_t *const config,
+                            mpu6050_calib_t *const out)
+{
+    static const mpu6050_calib_config_t default_config = {
+        .samples = MPU6050_CALIB_DEFAULT_SAMPLES,
+        .gravity = MPU6050_CALIB_GRAVITY_Z_POS,
+        .max_gyro_spread_dps = 0,
+        .write_hw_offsets = false,
+    };
+    esp_err_t ret;
+    mpu6050_dev_t *s = (mpu6050_dev_t *)sensor;
+    const mpu6050_calib_config_t *cfg = config ? config : &default_config;
+
+    if (NULL == s || cfg->gravity > MPU6050_CALIB_GRAVITY_Y_NEG)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint16_t samples = cfg->samples ? cfg->samples : MPU6050_CALIB_DEFAULT_SAMPLES;
+
+    // 先撤销已生效的零偏，硬件偏置会直接影响原始数据
+    ret = mpu6050_set_calibration(sensor, NULL);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    TickType_t interval = pdMS_TO_TICKS(s->sample_period_us / 1000);
+    if (0 == interval)
+    {
+        interval = 1;
+    }
+    // 刚唤醒时陀螺仪约需 30ms 稳定，偏置寄存器改写后也要等新数据出来
+    vTaskDelay(pdMS_TO_TICKS(50) + interval);
+
+    int32_t acce_sum[3] = {0};
+    int32_t gyro_sum[3] = {0};
+    int16_t gyro_min[3] = {INT16_MAX, INT16_MAX, INT16_MAX};
+    int16_t gyro_max[3] = {INT16_MIN, INT16_MIN, INT16_MIN};
+    mpu6050_raw_motion_value_t raw;
+
+    for (uint16_t n = 0; n < samples; n++)
+    {
+        ret = mpu6050_get_raw_motion(sensor, &raw);
+        if (ESP_OK != ret)
+        {
+            return ret;
+        }
+        const int16_t acce[3] = {raw.raw_acce.raw_acce_x, raw.raw_acce.raw_acce_y, raw.raw_acce.raw_acce_z};
+        const int16_t gyro[3] = {raw.raw_gyro.raw_gyro_x, raw.raw_gyro.raw_gyro_y, raw.raw_gyro.raw_gyro_z};
+        for (int i = 0; i < 3; i++)
+        {
+            acce_sum[i] += acce[i];
+            gyro_sum[i] += gyro[i];
+            gyro_min[i] = gyro[i] < gyro_min[i] ? gyro[i] : gyro_min[i];
+            gyro_max[i] = gyro[i] > gyro_max[i] ? gyro[i] : gyro_max[i];
+        }
+        vTaskDelay(interval);
+    }
+
+    if (cfg->max_gyro_spread_dps > 0)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            if ((gyro_max[i] - gyro_min[i]) * s->gyro_scale > cfg->max_gyro_spread_dps)
+            {
+                ESP_LOGW(TAG, "moved during calibration, axis %d spread %.2f dps", i,
+                         (gyro_max[i] - gyro_min[i]) * s->gyro_scale);
+                return ESP_ERR_INVALID_STATE;
+            }
+        }
+    }
+
+    // 朝上的轴应读到 ±1g，其余轴为 0
+    static const int8_t gravity_axis[] = {2, 2, 0, 0, 1, 1};
+    float gravity_g[3] = {0};
+    gravity_g[gravity_axis[cfg->gravity]] = (cfg->gravity % 2) ? -1.0f : 1.0f;
+
+    mpu6050_calib_t calib = {0};
+    for (int i = 0; i < 3; i++)
+    {
+        calib.acce_bias[i] = (float)acce_sum[i] / samples * s->acce_scale - gravity_g[i];
+        calib.gyro_bias[i] = (float)gyro_sum[i] / samples * s->gyro_scale;
+    }
+
+    if (cfg->write_hw_offsets)
+    {
+        ret = mpu6050_cache_acce_trim(s);
+        if (ESP_OK != ret)
+        {
+            return ret;
+        }
+        calib.hw_offsets = true;
+        memcpy(calib.acce_factory_trim, s->acce_factory_trim, sizeof(calib.acce_factory_trim));
+        for (int i = 0; i < 3; i++)
+        {
+            // 加速度计偏置寄存器 bit0 为温度补偿保留位，必须保持出厂值
+            const int16_t trim = s->acce_factory_trim[i];
+            const int16_t acce_reg = (int16_t)(trim - (int16_t)lroundf(calib.acce_bias[i] * MPU6050_ACCE_OFFS_LSB_PER_G));
+            calib.acce_offset_regs[i] = (int16_t)((acce_reg & ~1) | (trim & 1));
+            calib.gyro_offset_regs[i] = (int16_t)-lroundf(calib.gyro_bias[i] * MPU6050_GYRO_OFFS_LSB_PER_DPS);
+        }
+    }
+
+    ret = mpu6050_set_calibration(sensor, &calib);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    ESP_LOGI(TAG, "gyro bias %.3f %.3f %.3f dps, acce bias %.4f %.4f %.4f g",
+             calib.gyro_bias[0], calib.gyro_bias[1], calib.gyro_bias[2],
+             calib.acce_bias[0], calib.acce_bias[1], calib.acce_bias[2]);
+    if (out)
+    {
+        *out = calib;
+    }
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_calib_load(const mpu6050_calib_store_t *store, const char *key, mpu6050_calib_t *const out)
+{
+    if (NULL == store || NULL == store->load || NULL == key || NULL == out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    mpu6050_calib_blob_t blob;
+    esp_err_t ret = store->load(store->ctx, key, &blob, sizeof(blob));
+    if (ESP_ERR_INVALID_SIZE == ret)
+    {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+    if (MPU6050_CALIB_MAGIC != blob.magic || MPU6050_CALIB_VERSION != blob.version || sizeof(blob) != blob.size)
+    {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    *out = blob.calib;
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_calib_save(const mpu6050_calib_store_t *store, const char *key,
+                             const mpu6050_calib_t *const calib)
+{
+    if (NULL == store || NULL == store->save || NULL == key || NULL == calib)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    mpu6050_calib_blob_t blob;
+    memset(&blob, 0, sizeof(blob)); // 填充字节清零，保证相同内容写出相同数据
+    blob.magic = MPU6050_CALIB_MAGIC;
+    blob.version = MPU6050_CALIB_VERSION;
+    blob.size = sizeof(blob);
+    memcpy(&blob.calib, calib, sizeof(*calib));
+    return store->save(store->ctx, key, &blob, sizeof(blob));
+}
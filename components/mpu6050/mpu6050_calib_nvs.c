@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* 标定结果的 NVS 存储实现，主机测试时不编译本文件，改用内存实现的 mpu6050_calib_store_t */
+
+#include "nvs.h"
+#include "mpu6050_calib.h"
+
+#define MPU6050_CALIB_NVS_NAMESPACE "mpu6050"
+
+static esp_err_t mpu6050_calib_nvs_load(void *ctx, const char *key, void *buf, size_t len)
+{
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(MPU6050_CALIB_NVS_NAMESPACE, NVS_READONLY, &handle);
+    if (ESP_ERR_NVS_NOT_FOUND == ret)
+    {
+        return ESP_ERR_NOT_FOUND; // 命名空间尚未创建
+    }
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    size_t size = len;
+    ret = nvs_get_blob(handle, key, buf, &size);
+    nvs_close(handle);
+    if (ESP_ERR_NVS_NOT_FOUND == ret)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (ESP_ERR_NVS_INVALID_LENGTH == ret || (ESP_OK == ret && size != len))
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ret;
+}
+
+static esp_err_t mpu6050_calib_nvs_save(void *ctx, const char *key, const void *buf, size_t len)
+{
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(MPU6050_CALIB_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (ESP_OK != ret)
+    {
+        return ret;
+    }
+
+    ret = nvs_set_blob(handle, key, buf, len);
+    if (ESP_OK == ret)
+    {
+        ret = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return ret;
+}
+
+static const mpu6050_calib_store_t s_nvs_store = {
+    .load = mpu6050_calib_nvs_load,
+    .save = mpu6050_calib_nvs_save,
+    .ctx = NULL,
+};
+
+const mpu6050_calib_store_t *mpu6050_calib_nvs_store(void)
+{
+    return &s_nvs_store;
+}
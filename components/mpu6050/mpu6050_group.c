@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "mpu6050_group.h"
+
+#define MPU6050_GROUP_DEFAULT_STACK 3072
+
+static const char *TAG = "MPU6050_GROUP";
+
+struct mpu6050_group_t
+{
+    mpu6050_group_config_t config;
+    mpu6050_handle_t sensors[MPU6050_GROUP_MAX_SENSORS];
+    esp_timer_handle_t timer;
+    TaskHandle_t task;
+    SemaphoreHandle_t exited; // 任务退出时释放
+    volatile bool running;
+    mpu6050_group_frame_t frame;
+    mpu6050_group_stats_t stats;
+};
+
+// esp_timer 任务中执行，只负责唤醒采样任务
+static void mpu6050_group_timer_cb(void *arg)
+{
+    struct mpu6050_group_t *group = (struct mpu6050_group_t *)arg;
+    xTaskNotifyGive(group->task);
+}
+
+// 背靠背读取组内所有传感器，时间戳取每次突发读取的起止中点
+static void mpu6050_group_read_slot(struct mpu6050_group_t *group)
+{
+    mpu6050_group_frame_t *frame = &group->frame;
+    int64_t first_us = 0;
+    int64_t last_us = 0;
+
+    frame->valid_mask = 0;
+    frame->slot_us = esp_timer_get_time();
+    for (uint8_t i = 0; i < frame->count; i++)
+    {
+        mpu6050_sample_t *sample = &frame->samples[i];
+        int64_t start_us = esp_timer_get_time();
+        if (ESP_OK != mpu6050_get_raw_motion(group->sensors[i], &sample->raw))
+        {
+            group->stats.read_errors++;
+            continue;
+        }
+        sample->timestamp_us = (start_us + esp_timer_get_time()) / 2;
+        mpu6050_convert_motion(group->sensors[i], &sample->raw, &sample->acce, &sample->gyro, &sample->temp);
+
+        if (0 == frame->valid_mask)
+        {
+            first_us = sample->timestamp_us;
+        }
+        last_us = sample->timestamp_us;
+        frame->valid_mask |= (uint8_t)(1u << i);
+    }
+
+    if ((uint32_t)(last_us - first_us) > group->stats.max_skew_us)
+    {
+        group->stats.max_skew_us = (uint32_t)(last_us - first_us);
+    }
+}
+
+static void mpu6050_group_task(void *arg)
+{
+    struct mpu6050_group_t *group = (struct mpu6050_group_t *)arg;
+
+    while (1)
+    {
+        uint32_t pending = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!group->running)
+        {
+            break;
+        }
+        if (pending > 1)
+        {
+            // 上一时隙处理太慢，多个定时器通知合并成一次
+            group->stats.missed += pending - 1;
+        }
+
+        mpu6050_group_read_slot(group);
+        if (group->config.on_frame)
+        {
+            group->config.on_frame(&group->frame, group->config.user_ctx);
+        }
+        group->frame.sequence++;
+        group->stats.frames++;
+    }
+
+    xSemaphoreGive(group->exited);
+    vTaskDelete(NULL);
+}
+
+esp_err_t mpu6050_group_start(const mpu6050_group_config_t *const config, mpu6050_group_handle_t *const out)
+{
+    esp_err_t ret;
+
+    if (NULL == config || NULL == out || NULL == config->sensors || 0 == config->sensor_count ||
+        config->sensor_count > MPU6050_GROUP_MAX_SENSORS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (uint8_t i = 0; i < config->sensor_count; i++)
+    {
+        if (NULL == config->sensors[i])
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    uint32_t period_us = config->period_us;
+    if (0 == period_us)
+    {
+        ret = mpu6050_get_sample_period(config->sensors[0], &period_us);
+        if (ESP_OK != ret)
+        {
+            return ret;
+        }
+    }
+
+    struct mpu6050_group_t *group = calloc(1, sizeof(*group));
+    if (!group)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    group->config = *config;
+    memcpy(group->sensors, config->sensors, config->sensor_count * sizeof(mpu6050_handle_t));
+    group->config.sensors = group->sensors;
+    group->frame.count = config->sensor_count;
+    group->exited = xSemaphoreCreateBinary();
+    if (!group->exited)
+    {
+        free(group);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // 任务需在定时器启动前创建，定时器回调直接向它发通知
+    group->running = true;
+    uint32_t stack = config->task_stack_size ? config->task_stack_size : MPU6050_GROUP_DEFAULT_STACK;
+    if (pdPASS != xTaskCreatePinnedToCore(mpu6050_group_task, "mpu6050_group", stack, group,
+                                          config->task_priority, &group->task, config->core_id))
+    {
+        ret = ESP_ERR_NO_MEM;
+        goto err;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = mpu6050_group_timer_cb,
+        .arg = group,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "mpu6050_group",
+    };
+    ret = esp_timer_create(&timer_args, &group->timer);
+    if (ESP_OK != ret)
+    {
+        goto err_task;
+    }
+    ret = esp_timer_start_periodic(group->timer, period_us);
+    if (ESP_OK != ret)
+    {
+        esp_timer_delete(group->timer);
+        goto err_task;
+    }
+
+    ESP_LOGI(TAG, "%u sensors, slot %lu us", config->sensor_count, (unsigned long)period_us);
+    *out = group;
+    return ESP_OK;
+
+err_task:
+    group->running = false;
+    xTaskNotifyGive(group->task);
+    xSemaphoreTake(group->exited, portMAX_DELAY);
+err:
+    vSemaphoreDelete(group->exited);
+    free(group);
+    return ret;
+}
+
+esp_err_t mpu6050_group_stop(mpu6050_group_handle_t group)
+{
+    if (NULL == group)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_timer_stop(group->timer);
+    esp_timer_delete(group->timer);
+
+    // 让任务在完成当前时隙后退出，避免在 I2C 事务中途删除任务
+    group->running = false;
+    xTaskNotifyGive(group->task);
+    xSemaphoreTake(group->exited, portMAX_DELAY);
+
+    vSemaphoreDelete(group->exited);
+    free(group);
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_group_get_stats(mpu6050_group_handle_t group, mpu6050_group_stats_t *const stats)
+{
+    if (NULL == group || NULL == stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = group->stats;
+    return ESP_OK;
+}
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief MPU6050 driver internals shared by the component sources (not part of public API)
+ */
+
+#pragma once
+
+#include "driver/i2c_master.h"
+#include "mpu6050.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    struct mpu6050_acq_t;
+
+    /**
+     * @brief 可写配置寄存器的影子副本
+     *
+     * 按寄存器地址分段排列：0x19~0x1C、0x23、0x37~0x38、0x6A~0x6C。
+     * 每次写寄存器成功后同步更新，位操作只需一次写事务，不再先读后写。
+     */
+    typedef struct
+    {
+        uint8_t smplrt_div;   /*!< 0x19 SMPLRT_DIV */
+        uint8_t config;       /*!< 0x1A CONFIG */
+        uint8_t gyro_config;  /*!< 0x1B GYRO_CONFIG */
+        uint8_t accel_config; /*!< 0x1C ACCEL_CONFIG */
+        uint8_t fifo_en;      /*!< 0x23 FIFO_EN */
+        uint8_t int_pin_cfg;  /*!< 0x37 INT_PIN_CFG */
+        uint8_t int_enable;   /*!< 0x38 INT_ENABLE */
+        uint8_t user_ctrl;    /*!< 0x6A USER_CTRL */
+        uint8_t pwr_mgmt_1;   /*!< 0x6B PWR_MGMT_1 */
+        uint8_t pwr_mgmt_2;   /*!< 0x6C PWR_MGMT_2 */
+    } mpu6050_shadow_t;
+
+    typedef struct
+    {
+        i2c_master_dev_handle_t i2c_dev;
+        gpio_num_t int_pin;
+        uint16_t dev_addr;
+        uint32_t counter;
+        mpu6050_acce_fs_t acce_fs; /*!< 当前加速度计量程（缓存，避免每次采样读 ACCEL_CONFIG） */
+        mpu6050_gyro_fs_t gyro_fs; /*!< 当前陀螺仪量程（缓存，避免每次采样读 GYRO_CONFIG） */
+        float acce_scale;          /*!< 1 / 加速度计灵敏度，换算只需一次乘法 */
+        float gyro_scale;          /*!< 1 / 陀螺仪灵敏度 */
+        mpu6050_dlpf_t dlpf;       /*!< 当前 DLPF 档位 */
+        uint32_t sample_period_us; /*!< 当前输出数据周期（微秒），由 SMPLRT_DIV 与 DLPF 决定 */
+        uint8_t fifo_channels;     /*!< 已写入 FIFO_EN 的通道，0 表示 FIFO 未开启 */
+        uint8_t fifo_frame_size;   /*!< 每帧字节数，由 fifo_channels 决定 */
+        mpu6050_shadow_t shadow;   /*!< 配置寄存器影子副本 */
+        bool shadow_valid;         /*!< 影子副本已从器件载入，可代替读操作 */
+        bool shadow_verify;        /*!< 校验模式：位操作前仍从器件读回最新值 */
+        float acce_bias[3];        /*!< 换算时扣除的加速度计零偏（g），未标定或已写入硬件时为 0 */
+        float gyro_bias[3];        /*!< 换算时扣除的陀螺仪零偏（°/s） */
+        int32_t gyro_lsb_q32;      /*!< gyro_scale 的 Q32 定点值（°/s 每 LSB），定点滤波用 */
+        int16_t acce_bias_lsb[3];  /*!< acce_bias 折算为当前量程的 LSB */
+        int32_t gyro_bias_q8[3];   /*!< gyro_bias 折算为当前量程的 LSB（Q8） */
+        int32_t roll_q16;          /*!< 定点互补滤波状态：横滚角（度，Q16） */
+        int32_t pitch_q16;         /*!< 定点互补滤波状态：俯仰角（度，Q16） */
+        bool acce_trim_cached;     /*!< acce_factory_trim 已读取 */
+        int16_t acce_factory_trim[3]; /*!< 加速度计偏置寄存器出厂值，写硬件零偏时以此为基准 */
+        bool idle;                 /*!< 处于 idle（加速度计循环 + 运动检测）模式 */
+        uint8_t idle_saved_int_enable; /*!< 进入 idle 前的 INT_ENABLE，退出时恢复 */
+        struct mpu6050_acq_t *acq; /*!< 中断采集上下文，ISR 通过传感器句柄找到它 */
+        float dt; /*!< delay time between two measurements, dt should be small (ms level) */
+        int64_t last_timestamp_us; /*!< 上一次参与滤波的采样时间戳 */
+    } mpu6050_dev_t;
+
+    /**
+     * @brief 连续写寄存器（地址自增），成功后同步影子副本
+     */
+    esp_err_t mpu6050_write(mpu6050_handle_t sensor, uint8_t reg, const uint8_t *data, uint8_t len);
+
+    /**
+     * @brief 连续读寄存器（地址自增），读到的配置寄存器同步到影子副本
+     */
+    esp_err_t mpu6050_read(mpu6050_handle_t sensor, uint8_t reg, uint8_t *data, size_t len);
+
+    /**
+     * @brief mpu6050_enter_idle()，并在原有中断已关闭、运动检测中断尚未开启时调用 quiesced
+     *
+     * 采集任务在 quiesced 中清掉已挂起的 DATA_RDY 通知；此后到来的通知只可能是运动检测，
+     * 不会被误丢。quiesced 可为 NULL。
+     */
+    esp_err_t mpu6050_enter_idle_ex(mpu6050_handle_t sensor, const mpu6050_idle_config_t *const idle_config,
+                                    void (*quiesced)(void *ctx), void *ctx);
+
+    /**
+     * @brief 量程或零偏改变后，重新计算定点滤波使用的比例因子与 LSB 零偏
+     */
+    void mpu6050_update_fixed_scale(mpu6050_dev_t *s);
+
+#ifdef __cplusplus
+}
+#endif
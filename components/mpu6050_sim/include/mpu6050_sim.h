@@ -0,0 +1,183 @@
+/**
+ * @file
+ * @brief 寄存器级 MPU6050 模拟器，作为主机构建时的 I2C 从机
+ *
+ * 模拟内容：寄存器表（含上电默认值、只读寄存器、DEVICE_RESET）、地址自增的突发读写、
+ * 依赖量程配置的原始数据换算、SMPLRT_DIV/DLPF 决定的采样时钟、1024 字节 FIFO（含溢出）、
+ * DATA_RDY / 运动检测 / FIFO 溢出中断、加速度计循环模式，以及可配置的噪声与零偏。
+ *
+ * 模拟器不自带时间，由测试代码调用 mpu6050_sim_advance() 推进。在 Linux 目标（或仓库根目录的
+ * host_test 工程）中链接 mpu6050_sim_i2c.c 与 mpu6050_sim_gpio.c，驱动的 i2c_master_* 调用会按
+ * 地址路由到已挂接的模拟器，INT 脉冲会调用驱动注册的 GPIO ISR，驱动源码无需改动即可在主机上
+ * 运行并统计每个采样的事务数与字节数。
+ *
+ * 各接口由递归锁保护，采集任务经 I2C 访问的同时测试线程可以推进时间；INT 回调与寄存器写入
+ * 回调在锁内执行。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "mpu6050.h"
+
+#define MPU6050_SIM_MAX_DEVICES 4 /*!< 虚拟总线上最多挂接的模拟器数 */
+
+    typedef struct
+    {
+        uint16_t address;         /*!< 7 位地址，0x68 或 0x69 */
+        float acce_noise_g;       /*!< 加速度白噪声标准差（g） */
+        float gyro_noise_dps;     /*!< 角速度白噪声标准差（°/s） */
+        float acce_bias_g[3];     /*!< 加速度零偏（g） */
+        float gyro_bias_dps[3];   /*!< 角速度零偏（°/s） */
+        float temp_c;             /*!< 芯片温度（°C） */
+        uint32_t seed;            /*!< 噪声随机种子，0 使用默认值 */
+    } mpu6050_sim_config_t;
+
+    typedef struct
+    {
+        uint32_t write_transactions; /*!< 只写事务数 */
+        uint32_t read_transactions;  /*!< 写寄存器地址后读的事务数 */
+        uint32_t bytes_written;      /*!< 主机写入的字节数（含寄存器地址） */
+        uint32_t bytes_read;         /*!< 主机读出的字节数 */
+        uint32_t samples;            /*!< 已生成的采样数 */
+        uint32_t fifo_overflows;     /*!< FIFO 溢出次数 */
+        uint32_t interrupts;         /*!< 触发 INT 的次数 */
+    } mpu6050_sim_stats_t;
+
+    /**
+     * @brief INT 引脚产生脉冲时调用
+     *
+     * @param status 触发时的 INT_STATUS
+     * @param ctx mpu6050_sim_set_int_callback() 传入的 ctx
+     */
+    typedef void (*mpu6050_sim_int_cb_t)(uint8_t status, void *ctx);
+
+    /**
+     * @brief 主机每写入一个寄存器后调用（在模拟器锁内，可再调用模拟器接口）
+     *
+     * 测试用它在驱动寄存器序列的某一步注入事件，例如在开启运动检测中断的瞬间制造运动。
+     *
+     * @param reg register address
+     * @param value value written
+     * @param ctx mpu6050_sim_set_write_callback() 传入的 ctx
+     */
+    typedef void (*mpu6050_sim_write_cb_t)(uint8_t reg, uint8_t value, void *ctx);
+
+    typedef struct mpu6050_sim_t *mpu6050_sim_handle_t;
+
+    /**
+     * @brief 创建模拟器，寄存器为上电默认值（睡眠状态）
+     *
+     * @param config noise, bias and address
+     * @return
+     *     - NULL Fail
+     *     - Others Success
+     */
+    mpu6050_sim_handle_t mpu6050_sim_create(const mpu6050_sim_config_t *const config);
+
+    /**
+     * @brief 释放模拟器（若已挂接到虚拟总线会先摘除）
+     */
+    void mpu6050_sim_delete(mpu6050_sim_handle_t sim);
+
+    /**
+     * @brief 设置真实运动（不含零偏与噪声），从下一个采样起生效
+     *
+     * @param sim simulator handle
+     * @param acce 加速度（g），静止水平放置为 (0, 0, 1)
+     * @param gyro 角速度（°/s）
+     */
+    void mpu6050_sim_set_motion(mpu6050_sim_handle_t sim, const mpu6050_acce_value_t *acce,
+                                const mpu6050_gyro_value_t *gyro);
+
+    /**
+     * @brief 推进模拟时间，期间按采样时钟生成数据、写 FIFO 并触发中断
+     *
+     * @param sim simulator handle
+     * @param us 推进的微秒数
+     */
+    void mpu6050_sim_advance(mpu6050_sim_handle_t sim, uint32_t us);
+
+    /**
+     * @brief 设置 INT 回调，NULL 取消
+     */
+    void mpu6050_sim_set_int_callback(mpu6050_sim_handle_t sim, mpu6050_sim_int_cb_t cb, void *ctx);
+
+    /**
+     * @brief 设置寄存器写入回调，NULL 取消
+     */
+    void mpu6050_sim_set_write_callback(mpu6050_sim_handle_t sim, mpu6050_sim_write_cb_t cb, void *ctx);
+
+    /**
+     * @brief 把 INT 引脚接到主机 GPIO 模拟层的某个引脚，之后每次 INT 脉冲调用该引脚上已使能的 ISR
+     *
+     * 由 mpu6050_sim_gpio.c 提供，会替换 mpu6050_sim_set_int_callback() 设置的回调。
+     *
+     * @param sim simulator handle
+     * @param gpio_num 驱动 mpu6050_config_interrupts() 中配置的引脚，GPIO_NUM_NC 断开
+     */
+    void mpu6050_sim_set_int_gpio(mpu6050_sim_handle_t sim, gpio_num_t gpio_num);
+
+    /**
+     * @brief 一次 I2C 写事务：data[0] 为寄存器地址，其后为写入数据（地址自增）
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG data is NULL or len is 0
+     */
+    esp_err_t mpu6050_sim_write(mpu6050_sim_handle_t sim, const uint8_t *data, size_t len);
+
+    /**
+     * @brief 一次 I2C 写后读事务：写入寄存器地址（及可选数据），再读 read_len 字节
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A buffer is NULL or write_len is 0
+     */
+    esp_err_t mpu6050_sim_write_read(mpu6050_sim_handle_t sim, const uint8_t *write_data, size_t write_len,
+                                     uint8_t *read_data, size_t read_len);
+
+    /**
+     * @brief 直接查看寄存器值，无副作用，不计入统计
+     */
+    uint8_t mpu6050_sim_peek(mpu6050_sim_handle_t sim, uint8_t reg);
+
+    /**
+     * @brief 获取/清零事务统计
+     */
+    void mpu6050_sim_get_stats(mpu6050_sim_handle_t sim, mpu6050_sim_stats_t *const stats);
+    void mpu6050_sim_reset_stats(mpu6050_sim_handle_t sim);
+
+    /**
+     * @brief 挂接到虚拟 I2C 总线，之后对该地址的 i2c_master_* 调用由模拟器应答
+     *
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_STATE Address already in use
+     *     - ESP_ERR_NO_MEM Bus full
+     */
+    esp_err_t mpu6050_sim_attach(mpu6050_sim_handle_t sim);
+
+    /**
+     * @brief 从虚拟总线摘除
+     */
+    void mpu6050_sim_detach(mpu6050_sim_handle_t sim);
+
+    /**
+     * @brief 按地址查找已挂接的模拟器，供 I2C 模拟层使用
+     *
+     * @return NULL if no simulator answers at this address
+     */
+    mpu6050_sim_handle_t mpu6050_sim_find(uint16_t address);
+
+#ifdef __cplusplus
+}
+#endif
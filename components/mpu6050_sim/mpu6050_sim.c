@@ -0,0 +1,557 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "mpu6050_sim.h"
+
+/* MPU6050 register */
+#define SIM_XA_OFFS_H 0x06u
+#define SIM_SMPLRT_DIV 0x19u
+#define SIM_CONFIG 0x1Au
+#define SIM_GYRO_CONFIG 0x1Bu
+#define SIM_ACCEL_CONFIG 0x1Cu
+#define SIM_MOT_THR 0x1Fu
+#define SIM_MOT_DUR 0x20u
+#define SIM_FIFO_EN 0x23u
+#define SIM_INT_PIN_CFG 0x37u
+#define SIM_INT_ENABLE 0x38u
+#define SIM_INT_STATUS 0x3Au
+#define SIM_ACCEL_XOUT_H 0x3Bu
+#define SIM_GYRO_ZOUT_L 0x48u
+#define SIM_USER_CTRL 0x6Au
+#define SIM_PWR_MGMT_1 0x6Bu
+#define SIM_PWR_MGMT_2 0x6Cu
+#define SIM_FIFO_COUNTH 0x72u
+#define SIM_FIFO_COUNTL 0x73u
+#define SIM_FIFO_R_W 0x74u
+#define SIM_WHO_AM_I 0x75u
+
+#define SIM_INT_DATA_RDY 0x01u
+#define SIM_INT_FIFO_OFLOW 0x10u
+#define SIM_INT_MOT 0x40u
+
+#define SIM_FIFO_SIZE 1024u
+#define SIM_REG_COUNT 128u
+
+static const float acce_lsb_per_g[] = {16384, 8192, 4096, 2048};
+static const float gyro_lsb_per_dps[] = {131, 65.5f, 32.8f, 16.4f};
+static const uint32_t lp_wake_hz_x4[] = {5, 20, 80, 160}; // LP_WAKE_CTRL 对应频率 ×4（1.25/5/20/40Hz）
+
+struct mpu6050_sim_t
+{
+    mpu6050_sim_config_t config;
+    uint8_t regs[SIM_REG_COUNT];
+    uint8_t fifo[SIM_FIFO_SIZE];
+    uint16_t fifo_head;  // 最旧字节位置
+    uint16_t fifo_count;
+    mpu6050_acce_value_t acce; // 真实运动
+    mpu6050_gyro_value_t gyro;
+    int16_t last_acce[3];      // 最近一次采样的加速度原始值
+    int16_t mot_ref[3];        // ACCEL_HPF=hold 时锁存的基准
+    uint8_t mot_count;         // 连续超过阈值的采样数
+    uint64_t now_us;
+    uint64_t next_sample_us;
+    uint32_t rng;
+    mpu6050_sim_int_cb_t int_cb;
+    void *int_ctx;
+    mpu6050_sim_write_cb_t write_cb;
+    void *write_ctx;
+    SemaphoreHandle_t lock; // 递归锁：采集任务经 I2C 访问、测试线程推进时间，回调中可再次调用模拟器
+    mpu6050_sim_stats_t stats;
+    bool attached;
+};
+
+static mpu6050_sim_handle_t s_bus[MPU6050_SIM_MAX_DEVICES];
+
+#define SIM_LOCK(sim) xSemaphoreTakeRecursive((sim)->lock, portMAX_DELAY)
+#define SIM_UNLOCK(sim) xSemaphoreGiveRecursive((sim)->lock)
+
+// xorshift32 + Box-Muller，结果只依赖种子，测试可复现
+static float sim_randn(struct mpu6050_sim_t *sim)
+{
+    uint32_t x = sim->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    const float u1 = ((x >> 8) + 1.0f) / 16777217.0f;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    const float u2 = (x >> 8) / 16777216.0f;
+    sim->rng = x;
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * 3.14159265f * u2);
+}
+
+static int16_t sim_saturate(float v)
+{
+    v = roundf(v);
+    return (int16_t)(v > 32767.0f ? 32767 : (v < -32768.0f ? -32768 : v));
+}
+
+static void sim_reset_regs(struct mpu6050_sim_t *sim)
+{
+    memset(sim->regs, 0, sizeof(sim->regs));
+    sim->regs[SIM_PWR_MGMT_1] = 0x40; // 上电睡眠
+    sim->regs[SIM_WHO_AM_I] = 0x68;   // 与 AD0 无关
+    sim->fifo_head = 0;
+    sim->fifo_count = 0;
+    sim->mot_count = 0;
+}
+
+mpu6050_sim_handle_t mpu6050_sim_create(const mpu6050_sim_config_t *const config)
+{
+    if (NULL == config)
+    {
+        return NULL;
+    }
+
+    struct mpu6050_sim_t *sim = calloc(1, sizeof(*sim));
+    if (!sim)
+    {
+        return NULL;
+    }
+    sim->lock = xSemaphoreCreateRecursiveMutex();
+    if (!sim->lock)
+    {
+        free(sim);
+        return NULL;
+    }
+    sim->config = *config;
+    sim->rng = config->seed ? config->seed : 0x12345678u;
+    sim->acce.acce_z = 1.0f;
+    sim_reset_regs(sim);
+    return sim;
+}
+
+void mpu6050_sim_delete(mpu6050_sim_handle_t sim)
+{
+    if (sim)
+    {
+        mpu6050_sim_detach(sim);
+        vSemaphoreDelete(sim->lock);
+        free(sim);
+    }
+}
+
+void mpu6050_sim_set_motion(mpu6050_sim_handle_t sim, const mpu6050_acce_value_t *acce,
+                            const mpu6050_gyro_value_t *gyro)
+{
+    SIM_LOCK(sim);
+    if (acce)
+    {
+        sim->acce = *acce;
+    }
+    if (gyro)
+    {
+        sim->gyro = *gyro;
+    }
+    SIM_UNLOCK(sim);
+}
+
+void mpu6050_sim_set_int_callback(mpu6050_sim_handle_t sim, mpu6050_sim_int_cb_t cb, void *ctx)
+{
+    SIM_LOCK(sim);
+    sim->int_cb = cb;
+    sim->int_ctx = ctx;
+    SIM_UNLOCK(sim);
+}
+
+void mpu6050_sim_set_write_callback(mpu6050_sim_handle_t sim, mpu6050_sim_write_cb_t cb, void *ctx)
+{
+    SIM_LOCK(sim);
+    sim->write_cb = cb;
+    sim->write_ctx = ctx;
+    SIM_UNLOCK(sim);
+}
+
+// 置位中断状态；对应中断使能时产生一次 INT 脉冲
+static void sim_raise(struct mpu6050_sim_t *sim, uint8_t bits)
+{
+    sim->regs[SIM_INT_STATUS] |= bits;
+    if (bits & sim->regs[SIM_INT_ENABLE])
+    {
+        sim->stats.interrupts++;
+        if (sim->int_cb)
+        {
+            sim->int_cb(sim->regs[SIM_INT_STATUS], sim->int_ctx);
+        }
+    }
+}
+
+static void sim_fifo_push(struct mpu6050_sim_t *sim, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (SIM_FIFO_SIZE == sim->fifo_count)
+        {
+            // 满时覆盖最旧的数据
+            sim->fifo_head = (sim->fifo_head + 1) % SIM_FIFO_SIZE;
+            sim->fifo_count--;
+            if (!(sim->regs[SIM_INT_STATUS] & SIM_INT_FIFO_OFLOW))
+            {
+                sim->stats.fifo_overflows++;
+                sim_raise(sim, SIM_INT_FIFO_OFLOW);
+            }
+        }
+        sim->fifo[(sim->fifo_head + sim->fifo_count) % SIM_FIFO_SIZE] = data[i];
+        sim->fifo_count++;
+    }
+}
+
+static uint8_t sim_fifo_pop(struct mpu6050_sim_t *sim)
+{
+    if (0 == sim->fifo_count)
+    {
+        return 0xFF;
+    }
+    uint8_t v = sim->fifo[sim->fifo_head];
+    sim->fifo_head = (sim->fifo_head + 1) % SIM_FIFO_SIZE;
+    sim->fifo_count--;
+    return v;
+}
+
+// 运动检测：高通输出（相对基准或上一采样的变化）任一轴超过 MOT_THR 持续 MOT_DUR 个采样
+static void sim_motion_detect(struct mpu6050_sim_t *sim, const int16_t acce[3])
+{
+    const uint8_t hpf = sim->regs[SIM_ACCEL_CONFIG] & 0x07;
+    const float lsb_per_g = acce_lsb_per_g[(sim->regs[SIM_ACCEL_CONFIG] >> 3) & 0x03];
+    const float threshold = sim->regs[SIM_MOT_THR] * 0.002f * lsb_per_g; // 1 LSB = 2mg
+    bool over = false;
+
+    if (0 != hpf && 0 != sim->regs[SIM_MOT_THR])
+    {
+        const int16_t *ref = (0x07 == hpf) ? sim->mot_ref : sim->last_acce;
+        for (int i = 0; i < 3; i++)
+        {
+            if (fabsf((float)(acce[i] - ref[i])) > threshold)
+            {
+                over = true;
+            }
+        }
+    }
+
+    sim->mot_count = over ? (uint8_t)(sim->mot_count < 255 ? sim->mot_count + 1 : 255) : 0;
+    if (over && sim->mot_count >= (sim->regs[SIM_MOT_DUR] ? sim->regs[SIM_MOT_DUR] : 1))
+    {
+        sim_raise(sim, SIM_INT_MOT);
+    }
+}
+
+static void sim_put_be16(uint8_t *p, int16_t v)
+{
+    p[0] = (uint8_t)((uint16_t)v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+// 生成一个采样：更新数据寄存器、写 FIFO、置位 DATA_RDY
+static void sim_sample(struct mpu6050_sim_t *sim, bool cycle)
+{
+    const uint8_t pwr2 = sim->regs[SIM_PWR_MGMT_2];
+    const float acce_lsb = acce_lsb_per_g[(sim->regs[SIM_ACCEL_CONFIG] >> 3) & 0x03];
+    const float gyro_lsb = gyro_lsb_per_dps[(sim->regs[SIM_GYRO_CONFIG] >> 3) & 0x03];
+    const float acce_true[3] = {sim->acce.acce_x, sim->acce.acce_y, sim->acce.acce_z};
+    const float gyro_true[3] = {sim->gyro.gyro_x, sim->gyro.gyro_y, sim->gyro.gyro_z};
+    int16_t acce[3], gyro[3];
+
+    for (int i = 0; i < 3; i++)
+    {
+        const bool acce_stby = pwr2 & (0x20 >> i);
+        const bool gyro_stby = cycle || (pwr2 & (0x04 >> i));
+        const float a = acce_true[i] + sim->config.acce_bias_g[i] + sim->config.acce_noise_g * sim_randn(sim);
+        const float g = gyro_true[i] + sim->config.gyro_bias_dps[i] + sim->config.gyro_noise_dps * sim_randn(sim);
+        acce[i] = acce_stby ? 0 : sim_saturate(a * acce_lsb);
+        gyro[i] = gyro_stby ? 0 : sim_saturate(g * gyro_lsb);
+    }
+    const bool temp_dis = sim->regs[SIM_PWR_MGMT_1] & 0x08;
+    const int16_t temp = temp_dis ? 0 : sim_saturate((sim->config.temp_c - 36.53f) * 340.0f);
+
+    uint8_t *out = &sim->regs[SIM_ACCEL_XOUT_H];
+    for (int i = 0; i < 3; i++)
+    {
+        sim_put_be16(out + 2 * i, acce[i]);
+        sim_put_be16(out + 8 + 2 * i, gyro[i]);
+    }
+    sim_put_be16(out + 6, temp);
+
+    // FIFO 帧按寄存器地址顺序：ACCEL、TEMP、GYRO_X/Y/Z
+    const uint8_t fifo_en = sim->regs[SIM_FIFO_EN];
+    if ((sim->regs[SIM_USER_CTRL] & 0x40) && fifo_en)
+    {
+        uint8_t frame[14];
+        size_t len = 0;
+        if (fifo_en & 0x08)
+        {
+            memcpy(frame + len, out, 6);
+            len += 6;
+        }
+        if (fifo_en & 0x80)
+        {
+            memcpy(frame + len, out + 6, 2);
+            len += 2;
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            if (fifo_en & (0x40 >> i))
+            {
+                memcpy(frame + len, out + 8 + 2 * i, 2);
+                len += 2;
+            }
+        }
+        sim_fifo_push(sim, frame, len);
+    }
+
+    sim_motion_detect(sim, acce);
+    memcpy(sim->last_acce, acce, sizeof(acce));
+    sim->stats.samples++;
+    sim_raise(sim, SIM_INT_DATA_RDY);
+}
+
+// 当前工作模式下两个采样之间的间隔，睡眠时返回 0
+static uint32_t sim_sample_period_us(const struct mpu6050_sim_t *sim, bool *cycle)
+{
+    const uint8_t pwr1 = sim->regs[SIM_PWR_MGMT_1];
+    *cycle = (pwr1 & 0x20) && !(pwr1 & 0x40);
+    if (*cycle)
+    {
+        return 4000000u / lp_wake_hz_x4[sim->regs[SIM_PWR_MGMT_2] >> 6];
+    }
+    if (pwr1 & 0x40)
+    {
+        return 0;
+    }
+    const uint8_t dlpf = sim->regs[SIM_CONFIG] & 0x07;
+    const uint32_t gyro_rate_hz = (0 == dlpf || 7 == dlpf) ? 8000 : 1000;
+    return (sim->regs[SIM_SMPLRT_DIV] + 1u) * 1000000u / gyro_rate_hz;
+}
+
+void mpu6050_sim_advance(mpu6050_sim_handle_t sim, uint32_t us)
+{
+    SIM_LOCK(sim);
+    const uint64_t end = sim->now_us + us;
+
+    while (true)
+    {
+        bool cycle;
+        const uint32_t period = sim_sample_period_us(sim, &cycle);
+        if (0 == period)
+        {
+            sim->next_sample_us = end; // 睡眠期间时钟不走，唤醒后从当前时刻重新计时
+            break;
+        }
+        if (sim->next_sample_us < sim->now_us)
+        {
+            sim->next_sample_us = sim->now_us + period;
+        }
+        if (sim->next_sample_us > end)
+        {
+            break;
+        }
+        sim->now_us = sim->next_sample_us;
+        sim->next_sample_us += period;
+        sim_sample(sim, cycle);
+    }
+    sim->now_us = end;
+    SIM_UNLOCK(sim);
+}
+
+// 写寄存器的副作用
+static void sim_write_reg(struct mpu6050_sim_t *sim, uint8_t reg, uint8_t value)
+{
+    switch (reg)
+    {
+    case SIM_INT_STATUS:
+    case SIM_FIFO_COUNTH:
+    case SIM_FIFO_COUNTL:
+    case SIM_WHO_AM_I:
+        return; // 只读
+    case SIM_FIFO_R_W:
+        sim_fifo_push(sim, &value, 1);
+        return;
+    case SIM_USER_CTRL:
+        if (value & 0x04)
+        {
+            sim->fifo_head = 0;
+            sim->fifo_count = 0;
+        }
+        sim->regs[reg] = value & (uint8_t)~0x07; // 复位位自动清零
+        return;
+    case SIM_PWR_MGMT_1:
+        if (value & 0x80)
+        {
+            sim_reset_regs(sim);
+            return;
+        }
+        break;
+    case SIM_ACCEL_CONFIG:
+        if (0x07 == (value & 0x07) && 0x07 != (sim->regs[reg] & 0x07))
+        {
+            memcpy(sim->mot_ref, sim->last_acce, sizeof(sim->mot_ref)); // 进入 hold 时锁存基准
+        }
+        break;
+    default:
+        if (reg >= SIM_ACCEL_XOUT_H && reg <= SIM_GYRO_ZOUT_L)
+        {
+            return; // 数据寄存器只读
+        }
+        break;
+    }
+    sim->regs[reg] = value;
+}
+
+// 读寄存器的副作用
+static uint8_t sim_read_reg(struct mpu6050_sim_t *sim, uint8_t reg)
+{
+    switch (reg)
+    {
+    case SIM_FIFO_COUNTH:
+        return (uint8_t)(sim->fifo_count >> 8);
+    case SIM_FIFO_COUNTL:
+        return (uint8_t)sim->fifo_count;
+    case SIM_FIFO_R_W:
+        return sim_fifo_pop(sim);
+    case SIM_INT_STATUS:
+    {
+        uint8_t v = sim->regs[reg];
+        sim->regs[reg] = 0;
+        return v;
+    }
+    default:
+        return sim->regs[reg];
+    }
+}
+
+esp_err_t mpu6050_sim_write(mpu6050_sim_handle_t sim, const uint8_t *data, size_t len)
+{
+    if (NULL == sim || NULL == data || 0 == len)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    SIM_LOCK(sim);
+    sim->stats.write_transactions++;
+    sim->stats.bytes_written += len;
+    uint8_t reg = data[0];
+    for (size_t i = 1; i < len; i++)
+    {
+        sim_write_reg(sim, reg, data[i]);
+        if (sim->write_cb)
+        {
+            sim->write_cb(reg, data[i], sim->write_ctx);
+        }
+        if (SIM_FIFO_R_W != reg)
+        {
+            reg = (reg + 1) % SIM_REG_COUNT;
+        }
+    }
+    SIM_UNLOCK(sim);
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_sim_write_read(mpu6050_sim_handle_t sim, const uint8_t *write_data, size_t write_len,
+                                 uint8_t *read_data, size_t read_len)
+{
+    if (NULL == sim || NULL == write_data || 0 == write_len || (NULL == read_data && read_len))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    SIM_LOCK(sim);
+    sim->stats.read_transactions++;
+    sim->stats.bytes_written += write_len;
+    sim->stats.bytes_read += read_len;
+    uint8_t reg = write_data[0];
+    for (size_t i = 1; i < write_len; i++)
+    {
+        sim_write_reg(sim, reg, write_data[i]);
+        reg = (reg + 1) % SIM_REG_COUNT;
+    }
+
+    for (size_t i = 0; i < read_len; i++)
+    {
+        read_data[i] = sim_read_reg(sim, reg);
+        if (SIM_FIFO_R_W != reg)
+        {
+            reg = (reg + 1) % SIM_REG_COUNT;
+        }
+    }
+    // INT_RD_CLEAR=1 时任意读操作都会清除中断状态；在读完之后清除，读 INT_STATUS 本身仍能看到置位的位
+    if (read_len && (sim->regs[SIM_INT_PIN_CFG] & 0x10))
+    {
+        sim->regs[SIM_INT_STATUS] = 0;
+    }
+    SIM_UNLOCK(sim);
+    return ESP_OK;
+}
+
+uint8_t mpu6050_sim_peek(mpu6050_sim_handle_t sim, uint8_t reg)
+{
+    uint8_t v;
+    SIM_LOCK(sim);
+    if (SIM_FIFO_COUNTH == reg || SIM_FIFO_COUNTL == reg)
+    {
+        v = (SIM_FIFO_COUNTH == reg) ? (uint8_t)(sim->fifo_count >> 8) : (uint8_t)sim->fifo_count;
+    }
+    else
+    {
+        v = sim->regs[reg % SIM_REG_COUNT];
+    }
+    SIM_UNLOCK(sim);
+    return v;
+}
+
+void mpu6050_sim_get_stats(mpu6050_sim_handle_t sim, mpu6050_sim_stats_t *const stats)
+{
+    SIM_LOCK(sim);
+    *stats = sim->stats;
+    SIM_UNLOCK(sim);
+}
+
+void mpu6050_sim_reset_stats(mpu6050_sim_handle_t sim)
+{
+    SIM_LOCK(sim);
+    memset(&sim->stats, 0, sizeof(sim->stats));
+    SIM_UNLOCK(sim);
+}
+
+esp_err_t mpu6050_sim_attach(mpu6050_sim_handle_t sim)
+{
+    if (mpu6050_sim_find(sim->config.address))
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (int i = 0; i < MPU6050_SIM_MAX_DEVICES; i++)
+    {
+        if (NULL == s_bus[i])
+        {
+            s_bus[i] = sim;
+            sim->attached = true;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+void mpu6050_sim_detach(mpu6050_sim_handle_t sim)
+{
+    for (int i = 0; i < MPU6050_SIM_MAX_DEVICES; i++)
+    {
+        if (s_bus[i] == sim)
+        {
+            s_bus[i] = NULL;
+        }
+    }
+    sim->attached = false;
+}
+
+mpu6050_sim_handle_t mpu6050_sim_find(uint16_t address)
+{
+    for (int i = 0; i < MPU6050_SIM_MAX_DEVICES; i++)
+    {
+        if (s_bus[i] && s_bus[i]->config.address == address)
+        {
+            return s_bus[i];
+        }
+    }
+    return NULL;
+}
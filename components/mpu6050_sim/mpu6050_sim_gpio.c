@@ -0,0 +1,113 @@
+/**
+ * 主机构建用的 GPIO 模拟实现：只记录 ISR 注册与使能状态。模拟器通过
+ * mpu6050_sim_set_int_gpio() 接到某个引脚后，每次 INT 脉冲都会调用该引脚上
+ * 已使能的 ISR，驱动的中断采集路径无需改动即可在主机上运行。
+ * 只在 Linux 目标（及 host_test 工程）下编译，与真实的 GPIO 驱动互斥。
+ */
+
+#include "driver/gpio.h"
+#include "mpu6050_sim.h"
+
+typedef struct
+{
+    gpio_isr_t handler;
+    void *arg;
+    bool enabled;
+    uint32_t level;
+} sim_gpio_t;
+
+static sim_gpio_t s_gpio[GPIO_NUM_MAX];
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig)
+{
+    if (NULL == pGPIOConfig || 0 == pGPIOConfig->pin_bit_mask ||
+        0 != (pGPIOConfig->pin_bit_mask >> GPIO_NUM_MAX))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+    if (!GPIO_IS_VALID_GPIO(gpio_num))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_gpio[gpio_num].handler = isr_handler;
+    s_gpio[gpio_num].arg = args;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+    if (!GPIO_IS_VALID_GPIO(gpio_num))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_gpio[gpio_num].handler = NULL;
+    s_gpio[gpio_num].arg = NULL;
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio_num)
+{
+    if (!GPIO_IS_VALID_GPIO(gpio_num))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_gpio[gpio_num].enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t gpio_num)
+{
+    if (!GPIO_IS_VALID_GPIO(gpio_num))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_gpio[gpio_num].enabled = false;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (!GPIO_IS_VALID_GPIO(gpio_num))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_gpio[gpio_num].level = level;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    return GPIO_IS_VALID_GPIO(gpio_num) ? (int)s_gpio[gpio_num].level : 0;
+}
+
+// INT 脉冲：在模拟器推进时间的线程里直接调用 ISR
+static void sim_gpio_int_pulse(uint8_t status, void *ctx)
+{
+    const sim_gpio_t *pin = &s_gpio[(intptr_t)ctx];
+    if (pin->enabled && pin->handler)
+    {
+        pin->handler(pin->arg);
+    }
+}
+
+void mpu6050_sim_set_int_gpio(mpu6050_sim_handle_t sim, gpio_num_t gpio_num)
+{
+    if (GPIO_IS_VALID_GPIO(gpio_num))
+    {
+        mpu6050_sim_set_int_callback(sim, sim_gpio_int_pulse, (void *)(intptr_t)gpio_num);
+    }
+    else
+    {
+        mpu6050_sim_set_int_callback(sim, NULL, NULL);
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * 主机构建用的 i2c_master 模拟实现：设备句柄只记录地址，每次传输按地址转发给已挂接的
+ * MPU6050 模拟器，没有模拟器应答的地址按 NACK 处理。只在 Linux 目标（及 host_test 工程）
+ * 下编译，与真实的 I2C 驱动互斥。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "driver/i2c_master.h"
+#include "mpu6050_sim.h"
+
+struct i2c_master_bus_t
+{
+    i2c_port_num_t port;
+};
+
+struct i2c_master_dev_t
+{
+    uint16_t address;
+};
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *bus_config, i2c_master_bus_handle_t *ret_bus_handle)
+{
+    if (NULL == bus_config || NULL == ret_bus_handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct i2c_master_bus_t *bus = calloc(1, sizeof(*bus));
+    if (!bus)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    bus->port = bus_config->i2c_port;
+    *ret_bus_handle = bus;
+    return ESP_OK;
+}
+
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t bus_handle)
+{
+    if (NULL == bus_handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    free(bus_handle);
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config,
+                                    i2c_master_dev_handle_t *ret_handle)
+{
+    if (NULL == bus_handle || NULL == dev_config || NULL == ret_handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct i2c_master_dev_t *dev = calloc(1, sizeof(*dev));
+    if (!dev)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    dev->address = dev_config->device_address;
+    *ret_handle = dev;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle)
+{
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size,
+                              int xfer_timeout_ms)
+{
+    if (NULL == i2c_dev)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    mpu6050_sim_handle_t sim = mpu6050_sim_find(i2c_dev->address);
+    return sim ? mpu6050_sim_write(sim, write_buffer, write_size) : ESP_FAIL;
+}
+
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer,
+                                      size_t write_size, uint8_t *read_buffer, size_t read_size,
+                                      int xfer_timeout_ms)
+{
+    if (NULL == i2c_dev)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    mpu6050_sim_handle_t sim = mpu6050_sim_find(i2c_dev->address);
+    return sim ? mpu6050_sim_write_read(sim, write_buffer, write_size, read_buffer, read_size) : ESP_FAIL;
+}
+
+esp_err_t i2c_master_multi_buffer_transmit(i2c_master_dev_handle_t i2c_dev,
+                                           i2c_master_transmit_multi_buffer_info_t *buffer_info_array,
+                                           size_t array_size, int xfer_timeout_ms)
+{
+    if (NULL == i2c_dev || NULL == buffer_info_array || 0 == array_size)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    mpu6050_sim_handle_t sim = mpu6050_sim_find(i2c_dev->address);
+    if (NULL == sim)
+    {
+        return ESP_FAIL;
+    }
+
+    // 多个缓冲区在线上是同一个写事务，拼接后整体交给模拟器
+    size_t total = 0;
+    for (size_t i = 0; i < array_size; i++)
+    {
+        total += buffer_info_array[i].buffer_size;
+    }
+    uint8_t *buf = malloc(total ? total : 1);
+    if (!buf)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < array_size; i++)
+    {
+        memcpy(buf + offset, buffer_info_array[i].write_buffer, buffer_info_array[i].buffer_size);
+        offset += buffer_info_array[i].buffer_size;
+    }
+    esp_err_t ret = mpu6050_sim_write(sim, buf, total);
+    free(buf);
+    return ret;
+}
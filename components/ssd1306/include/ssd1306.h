@@ -32,6 +32,20 @@ extern "C"
         const uint8_t *bitmap; // 指向字体位图数据的指针
     } ssd1306_font_t;
 
+    /**
+     * @brief 显示句柄
+     */
+    typedef struct ssd1306_t *ssd1306_handle_t;
+
+    /**
+     * @brief 异步刷新完成回调，在刷新任务中执行
+     *
+     * @param h Display handle.
+     * @param result ESP_OK, or the bus error; failed regions are resent on the next present.
+     * @param user_ctx ssd1306_config_t::user_ctx
+     */
+    typedef void (*ssd1306_flush_cb_t)(ssd1306_handle_t h, esp_err_t result, void *user_ctx);
+
     /**
      * @brief 主配置结构
      */
@@ -46,12 +60,23 @@ extern "C"
         i2c_port_num_t port; // I2C端口号（如I2C_NUM_0）
         gpio_num_t rst_gpio; // 复位引脚（GPIO_NUM_NC表示不使用）
         uint8_t addr;        // 7位I2C地址（0x3C或0x3D）
-    } ssd1306_config_t;
 
-    /**
-     * @brief 显示句柄
-     */
-    typedef struct ssd1306_t *ssd1306_handle_t;
+        bool diff_flush; // 保留上次已发送内容的副本，只发送变化的字节（额外占用 fb_len 字节）
+
+        // I2C 发送方式：false 时每 32 字节拷贝到栈上、加控制字节后单独发送；
+        // true 时控制字节与负载作为两个缓冲区在同一事务中发出，负载不拷贝
+        bool i2c_zero_copy;
+        // zero-copy 模式下单个事务的最大负载字节数，0 表示整段一次发送。
+        // 总线由多个设备共享时，它决定其他设备插队前最长要等多久
+        uint16_t i2c_max_chunk;
+
+        // 异步双缓冲刷新：驱动持有两个帧缓冲区（要求 fb 为 NULL），
+        // ssd1306_present() 交换后由刷新任务发送，调用者可立即绘制下一帧
+        bool async_flush;
+        uint8_t flush_task_priority;     // 刷新任务优先级，0 使用默认值 4
+        ssd1306_flush_cb_t on_flush_done; // 每帧发送完成后调用，可为 NULL
+        void *user_ctx;                  // 透传给 on_flush_done
+    } ssd1306_config_t;
 
     /**
      * @brief Create and initialize a new SSD1306 display on I2C.
@@ -206,10 +231,29 @@ extern "C"
     /**
      * @brief Send the current framebuffer to the display (flush).
      *
+     * With diff_flush enabled, dirty pages are compared against a copy of
+     * what the panel already shows and only the changed byte runs are sent,
+     * so redrawing an unchanged screen from scratch costs no data bytes.
+     *
+     * In async mode this is the same as ssd1306_present().
+     *
      * @param h Display handle.
      * @return ESP_OK on success.
      */
     esp_err_t ssd1306_display(ssd1306_handle_t h);
+
+    /**
+     * @brief Hand the drawn frame to the flush task and return.
+     *
+     * Swaps the back and front buffers and wakes the flush task. The new back
+     * buffer starts as a copy of the presented frame, so drawing can continue
+     * right away. Blocks only while the previous frame is still being sent.
+     * Without async_flush this is a synchronous ssd1306_display().
+     *
+     * @param h Display handle.
+     * @return ESP_OK on success.
+     */
+    esp_err_t ssd1306_present(ssd1306_handle_t h);
 /**
      * @brief 画bitmap图
      * @param h     Display handle.
@@ -220,6 +264,51 @@ extern "C"
      */
     esp_err_t ssd1306_draw_bitmap(ssd1306_handle_t h, int x, int y, const uint8_t *bitmap, int width, int height);
 
+    // ----- Batched drawing -----
+
+    /**
+     * @brief Start a batch of drawing calls.
+     *
+     * Takes the display mutex once and checks the handle is initialized.
+     * Between begin and end, draw with the *_nolock variants below; the
+     * locked functions (including ssd1306_display/present) would deadlock.
+     * Must be paired with ssd1306_end_frame() from the same task.
+     *
+     * @param h Display handle.
+     * @return ESP_OK with the mutex held, ESP_ERR_INVALID_STATE otherwise.
+     */
+    esp_err_t ssd1306_begin_frame(ssd1306_handle_t h);
+
+    /**
+     * @brief End a batch started by ssd1306_begin_frame() and release the mutex.
+     *
+     * @param h Display handle.
+     * @return ESP_OK on success.
+     */
+    esp_err_t ssd1306_end_frame(ssd1306_handle_t h);
+
+    // 以下函数与同名加锁版本参数、行为一致，但不加锁也不检查初始化，
+    // 只能在 ssd1306_begin_frame() / ssd1306_end_frame() 之间调用
+    esp_err_t ssd1306_clear_nolock(ssd1306_handle_t h);
+    esp_err_t ssd1306_draw_pixel_nolock(ssd1306_handle_t h, int x, int y, bool on);
+    esp_err_t ssd1306_draw_rect_nolock(ssd1306_handle_t h, int x, int y, int w, int hgt,
+                                       bool fill);
+    esp_err_t ssd1306_draw_line_nolock(ssd1306_handle_t h, int x0, int y0, int x1, int y1,
+                                       bool on);
+    esp_err_t ssd1306_draw_circle_nolock(ssd1306_handle_t h, int xc, int yc, int r,
+                                         bool fill);
+    esp_err_t ssd1306_draw_text_nolock(ssd1306_handle_t h, int x, int y, const char *text,
+                                       bool on);
+    esp_err_t ssd1306_draw_text_scaled_nolock(ssd1306_handle_t h, int x, int y,
+                                              const char *text, bool on, int scale);
+    esp_err_t ssd1306_draw_text_wrapped_nolock(ssd1306_handle_t h, int x, int y, int w,
+                                               int hgt, const char *text, bool on);
+    esp_err_t ssd1306_draw_text_wrapped_scaled_nolock(ssd1306_handle_t h, int x, int y,
+                                                      int w, int hgt, const char *text,
+                                                      bool on, int scale);
+    esp_err_t ssd1306_draw_bitmap_nolock(ssd1306_handle_t h, int x, int y, const uint8_t *bitmap,
+                                         int width, int height);
+
 #ifdef __cplusplus
 }
 #endif
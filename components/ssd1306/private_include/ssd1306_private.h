@@ -12,6 +12,7 @@
 #include <esp_err.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include <freertos/task.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -21,6 +22,10 @@ extern "C"
 {
 #endif
 
+#define SSD1306_MAX_WIDTH 128                         // 控制器最大列数
+#define SSD1306_MAX_PAGES 8                           // 控制器最大页数（64 行）
+#define SSD1306_DIRTY_WORDS (SSD1306_MAX_WIDTH / 32)  // 每页脏列位图的字数
+
     // Vtable struct
     typedef struct
     {
@@ -47,9 +52,23 @@ extern "C"
         uint16_t width;  // 显示宽度
         uint16_t height; // 显示高度
 
-        // 脏矩形跟踪（用于局部刷新优化）
-        uint16_t dx0, dy0, dx1, dy1; // 脏矩形边界
-        bool dirty;                  // 脏标志（是否需要刷新）
+        // 脏区跟踪（用于局部刷新优化）：每页一个列位图，第 x 位对应第 x 列
+        uint32_t dirty_cols[SSD1306_MAX_PAGES][SSD1306_DIRTY_WORDS];
+        bool dirty; // 脏标志（是否需要刷新）
+
+        // 差分刷新：shadow 为面板当前内容的副本，首次刷新前无效
+        uint8_t *shadow;
+        bool shadow_valid;
+
+        // 异步刷新：fb 为后台缓冲区（绘制目标），front 为刷新任务发送中的前台缓冲区
+        uint8_t *front;
+        uint32_t front_dirty[SSD1306_MAX_PAGES][SSD1306_DIRTY_WORDS];
+        TaskHandle_t flush_task;        // NULL 表示同步模式
+        SemaphoreHandle_t flush_idle;   // 刷新任务空闲（前台缓冲区可交换）时可获取
+        SemaphoreHandle_t flush_exited; // 刷新任务退出时释放
+        volatile bool flush_running;
+        ssd1306_flush_cb_t on_flush_done;
+        void *user_ctx;
 
         // 资源管理标志
         bool driver_owns_fb; // 驱动是否拥有帧缓冲区
@@ -58,7 +77,7 @@ extern "C"
 
     // I2C functions
     esp_err_t ssd1306_bind_i2c(i2c_master_bus_handle_t bus, struct ssd1306_t *d, i2c_port_num_t port,
-                               uint8_t addr, gpio_num_t rst_gpio);
+                               uint8_t addr, gpio_num_t rst_gpio, bool zero_copy, uint16_t max_chunk);
     esp_err_t ssd1306_unbind_i2c(struct ssd1306_t *d);
 
 #ifdef __cplusplus
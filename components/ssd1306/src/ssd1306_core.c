@@ -17,9 +17,18 @@
 #define FB_LEN(w, h) ((size_t)(((w) * (h)) / 8))
 #define SSD1306_TEXT_HSPC 1
 #define SSD1306_TEXT_VSPC 2
+// 新开一个窗口的线上开销（字节）：COLUMNADDR/PAGEADDR 6 字节命令，加上命令与数据
+// 两次事务各自的控制字节和地址字节。同一页两段之间的间隔不超过该值时合并发送更省
+#define SSD1306_WINDOW_COST (6 + 2 + 2)
+#define SSD1306_FLUSH_TASK_STACK 3072
+#define SSD1306_FLUSH_TASK_PRIO 4
 
 static const char *TAG = "SSD1306";
 
+// Forward declarations
+static esp_err_t start_async(struct ssd1306_t *d, const ssd1306_config_t *cfg);
+static void stop_async(struct ssd1306_t *d);
+
 // ----- Helper functions -----
 // Get framebuffer index
 static inline size_t fb_index(const struct ssd1306_t *d, int x, int page)
@@ -46,31 +55,99 @@ static esp_err_t set_window(struct ssd1306_t *d, uint8_t x0, uint8_t x1,
 static inline void dirty_reset(struct ssd1306_t *d)
 {
     d->dirty = false;
-    d->dx0 = d->dy0 = INT16_MAX;
-    d->dx1 = d->dy1 = -1;
+    memset(d->dirty_cols, 0, sizeof(d->dirty_cols));
 }
 
-// Mark bounding box as dirty
+// Mark bounding box as dirty: set columns [x0..x1] in every page that
+// rows [y0..y1] touch. Coordinates are clipped to the panel.
 static inline void mark_dirty(struct ssd1306_t *d, int x0, int y0, int x1,
                               int y1)
 {
-    if (!d->dirty)
-    {
-        d->dirty = true;
-        d->dx0 = x0;
-        d->dy0 = y0;
-        d->dx1 = x1;
-        d->dy1 = y1;
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x1 >= (int)d->width)
+        x1 = (int)d->width - 1;
+    if (y1 >= (int)d->height)
+        y1 = (int)d->height - 1;
+    if (x0 > x1 || y0 > y1)
         return;
+
+    // 按字生成 [x0..x1] 的掩码，每页最多 4 个字
+    uint32_t mask[SSD1306_DIRTY_WORDS];
+    for (int w = 0; w < SSD1306_DIRTY_WORDS; ++w)
+    {
+        const int lo = w * 32, hi = lo + 31;
+        if (x1 < lo || x0 > hi)
+        {
+            mask[w] = 0;
+            continue;
+        }
+        const int b0 = (x0 > lo) ? x0 - lo : 0;
+        const int b1 = (x1 < hi) ? x1 - lo : 31;
+        mask[w] = (0xFFFFFFFFu >> (31 - b1)) & (0xFFFFFFFFu << b0);
+    }
+    for (int page = y0 >> 3; page <= (y1 >> 3); ++page)
+    {
+        for (int w = 0; w < SSD1306_DIRTY_WORDS; ++w)
+            d->dirty_cols[page][w] |= mask[w];
     }
-    if (x0 < d->dx0)
-        d->dx0 = x0;
-    if (y0 < d->dy0)
-        d->dy0 = y0;
-    if (x1 > d->dx1)
-        d->dx1 = x1;
-    if (y1 > d->dy1)
-        d->dy1 = y1;
+    d->dirty = true;
+}
+
+// Find the next dirty column at or after x in one page's bitmap; -1 if none.
+static int dirty_next_set(const struct ssd1306_t *d, const uint32_t *cols, int x)
+{
+    while (x < (int)d->width)
+    {
+        const uint32_t bits = cols[x >> 5] >> (x & 31);
+        if (bits)
+        {
+            x += __builtin_ctz(bits);
+            return x < (int)d->width ? x : -1;
+        }
+        x = (x | 31) + 1;
+    }
+    return -1;
+}
+
+// Find the next clean column at or after x in one page's bitmap; width if none.
+static int dirty_next_clear(const struct ssd1306_t *d, const uint32_t *cols, int x)
+{
+    while (x < (int)d->width)
+    {
+        const uint32_t bits = ~cols[x >> 5] >> (x & 31);
+        if (bits)
+        {
+            x += __builtin_ctz(bits);
+            return x < (int)d->width ? x : (int)d->width;
+        }
+        x = (x | 31) + 1;
+    }
+    return (int)d->width;
+}
+
+// Next span [*x0..*x1] of dirty columns starting at or after x, with short
+// clean gaps merged in. Returns false when the rest of the page is clean.
+static bool dirty_next_span(const struct ssd1306_t *d, const uint32_t *cols, int x,
+                            int *x0, int *x1)
+{
+    int start = dirty_next_set(d, cols, x);
+    if (start < 0)
+        return false;
+
+    int end = dirty_next_clear(d, cols, start);
+    while (end < (int)d->width)
+    {
+        const int next = dirty_next_set(d, cols, end);
+        if (next < 0 || next - end > SSD1306_WINDOW_COST)
+            break;
+        end = dirty_next_clear(d, cols, next);
+    }
+    *x0 = start;
+    *x1 = end - 1;
+    return true;
 }
 
 // Draw a pixel directly into framebuffer (no checks)
@@ -165,7 +242,11 @@ static inline void draw_glyph_scaled_nolock(struct ssd1306_t *d,
     }
 }
 
-esp_err_t ssd1306_clear(ssd1306_handle_t h)
+// ----- Frame batching -----
+// Every locked primitive is begin_frame + its _nolock body + end_frame;
+// callers drawing many primitives per frame hold the frame themselves.
+
+esp_err_t ssd1306_begin_frame(ssd1306_handle_t h)
 {
     struct ssd1306_t *d = h;
     if (!d)
@@ -177,13 +258,40 @@ esp_err_t ssd1306_clear(ssd1306_handle_t h)
         UNLOCK(d);
         return ESP_ERR_INVALID_STATE;
     }
-    memset(d->fb, 0, d->fb_len);
-    mark_dirty(d, 0, 0, d->width - 1, d->height - 1);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_end_frame(ssd1306_handle_t h)
+{
+    struct ssd1306_t *d = h;
+    if (!d)
+        return ESP_ERR_INVALID_STATE;
 
     UNLOCK(d);
     return ESP_OK;
 }
 
+esp_err_t ssd1306_clear_nolock(ssd1306_handle_t h)
+{
+    struct ssd1306_t *d = h;
+    if (!d)
+        return ESP_ERR_INVALID_STATE;
+
+    memset(d->fb, 0, d->fb_len);
+    mark_dirty(d, 0, 0, d->width - 1, d->height - 1);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_clear(ssd1306_handle_t h)
+{
+    esp_err_t err = ssd1306_begin_frame(h);
+    if (err != ESP_OK)
+        return err;
+    err = ssd1306_clear_nolock(h);
+    ssd1306_end_frame(h);
+    return err;
+}
+
 // Send initialization sequence
 static esp_err_t run_init_sequence(struct ssd1306_t *d)
 {
@@ -232,8 +340,13 @@ static esp_err_t validate_cfg(const ssd1306_config_t *cfg)
         return ESP_ERR_INVALID_ARG;
     if (!cfg->width || !cfg->height)
         return ESP_ERR_INVALID_ARG;
+    if (cfg->width > SSD1306_MAX_WIDTH || cfg->height > SSD1306_MAX_PAGES * 8 ||
+        (cfg->height & 7))
+        return ESP_ERR_INVALID_ARG;
     if (cfg->fb && cfg->fb_len != FB_LEN(cfg->width, cfg->height))
         return ESP_ERR_INVALID_SIZE;
+    if (cfg->fb && cfg->async_flush)
+        return ESP_ERR_INVALID_ARG; // 双缓冲需由驱动分配
     return ESP_OK;
 }
 
@@ -259,11 +372,24 @@ static esp_err_t new_common(const ssd1306_config_t *cfg, ssd1306_handle_t *out,
     }
     d->driver_owns_fb = (cfg->fb == NULL);
 
+    if (cfg->diff_flush)
+    {
+        d->shadow = malloc(d->fb_len);
+        if (!d->shadow)
+        {
+            if (d->driver_owns_fb)
+                free(d->fb);
+            free(d);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
     d->lock = xSemaphoreCreateMutex();
     if (!d->lock)
     {
         if (d->driver_owns_fb)
             free(d->fb);
+        free(d->shadow);
         free(d);
         return ESP_ERR_NO_MEM;
     }
@@ -285,11 +411,15 @@ esp_err_t ssd1306_connect_i2c(i2c_master_bus_handle_t bus_handle, const ssd1306_
     ESP_RETURN_ON_ERROR(ssd1306_bind_i2c(bus_handle, d,
                                          cfg->port,
                                          cfg->addr,
-                                         cfg->rst_gpio),
+                                         cfg->rst_gpio,
+                                         cfg->i2c_zero_copy,
+                                         cfg->i2c_max_chunk),
                         TAG, "bind i2c");
     if (d->vt->reset)
         ESP_RETURN_ON_ERROR(d->vt->reset(d->bus_ctx), TAG, "reset");
     ESP_RETURN_ON_ERROR(run_init_sequence(d), TAG, "init seq");
+    if (cfg->async_flush)
+        ESP_RETURN_ON_ERROR(start_async(d, cfg), TAG, "async flush");
 
     d->initialized = true;
     return ESP_OK;
@@ -317,6 +447,8 @@ esp_err_t ssd1306_del(ssd1306_handle_t h)
     if (!d)
         return ESP_ERR_INVALID_ARG;
 
+    stop_async(d);
+
     LOCK(d);
     d->initialized = false;
 
@@ -324,6 +456,7 @@ esp_err_t ssd1306_del(ssd1306_handle_t h)
 
     if (d->driver_owns_fb && d->fb)
         free(d->fb);
+    free(d->shadow);
 
     UNLOCK(d);
     vSemaphoreDelete(d->lock);
@@ -334,7 +467,7 @@ esp_err_t ssd1306_del(ssd1306_handle_t h)
 
 // ----- Drawing API -----
 
-esp_err_t ssd1306_draw_pixel(ssd1306_handle_t h, int x, int y, bool on)
+esp_err_t ssd1306_draw_pixel_nolock(ssd1306_handle_t h, int x, int y, bool on)
 {
     struct ssd1306_t *d = h;
     if (!d)
@@ -342,21 +475,24 @@ esp_err_t ssd1306_draw_pixel(ssd1306_handle_t h, int x, int y, bool on)
     if ((unsigned)x >= d->width || (unsigned)y >= d->height)
         return ESP_ERR_INVALID_ARG;
 
-    LOCK(d);
-    if (!d->initialized)
-    {
-        UNLOCK(d);
-        return ESP_ERR_INVALID_STATE;
-    }
     draw_pixel_fast(d, x, y, on);
     mark_dirty(d, x, y, x, y);
-    UNLOCK(d);
 
     return ESP_OK;
 }
 
-esp_err_t ssd1306_draw_rect(ssd1306_handle_t h, int x, int y, int w, int hgt,
-                            bool fill)
+esp_err_t ssd1306_draw_pixel(ssd1306_handle_t h, int x, int y, bool on)
+{
+    esp_err_t err = ssd1306_begin_frame(h);
+    if (err != ESP_OK)
+        return err;
+    err = ssd1306_draw_pixel_nolock(h, x, y, on);
+    ssd1306_end_frame(h);
+    return err;
+}
+
+esp_err_t ssd1306_draw_rect_nolock(ssd1306_handle_t h, int x, int y, int w, int hgt,
+                                   bool fill)
 {
     struct ssd1306_t *d = h;
     if (!d)
@@ -377,13 +513,6 @@ esp_err_t ssd1306_draw_rect(ssd1306_handle_t h, int x, int y, int w, int hgt,
     if (y1 >= (int)d->height)
         y1 = (int)d->height - 1;
 
-    LOCK(d);
-    if (!d->initialized)
-    {
-        UNLOCK(d);
-        return ESP_ERR_INVALID_STATE;
-    }
-
     if (!fill)
     {
         // top/bottom horizontal edges
@@ -399,7 +528,6 @@ esp_err_t ssd1306_draw_rect(ssd1306_handle_t h, int x, int y, int w, int hgt,
             draw_pixel_fast(d, x1, yy, true);
         }
         mark_dirty(d, x0, y0, x1, y1);
-        UNLOCK(d);
         return ESP_OK;
     }
 
@@ -442,12 +570,22 @@ esp_err_t ssd1306_draw_rect(ssd1306_handle_t h, int x, int y, int w, int hgt,
     }
 
     mark_dirty(d, x0, y0, x1, y1);
-    UNLOCK(d);
     return ESP_OK;
 }
 
-esp_err_t ssd1306_draw_line(ssd1306_handle_t h, int x0, int y0, int x1, int y1,
-                            bool on)
+esp_err_t ssd1306_draw_rect(ssd1306_handle_t h, int x, int y, int w, int hgt,
+                            bool fill)
+{
+    esp_err_t err = ssd1306_begin_frame(h);
+    if (err != ESP_OK)
+        return err;
+    err = ssd1306_draw_rect_nolock(h, x, y, w, hgt, fill);
+    ssd1306_end_frame(h);
+    return err;
+}
+
+esp_err_t ssd1306_draw_line_nolock(ssd1306_handle_t h, int x0, int y0, int x1, int y1,
+                                   bool on)
 {
     struct ssd1306_t *d = h;
     if (!d)
@@ -473,13 +611,6 @@ esp_err_t ssd1306_draw_line(ssd1306_handle_t h, int x0, int y0, int x1, int y1,
     int sy = (y0 < y1) ? 1 : -1;
     int err = dx - dy;
 
-    LOCK(d);
-    if (!d->initialized)
-    {
-        UNLOCK(d);
-        return ESP_ERR_INVALID_STATE;
-    }
-
     while (1)
     {
         draw_pixel_fast(d, x0, y0, on);
@@ -501,12 +632,22 @@ esp_err_t ssd1306_draw_line(ssd1306_handle_t h, int x0, int y0, int x1, int y1,
     }
 
     mark_dirty(d, bx0, by0, bx1, by1);
-    UNLOCK(d);
     return ESP_OK;
 }
 
-esp_err_t ssd1306_draw_circle(ssd1306_handle_t h, int xc, int yc, int r,
-                              bool fill)
+esp_err_t ssd1306_draw_line(ssd1306_handle_t h, int x0, int y0, int x1, int y1,
+                            bool on)
+{
+    esp_err_t err = ssd1306_begin_frame(h);
+    if (err != ESP_OK)
+        return err;
+    err = ssd1306_draw_line_nolock(h, x0, y0, x1, y1, on);
+    ssd1306_end_frame(h);
+    return err;
+}
+
+esp_err_t ssd1306_draw_circle_nolock(ssd1306_handle_t h, int xc, int yc, int r,
+                                     bool fill)
 {
     struct ssd1306_t *d = h;
     if (!d)
@@ -517,7 +658,7 @@ esp_err_t ssd1306_draw_circle(ssd1306_handle_t h, int xc, int yc, int r,
     // Degenerate radius
     if (r == 0)
     {
-        return ssd1306_draw_pixel(h, xc, yc, true);
+        return ssd1306_draw_pixel_nolock(h, xc, yc, true);
     }
 
     // Precompute bbox for dirty marking
@@ -526,13 +667,6 @@ esp_err_t ssd1306_draw_circle(ssd1306_handle_t h, int xc, int yc, int r,
     int bx1 = xc + r;
     int by1 = yc + r;
 
-    LOCK(d);
-    if (!d->initialized)
-    {
-        UNLOCK(d);
-        return ESP_ERR_INVALID_STATE;
-    }
-
     // Midpoint circle algorithm
     int x = r;
     int y = 0;
@@ -590,19 +724,34 @@ esp_err_t ssd1306_draw_circle(ssd1306_handle_t h, int xc, int yc, int r,
 
     // One bbox mark is sufficient
     mark_dirty(d, bx0, by0, bx1, by1);
-
-    UNLOCK(d);
     return ESP_OK;
 }
 
+esp_err_t ssd1306_draw_circle(ssd1306_handle_t h, int xc, int yc, int r,
+                              bool fill)
+{
+    esp_err_t err = ssd1306_begin_frame(h);
+    if (err != ESP_OK)
+        return err;
+    err = ssd1306_draw_circle_nolock(h, xc, yc, r, fill);
+    ssd1306_end_frame(h);
+    return err;
+}
+
+esp_err_t ssd1306_draw_text_nolock(ssd1306_handle_t h, int x, int y, const char *text,
+                                   bool on)
+{
+    return ssd1306_draw_text_scaled_nolock(h, x, y, text, on, 1);
+}
+
 esp_err_t ssd1306_draw_text(ssd1306_handle_t h, int x, int y, const char *text,
                             bool on)
 {
     return ssd1306_draw_text_scaled(h, x, y, text, on, 1);
 }
 
-esp_err_t ssd1306_draw_text_scaled(ssd1306_handle_t h, int x, int y,
-                                   const char *text, bool on, int scale)
+esp_err_t ssd1306_draw_text_scaled_nolock(ssd1306_handle_t h, int x, int y,
+                                          const char *text, bool on, int scale)
 {
     struct ssd1306_t *d = h;
     if (!d || !text)
@@ -610,17 +759,8 @@ esp_err_t ssd1306_draw_text_scaled(ssd1306_handle_t h, int x, int y,
     if (scale < 1)
         scale = 1;
 
-    LOCK(d);
-    if (!d->initialized)
-    {
-        UNLOCK(d);
-        return ESP_ERR_INVALID_STATE;
-    }
     if (!d->font)
-    {
-        UNLOCK(d);
         return ESP_ERR_INVALID_STATE;
-    }
 
     const ssd1306_font_t *f = d->font;
     const int gw = (int)f->width;
@@ -690,20 +830,35 @@ esp_err_t ssd1306_draw_text_scaled(ssd1306_handle_t h, int x, int y,
 
     if (bx1 >= bx0 && by1 >= by0)
         mark_dirty(d, bx0, by0, bx1, by1);
-
-    UNLOCK(d);
     return ESP_OK;
 }
 
+esp_err_t ssd1306_draw_text_scaled(ssd1306_handle_t h, int x, int y,
+                                   const char *text, bool on, int scale)
+{
+    esp_err_t err = ssd1306_begin_frame(h);
+    if (err != ESP_OK)
+        return err;
+    err = ssd1306_draw_text_scaled_nolock(h, x, y, text, on, scale);
+    ssd1306_end_frame(h);
+    return err;
+}
+
+esp_err_t ssd1306_draw_text_wrapped_nolock(ssd1306_handle_t h, int x, int y, int w,
+                                           int hgt, const char *text, bool on)
+{
+    return ssd1306_draw_text_wrapped_scaled_nolock(h, x, y, w, hgt, text, on, 1);
+}
+
 esp_err_t ssd1306_draw_text_wrapped(ssd1306_handle_t h, int x, int y, int w,
                                     int hgt, const char *text, bool on)
 {
     return ssd1306_draw_text_wrapped_scaled(h, x, y, w, hgt, text, on, 1);
 }
 
-esp_err_t ssd1306_draw_text_wrapped_scaled(ssd1306_handle_t h, int x, int y,
-                                           int w, int hgt, const char *text,
-                                           bool on, int scale)
+esp_err_t ssd1306_draw_text_wrapped_scaled_nolock(ssd1306_handle_t h, int x, int y,
+                                                  int w, int hgt, const char *text,
+                                                  bool on, int scale)
 {
     struct ssd1306_t *d = (struct ssd1306_t *)h;
     if (!d || !text)
@@ -711,12 +866,8 @@ esp_err_t ssd1306_draw_text_wrapped_scaled(ssd1306_handle_t h, int x, int y,
     if (w <= 0 || hgt <= 0 || scale < 1)
         return ESP_ERR_INVALID_ARG;
 
-    LOCK(d);
-    if (!d->initialized || !d->font)
-    {
-        UNLOCK(d);
+    if (!d->font)
         return ESP_ERR_INVALID_STATE;
-    }
 
     const ssd1306_font_t *f = d->font;
     const int gw = (int)f->width * scale;
@@ -928,22 +1079,162 @@ esp_err_t ssd1306_draw_text_wrapped_scaled(ssd1306_handle_t h, int x, int y,
 
     if (touched)
         mark_dirty(d, bx0, by0, bx1, by1);
-    UNLOCK(d);
     return ESP_OK;
 }
 
-esp_err_t ssd1306_display(ssd1306_handle_t h)
+esp_err_t ssd1306_draw_text_wrapped_scaled(ssd1306_handle_t h, int x, int y,
+                                           int w, int hgt, const char *text,
+                                           bool on, int scale)
 {
-    struct ssd1306_t *d = h;
-    if (!d)
-        return ESP_ERR_INVALID_STATE;
+    esp_err_t err = ssd1306_begin_frame(h);
+    if (err != ESP_OK)
+        return err;
+    err = ssd1306_draw_text_wrapped_scaled_nolock(h, x, y, w, hgt, text, on, scale);
+    ssd1306_end_frame(h);
+    return err;
+}
 
-    LOCK(d);
-    if (!d->initialized)
+// Send every dirty span of fb. Consecutive pages with the same single span
+// share one window (GDDRAM auto-advances to the next page), so a full-screen
+// clear still costs a single set_window.
+static esp_err_t flush_dirty_spans(struct ssd1306_t *d, const uint8_t *fb,
+                                   const uint32_t (*dirty)[SSD1306_DIRTY_WORDS])
+{
+    const int pages = d->height >> 3;
+    esp_err_t err = ESP_OK;
+
+    for (int p = 0; p < pages && err == ESP_OK;)
     {
-        UNLOCK(d);
-        return ESP_ERR_INVALID_STATE;
+        int x0, x1, nx0, nx1;
+        if (!dirty_next_span(d, dirty[p], 0, &x0, &x1))
+        {
+            ++p;
+            continue;
+        }
+
+        if (!dirty_next_span(d, dirty[p], x1 + 1, &nx0, &nx1))
+        {
+            // single span: extend over following pages with identical bitmaps
+            int q = p;
+            while (q + 1 < pages &&
+                   memcmp(dirty[q + 1], dirty[p], sizeof(dirty[p])) == 0)
+                ++q;
+
+            err = set_window(d, (uint8_t)x0, (uint8_t)x1, (uint8_t)p,
+                             (uint8_t)q);
+            const size_t bytes_wide = (size_t)(x1 - x0 + 1);
+            if (err == ESP_OK && bytes_wide == d->width)
+            {
+                // full-width rows are contiguous in the framebuffer
+                err = d->vt->send_data(d->bus_ctx, &fb[fb_index(d, 0, p)],
+                                       bytes_wide * (size_t)(q - p + 1));
+            }
+            else
+            {
+                for (int pg = p; pg <= q && err == ESP_OK; ++pg)
+                    err = d->vt->send_data(d->bus_ctx, &fb[fb_index(d, x0, pg)],
+                                           bytes_wide);
+            }
+            p = q + 1;
+            continue;
+        }
+
+        // several spans on this page: one window each
+        for (int x = 0; err == ESP_OK && dirty_next_span(d, dirty[p], x, &x0, &x1);
+             x = x1 + 1)
+        {
+            err = set_window(d, (uint8_t)x0, (uint8_t)x1, (uint8_t)p, (uint8_t)p);
+            if (err == ESP_OK)
+                err = d->vt->send_data(d->bus_ctx, &fb[fb_index(d, x0, p)],
+                                       (size_t)(x1 - x0 + 1));
+        }
+        ++p;
     }
+    return err;
+}
+
+// Send the bytes of one page that differ from the shadow. Runs separated by
+// no more than SSD1306_WINDOW_COST unchanged bytes are sent as one window.
+// The shadow is updated only for runs that were sent successfully.
+static esp_err_t flush_page_diff(struct ssd1306_t *d, const uint8_t *fb, int page)
+{
+    const uint8_t *row = &fb[fb_index(d, 0, page)];
+    uint8_t *shadow = &d->shadow[fb_index(d, 0, page)];
+    const int w = (int)d->width;
+    int x = 0;
+
+    while (x < w)
+    {
+        while (x < w && row[x] == shadow[x])
+            ++x;
+        if (x == w)
+            break;
+
+        const int x0 = x;
+        int x1 = x;
+        for (int gap = 0; x < w && gap <= SSD1306_WINDOW_COST; ++x)
+        {
+            if (row[x] != shadow[x])
+            {
+                x1 = x;
+                gap = 0;
+            }
+            else
+            {
+                ++gap;
+            }
+        }
+        x = x1 + 1;
+
+        const size_t n = (size_t)(x1 - x0 + 1);
+        esp_err_t err = set_window(d, (uint8_t)x0, (uint8_t)x1, (uint8_t)page,
+                                   (uint8_t)page);
+        if (err == ESP_OK)
+            err = d->vt->send_data(d->bus_ctx, &row[x0], n);
+        if (err != ESP_OK)
+            return err;
+        memcpy(&shadow[x0], &row[x0], n);
+    }
+    return ESP_OK;
+}
+
+// Diff flush. Until the shadow matches the panel, send everything once.
+// Pages with no dirty columns are skipped unless the caller owns the
+// framebuffer and may have changed it behind our back.
+static esp_err_t flush_diff(struct ssd1306_t *d, const uint8_t *fb,
+                            const uint32_t (*dirty)[SSD1306_DIRTY_WORDS])
+{
+    if (!d->shadow_valid)
+    {
+        esp_err_t err = set_window(d, 0, (uint8_t)(d->width - 1), 0,
+                                   (uint8_t)((d->height >> 3) - 1));
+        if (err == ESP_OK)
+            err = d->vt->send_data(d->bus_ctx, fb, d->fb_len);
+        if (err != ESP_OK)
+            return err;
+        memcpy(d->shadow, fb, d->fb_len);
+        d->shadow_valid = true;
+        return ESP_OK;
+    }
+
+    for (int p = 0; p < (d->height >> 3); ++p)
+    {
+        if (d->driver_owns_fb && dirty_next_set(d, dirty[p], 0) < 0)
+            continue;
+        esp_err_t err = flush_page_diff(d, fb, p);
+        if (err != ESP_OK)
+            return err;
+    }
+    return ESP_OK;
+}
+
+// Send one frame. The caller holds the lock, or in async mode is the flush
+// task, which is then the only user of the bus and the shadow.
+static esp_err_t flush_frame(struct ssd1306_t *d, const uint8_t *fb,
+                             const uint32_t (*dirty)[SSD1306_DIRTY_WORDS])
+{
+    if (d->shadow)
+        return flush_diff(d, fb, dirty);
 
     if (!d->driver_owns_fb)
     {
@@ -951,48 +1242,164 @@ esp_err_t ssd1306_display(ssd1306_handle_t h)
         const uint8_t p0 = 0, p1 = (uint8_t)((d->height >> 3) - 1);
         esp_err_t err = set_window(d, 0, (uint8_t)(d->width - 1), p0, p1);
         if (err == ESP_OK)
-            err = d->vt->send_data(d->bus_ctx, d->fb, d->fb_len);
-        dirty_reset(d);
-        UNLOCK(d);
+            err = d->vt->send_data(d->bus_ctx, fb, d->fb_len);
         return err;
     }
 
-    // partial flush using bbox; no-op if nothing dirty
-    if (!d->dirty)
+    // partial flush: one window per dirty span
+    return flush_dirty_spans(d, fb, dirty);
+}
+
+static void flush_task(void *arg)
+{
+    struct ssd1306_t *d = arg;
+
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!d->flush_running)
+            break;
+
+        esp_err_t err = flush_frame(d, d->front,
+                                    (const uint32_t(*)[SSD1306_DIRTY_WORDS])d->front_dirty);
+        if (err != ESP_OK)
+        {
+            // 后台缓冲区是前台的副本，把没发出去的区域并入后台脏区，下次 present 重发
+            LOCK(d);
+            for (int p = 0; p < SSD1306_MAX_PAGES; ++p)
+                for (int w = 0; w < SSD1306_DIRTY_WORDS; ++w)
+                    d->dirty_cols[p][w] |= d->front_dirty[p][w];
+            d->dirty = true;
+            UNLOCK(d);
+        }
+        xSemaphoreGive(d->flush_idle);
+
+        if (d->on_flush_done)
+            d->on_flush_done(d, err, d->user_ctx);
+    }
+
+    xSemaphoreGive(d->flush_exited);
+    vTaskDelete(NULL);
+}
+
+// Allocate the front buffer and start the flush task.
+static esp_err_t start_async(struct ssd1306_t *d, const ssd1306_config_t *cfg)
+{
+    d->front = calloc(1, d->fb_len);
+    d->flush_idle = xSemaphoreCreateBinary();
+    d->flush_exited = xSemaphoreCreateBinary();
+    if (!d->front || !d->flush_idle || !d->flush_exited)
+        goto err;
+
+    d->on_flush_done = cfg->on_flush_done;
+    d->user_ctx = cfg->user_ctx;
+    d->flush_running = true;
+    xSemaphoreGive(d->flush_idle);
+    if (xTaskCreate(flush_task, "ssd1306_flush", SSD1306_FLUSH_TASK_STACK, d,
+                    cfg->flush_task_priority ? cfg->flush_task_priority
+                                             : SSD1306_FLUSH_TASK_PRIO,
+                    &d->flush_task) != pdPASS)
+        goto err;
+    return ESP_OK;
+
+err:
+    d->flush_running = false;
+    if (d->flush_idle)
+        vSemaphoreDelete(d->flush_idle);
+    if (d->flush_exited)
+        vSemaphoreDelete(d->flush_exited);
+    free(d->front);
+    d->front = NULL;
+    d->flush_idle = d->flush_exited = NULL;
+    d->flush_task = NULL;
+    return ESP_ERR_NO_MEM;
+}
+
+// Wait for the in-flight frame, then stop the flush task.
+static void stop_async(struct ssd1306_t *d)
+{
+    if (!d->flush_task)
+        return;
+
+    xSemaphoreTake(d->flush_idle, portMAX_DELAY);
+    d->flush_running = false;
+    xTaskNotifyGive(d->flush_task);
+    xSemaphoreTake(d->flush_exited, portMAX_DELAY);
+
+    vSemaphoreDelete(d->flush_idle);
+    vSemaphoreDelete(d->flush_exited);
+    free(d->front);
+    d->front = NULL;
+    d->flush_task = NULL;
+}
+
+esp_err_t ssd1306_present(ssd1306_handle_t h)
+{
+    struct ssd1306_t *d = h;
+    if (!d)
+        return ESP_ERR_INVALID_STATE;
+    if (!d->flush_task)
+        return ssd1306_display(h);
+
+    // 上一帧发送完毕后前台缓冲区才能交换
+    xSemaphoreTake(d->flush_idle, portMAX_DELAY);
+    LOCK(d);
+    if (!d->initialized)
     {
         UNLOCK(d);
+        xSemaphoreGive(d->flush_idle);
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!d->dirty && (!d->shadow || d->shadow_valid))
+    {
+        UNLOCK(d);
+        xSemaphoreGive(d->flush_idle);
         return ESP_OK;
     }
-    int x0 = d->dx0, y0 = d->dy0, x1 = d->dx1, y1 = d->dy1;
-    if (x0 < 0)
-        x0 = 0;
-    if (y0 < 0)
-        y0 = 0;
-    if (x1 >= (int)d->width)
-        x1 = d->width - 1;
-    if (y1 >= (int)d->height)
-        y1 = d->height - 1;
 
-    uint8_t p0 = (uint8_t)(y0 >> 3), p1 = (uint8_t)(y1 >> 3);
-    esp_err_t err = set_window(d, (uint8_t)x0, (uint8_t)x1, p0, p1);
-    if (err == ESP_OK)
+    uint8_t *back = d->front;
+    d->front = d->fb;
+    d->fb = back;
+    memcpy(d->front_dirty, d->dirty_cols, sizeof(d->front_dirty));
+    // 新的后台缓冲区从刚提交的帧继续，增量绘制的界面不受影响
+    memcpy(d->fb, d->front, d->fb_len);
+    dirty_reset(d);
+    UNLOCK(d);
+
+    xTaskNotifyGive(d->flush_task);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_display(ssd1306_handle_t h)
+{
+    struct ssd1306_t *d = h;
+    if (!d)
+        return ESP_ERR_INVALID_STATE;
+    if (d->flush_task)
+        return ssd1306_present(h);
+
+    LOCK(d);
+    if (!d->initialized)
     {
-        const int bytes_wide = (x1 - x0 + 1);
-        for (uint8_t p = p0; p <= p1; ++p)
-        {
-            const uint8_t *row = &d->fb[(size_t)p * d->width + (size_t)x0];
-            err = d->vt->send_data(d->bus_ctx, row, (size_t)bytes_wide);
-            if (err != ESP_OK)
-                break;
-        }
+        UNLOCK(d);
+        return ESP_ERR_INVALID_STATE;
     }
+
+    // no-op if nothing dirty, unless the panel content is unknown
+    if (!d->dirty && d->driver_owns_fb && (!d->shadow || d->shadow_valid))
+    {
+        UNLOCK(d);
+        return ESP_OK;
+    }
+    esp_err_t err = flush_frame(d, d->fb,
+                                (const uint32_t(*)[SSD1306_DIRTY_WORDS])d->dirty_cols);
     if (err == ESP_OK)
         dirty_reset(d);
     UNLOCK(d);
     return err;
 }
 
-esp_err_t ssd1306_draw_bitmap(ssd1306_handle_t h, int x, int y, const uint8_t *bitmap, int width, int height)
+esp_err_t ssd1306_draw_bitmap_nolock(ssd1306_handle_t h, int x, int y, const uint8_t *bitmap, int width, int height)
 {
     struct ssd1306_t *d = (struct ssd1306_t *)h;
     if (!d || !bitmap || width <= 0 || height <= 0)
@@ -1039,13 +1446,6 @@ esp_err_t ssd1306_draw_bitmap(ssd1306_handle_t h, int x, int y, const uint8_t *b
         return ESP_OK;
     }
 
-    LOCK(d);
-    if (!d->initialized)
-    {
-        UNLOCK(d);
-        return ESP_ERR_INVALID_STATE;
-    }
-
     // Calculate bytes per row in source bitmap (padded to byte boundary)
     const int bytes_per_row = (width + 7) / 8;
 
@@ -1070,7 +1470,16 @@ esp_err_t ssd1306_draw_bitmap(ssd1306_handle_t h, int x, int y, const uint8_t *b
 
     // Mark dirty region
     mark_dirty(d, dst_x, dst_y, dst_x + draw_width - 1, dst_y + draw_height - 1);
-    UNLOCK(d);
 
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+esp_err_t ssd1306_draw_bitmap(ssd1306_handle_t h, int x, int y, const uint8_t *bitmap, int width, int height)
+{
+    esp_err_t err = ssd1306_begin_frame(h);
+    if (err != ESP_OK)
+        return err;
+    err = ssd1306_draw_bitmap_nolock(h, x, y, bitmap, width, height);
+    ssd1306_end_frame(h);
+    return err;
+}
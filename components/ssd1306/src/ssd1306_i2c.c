@@ -9,6 +9,7 @@
 #include <driver/gpio.h>
 #include <esp_check.h>
 #include <esp_log.h>
+#include <i2c_bus_mgr.h>
 
 #define SSD1306_CTRL_CMD 0x00
 #define SSD1306_CTRL_DATA 0x40
@@ -22,11 +23,14 @@ typedef struct
     i2c_port_num_t port;
     gpio_num_t rst_gpio;
     uint8_t addr;
+    uint16_t max_chunk; // zero-copy 模式单事务最大负载，0 不限
 } ssd1306_i2c_ctx_t;
 
 // Forward declarations
 static esp_err_t i2c_send_cmd(void *ctx, const uint8_t *cmd, size_t n);
 static esp_err_t i2c_send_data(void *ctx, const uint8_t *data, size_t n);
+static esp_err_t i2c_send_cmd_zc(void *ctx, const uint8_t *cmd, size_t n);
+static esp_err_t i2c_send_data_zc(void *ctx, const uint8_t *data, size_t n);
 static esp_err_t i2c_reset(void *ctx);
 
 static const ssd1306_bus_vt_t VT_I2C = {
@@ -35,8 +39,14 @@ static const ssd1306_bus_vt_t VT_I2C = {
     .reset = i2c_reset,
 };
 
+static const ssd1306_bus_vt_t VT_I2C_ZC = {
+    .send_cmd = i2c_send_cmd_zc,
+    .send_data = i2c_send_data_zc,
+    .reset = i2c_reset,
+};
+
 esp_err_t ssd1306_bind_i2c(i2c_master_bus_handle_t bus, struct ssd1306_t *d, i2c_port_num_t port,
-                           uint8_t addr, gpio_num_t rst_gpio)
+                           uint8_t addr, gpio_num_t rst_gpio, bool zero_copy, uint16_t max_chunk)
 {
 
     ESP_RETURN_ON_FALSE(d, ESP_ERR_INVALID_ARG, TAG, "null dev");
@@ -49,6 +59,7 @@ esp_err_t ssd1306_bind_i2c(i2c_master_bus_handle_t bus, struct ssd1306_t *d, i2c
     ctx->addr = addr;
     ctx->rst_gpio = rst_gpio;
     ctx->port = I2C_NUM_MAX; // 标记为未知端口
+    ctx->max_chunk = max_chunk;
 
     i2c_device_config_t dev_cfg = {
         .device_address = addr,
@@ -59,7 +70,11 @@ esp_err_t ssd1306_bind_i2c(i2c_master_bus_handle_t bus, struct ssd1306_t *d, i2c
         },
     };
 
-    esp_err_t err = i2c_master_bus_add_device(bus, &dev_cfg, &ctx->dev);
+    const i2c_mgr_device_config_t mgr_cfg = {
+        .name = "ssd1306",
+        .priority = I2C_MGR_PRIO_LOW, // 每个数据块之间是一个让出点
+    };
+    esp_err_t err = i2c_mgr_add_device(bus, &dev_cfg, &mgr_cfg, &ctx->dev);
     if (err != ESP_OK)
     {
         free(ctx);
@@ -89,7 +104,7 @@ esp_err_t ssd1306_bind_i2c(i2c_master_bus_handle_t bus, struct ssd1306_t *d, i2c
         }
     }
 
-    d->vt = &VT_I2C;
+    d->vt = zero_copy ? &VT_I2C_ZC : &VT_I2C;
     d->bus_ctx = ctx;
 
     return ESP_OK;
@@ -110,7 +125,7 @@ static esp_err_t i2c_send_cmd(void *ctx, const uint8_t *cmds, size_t n)
         uint8_t buf[1 + MAX];
         buf[0] = SSD1306_CTRL_CMD;
         memcpy(&buf[1], &cmds[off], blk);
-        ESP_RETURN_ON_ERROR(i2c_master_transmit(c->dev, buf, 1 + blk, -1), TAG,
+        ESP_RETURN_ON_ERROR(i2c_mgr_transmit(c->dev, buf, 1 + blk, -1), TAG,
                             "cmd xfer");
         off += blk;
     }
@@ -132,7 +147,7 @@ static esp_err_t i2c_send_data(void *ctx, const uint8_t *data, size_t n)
         uint8_t buf[1 + MAX];
         buf[0] = SSD1306_CTRL_DATA;
         memcpy(&buf[1], &data[off], blk);
-        ESP_RETURN_ON_ERROR(i2c_master_transmit(c->dev, buf, 1 + blk, -1), TAG,
+        ESP_RETURN_ON_ERROR(i2c_mgr_transmit(c->dev, buf, 1 + blk, -1), TAG,
                             "data xfer");
         off += blk;
     }
@@ -140,6 +155,37 @@ static esp_err_t i2c_send_data(void *ctx, const uint8_t *data, size_t n)
     return ESP_OK;
 }
 
+// Control byte and payload go out as two buffers of one transaction, so the
+// payload is never copied. Transfers longer than max_chunk are split.
+static esp_err_t i2c_send_zc(ssd1306_i2c_ctx_t *c, uint8_t ctrl, const uint8_t *p, size_t n)
+{
+    const size_t max = c->max_chunk ? c->max_chunk : n;
+    size_t off = 0;
+
+    while (off < n)
+    {
+        size_t blk = (n - off) > max ? max : (n - off);
+        i2c_master_transmit_multi_buffer_info_t bufs[] = {
+            {.write_buffer = &ctrl, .buffer_size = 1},
+            {.write_buffer = (uint8_t *)&p[off], .buffer_size = blk}, // 驱动只读不写
+        };
+        ESP_RETURN_ON_ERROR(i2c_mgr_multi_buffer_transmit(c->dev, bufs, 2, -1), TAG,
+                            "zc xfer");
+        off += blk;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t i2c_send_cmd_zc(void *ctx, const uint8_t *cmds, size_t n)
+{
+    return i2c_send_zc(ctx, SSD1306_CTRL_CMD, cmds, n);
+}
+
+static esp_err_t i2c_send_data_zc(void *ctx, const uint8_t *data, size_t n)
+{
+    return i2c_send_zc(ctx, SSD1306_CTRL_DATA, data, n);
+}
+
 static esp_err_t i2c_reset(void *ctx)
 {
     ssd1306_i2c_ctx_t *c = ctx;
@@ -165,10 +211,10 @@ esp_err_t ssd1306_unbind_i2c(struct ssd1306_t *d)
 
     if (ctx->dev)
     {
-        esp_err_t e = i2c_master_bus_rm_device(ctx->dev);
+        esp_err_t e = i2c_mgr_rm_device(ctx->dev);
         if (e != ESP_OK)
         {
-            ESP_LOGW(TAG, "i2c_master_bus_rm_device failed: %s",
+            ESP_LOGW(TAG, "i2c_mgr_rm_device failed: %s",
                      esp_err_to_name(e));
             ret = e;
         }
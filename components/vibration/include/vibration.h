@@ -0,0 +1,125 @@
+/**
+ * @file
+ * @brief 基于 Q15 定点 FFT 的车体振动分析
+ *
+ * 从采样流中取单轴加速度，攒满 VIB_FFT_SIZE 点后去直流、加 Hann 窗，做 radix-2 定点 FFT，
+ * 输出各频带能量、总 RMS 和主频。FFT 按蝶形级分步执行，每次调用 vib_process() 只做
+ * 指定数量的级，可在低优先级任务中穿插运行，不会长时间占用 CPU 而拖慢采集。
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "mpu6050.h"
+
+#define VIB_FFT_SIZE 256  /*!< FFT 点数（2 的幂） */
+#define VIB_FFT_STAGES 8  /*!< log2(VIB_FFT_SIZE) */
+#define VIB_MAX_BANDS 8   /*!< 最多统计的频带数 */
+
+    typedef enum
+    {
+        VIB_AXIS_X = 0,
+        VIB_AXIS_Y = 1,
+        VIB_AXIS_Z = 2, /*!< 车体水平安装时为竖直方向 */
+    } vib_axis_t;
+
+    typedef struct
+    {
+        float sample_rate_hz;       /*!< 输入采样率（MPU6050 ODR） */
+        float acce_sensitivity;     /*!< 加速度计灵敏度（LSB/g），见 mpu6050_get_acce_sensitivity() */
+        vib_axis_t axis;            /*!< 分析的轴 */
+        uint16_t hop;               /*!< 相邻两窗起点间隔（采样数），0 或大于 VIB_FFT_SIZE 时取 VIB_FFT_SIZE */
+        uint8_t band_count;         /*!< 频带数，0 ~ VIB_MAX_BANDS */
+        float band_edges_hz[VIB_MAX_BANDS + 1]; /*!< 频带边界，第 i 个频带为 [edges[i], edges[i+1]) */
+    } vib_config_t;
+
+    typedef struct
+    {
+        uint32_t seq;                        /*!< 结果序号，每完成一次变换加一 */
+        int64_t timestamp_us;                /*!< 窗口最后一个采样的时间戳 */
+        float rms_g;                         /*!< 去直流后的总 RMS（g） */
+        float dominant_hz;                   /*!< 主频（抛物线插值） */
+        float dominant_amp_g;                /*!< 主频分量幅值（g） */
+        uint8_t band_count;                  /*!< 同 vib_config_t::band_count */
+        float band_energy[VIB_MAX_BANDS];    /*!< 各频带均方值（g²），开方即该频带 RMS */
+    } vib_result_t;
+
+    typedef struct vib_t *vib_handle_t;
+
+    /**
+     * @brief 创建振动分析实例，预先计算窗函数与旋转因子
+     *
+     * @param config analyzer configuration
+     * @return
+     *     - NULL Fail (out of memory or invalid config)
+     *     - Others Success
+     */
+    vib_handle_t vib_create(const vib_config_t *const config);
+
+    /**
+     * @brief 释放实例
+     *
+     * @param vib analyzer handle
+     */
+    void vib_delete(vib_handle_t vib);
+
+    /**
+     * @brief 送入一批采样（只取配置轴的原始加速度）
+     *
+     * 攒满一窗且上一次变换已完成时，窗口被复制到工作区等待 vib_process()；
+     * 若上一次变换仍未完成，该窗口被丢弃并计入 dropped。
+     *
+     * @param vib analyzer handle
+     * @param samples samples in time order
+     * @param count number of samples
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     */
+    esp_err_t vib_push(vib_handle_t vib, const mpu6050_sample_t *samples, size_t count);
+
+    /**
+     * @brief 推进挂起的变换，最多执行 max_stages 个蝶形级
+     *
+     * 所有级完成后在同一次调用中计算频谱统计。max_stages 取 VIB_FFT_STAGES 即一次做完。
+     *
+     * @param vib analyzer handle
+     * @param max_stages butterfly stages to run in this call, at least 1
+     * @param ready set to true when a new result became available, may be NULL
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG vib is NULL
+     */
+    esp_err_t vib_process(vib_handle_t vib, uint8_t max_stages, bool *ready);
+
+    /**
+     * @brief 获取最近一次结果
+     *
+     * @param vib analyzer handle
+     * @param out result copy
+     * @return
+     *     - ESP_OK Success
+     *     - ESP_ERR_INVALID_ARG A parameter is NULL
+     *     - ESP_ERR_NOT_FOUND No transform has completed yet
+     */
+    esp_err_t vib_get_result(vib_handle_t vib, vib_result_t *const out);
+
+    /**
+     * @brief 因变换未完成而丢弃的窗口数
+     *
+     * @param vib analyzer handle
+     * @return dropped window count
+     */
+    uint32_t vib_get_dropped(vib_handle_t vib);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,314 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vibration.h"
+
+#define VIB_PI 3.14159265358979f
+#define VIB_HANN_POWER 0.375f // Hann 窗 w² 的均值，用于修正窗函数造成的能量损失
+#define VIB_HANN_GAIN 0.5f    // Hann 窗相干增益，用于修正单频分量幅值
+#define VIB_INPUT_BITS 14     // 输入归一化到 ±2^14，留一位给蝶形运算的中间结果
+
+struct vib_t
+{
+    vib_config_t config;
+    uint16_t hop;
+    int16_t window[VIB_FFT_SIZE];      // Hann 窗，Q15
+    int16_t tw_re[VIB_FFT_SIZE / 2];   // 旋转因子 cos(2πk/N)，Q15
+    int16_t tw_im[VIB_FFT_SIZE / 2];   // 旋转因子 -sin(2πk/N)，Q15
+    int16_t history[VIB_FFT_SIZE];     // 最近 N 个输入，环形
+    uint16_t head;                     // 下一个写入位置
+    uint32_t filled;                   // 已写入的采样数（饱和到 N）
+    uint16_t since_window;             // 距离上一窗起点的采样数
+    int64_t last_timestamp_us;         // 最近一个输入的时间戳
+    int16_t re[VIB_FFT_SIZE];          // 工作区，位反序存放
+    int16_t im[VIB_FFT_SIZE];
+    int8_t shift;                      // 输入归一化左移位数（可为负）
+    int64_t work_timestamp_us;         // 工作区窗口的时间戳
+    bool busy;                         // 工作区中有未完成的变换
+    uint8_t stage;                     // 下一个要执行的蝶形级
+    vib_result_t result;
+    bool has_result;
+    uint32_t dropped;
+};
+
+static inline uint16_t vib_bit_reverse(uint16_t v)
+{
+    uint16_t r = 0;
+    for (int i = 0; i < VIB_FFT_STAGES; i++)
+    {
+        r = (uint16_t)((r << 1) | (v & 1));
+        v >>= 1;
+    }
+    return r;
+}
+
+static inline int16_t vib_to_q15(float v)
+{
+    int32_t q = (int32_t)lroundf(v * 32768.0f);
+    return (int16_t)(q > INT16_MAX ? INT16_MAX : (q < INT16_MIN ? INT16_MIN : q));
+}
+
+vib_handle_t vib_create(const vib_config_t *const config)
+{
+    if (NULL == config || config->sample_rate_hz <= 0 || config->acce_sensitivity <= 0 ||
+        config->axis > VIB_AXIS_Z || config->band_count > VIB_MAX_BANDS)
+    {
+        return NULL;
+    }
+    for (uint8_t i = 0; i < config->band_count; i++)
+    {
+        if (config->band_edges_hz[i + 1] <= config->band_edges_hz[i])
+        {
+            return NULL;
+        }
+    }
+
+    struct vib_t *v = calloc(1, sizeof(*v));
+    if (!v)
+    {
+        return NULL;
+    }
+    v->config = *config;
+    v->hop = (0 == config->hop || config->hop > VIB_FFT_SIZE) ? VIB_FFT_SIZE : config->hop;
+
+    for (int n = 0; n < VIB_FFT_SIZE; n++)
+    {
+        // 周期 Hann 窗（分母为 N），适合 FFT 频谱分析
+        v->window[n] = vib_to_q15(0.5f * (1.0f - cosf(2.0f * VIB_PI * n / VIB_FFT_SIZE)));
+    }
+    for (int k = 0; k < VIB_FFT_SIZE / 2; k++)
+    {
+        v->tw_re[k] = vib_to_q15(cosf(2.0f * VIB_PI * k / VIB_FFT_SIZE));
+        v->tw_im[k] = vib_to_q15(-sinf(2.0f * VIB_PI * k / VIB_FFT_SIZE));
+    }
+    return v;
+}
+
+void vib_delete(vib_handle_t vib)
+{
+    free(vib);
+}
+
+// 把最近 N 个采样去直流、加窗、归一化后按位反序放入工作区
+static void vib_load_window(struct vib_t *v)
+{
+    int32_t sum = 0;
+    for (int n = 0; n < VIB_FFT_SIZE; n++)
+    {
+        sum += v->history[n];
+    }
+    const int32_t mean = sum / VIB_FFT_SIZE;
+
+    int32_t windowed[VIB_FFT_SIZE];
+    int32_t peak = 0;
+    for (int n = 0; n < VIB_FFT_SIZE; n++)
+    {
+        // head 指向最旧的采样
+        const int32_t x = v->history[(v->head + n) % VIB_FFT_SIZE] - mean;
+        windowed[n] = (x * v->window[n]) >> 15;
+        peak = abs(windowed[n]) > peak ? abs(windowed[n]) : peak;
+    }
+
+    // 块浮点：把峰值移到 2^13~2^14 之间，小振动也能用满精度。
+    // 对移位后的峰值逐位调整，移位量始终非负；放大后的峰值小于 2^14，不会再进入缩小的循环
+    int8_t shift = 0;
+    if (peak > 0)
+    {
+        uint32_t scaled = (uint32_t)peak;
+        while (scaled < (1u << (VIB_INPUT_BITS - 1)) && shift < 15)
+        {
+            scaled <<= 1;
+            shift++;
+        }
+        while (scaled >= (1u << VIB_INPUT_BITS))
+        {
+            scaled >>= 1;
+            shift--;
+        }
+    }
+    for (int n = 0; n < VIB_FFT_SIZE; n++)
+    {
+        const uint16_t r = vib_bit_reverse((uint16_t)n);
+        // 负数左移是未定义行为，放大用乘法；缩小用算术右移
+        v->re[r] = (int16_t)(shift >= 0 ? windowed[n] * (1 << shift) : windowed[n] >> -shift);
+        v->im[r] = 0;
+    }
+
+    v->shift = shift;
+    v->work_timestamp_us = v->last_timestamp_us;
+    v->stage = 0;
+    v->busy = true;
+}
+
+esp_err_t vib_push(vib_handle_t vib, const mpu6050_sample_t *samples, size_t count)
+{
+    if (NULL == vib || NULL == samples)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const mpu6050_raw_acce_value_t *raw = &samples[i].raw.raw_acce;
+        const int16_t x = (VIB_AXIS_X == vib->config.axis) ? raw->raw_acce_x
+                          : (VIB_AXIS_Y == vib->config.axis) ? raw->raw_acce_y
+                                                             : raw->raw_acce_z;
+        vib->history[vib->head] = x;
+        vib->head = (vib->head + 1) % VIB_FFT_SIZE;
+        vib->last_timestamp_us = samples[i].timestamp_us;
+        if (vib->filled < VIB_FFT_SIZE)
+        {
+            vib->filled++;
+        }
+        vib->since_window++;
+
+        if (vib->filled == VIB_FFT_SIZE && vib->since_window >= vib->hop)
+        {
+            vib->since_window = 0;
+            if (vib->busy)
+            {
+                vib->dropped++;
+            }
+            else
+            {
+                vib_load_window(vib);
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+// 执行一个 radix-2 时间抽取蝶形级，每级输出右移一位防止溢出
+static void vib_fft_stage(struct vib_t *v, uint8_t stage)
+{
+    const int half = 1 << stage;
+    const int stride = VIB_FFT_SIZE / (2 * half);
+
+    for (int base = 0; base < VIB_FFT_SIZE; base += 2 * half)
+    {
+        for (int j = 0; j < half; j++)
+        {
+            const int a = base + j;
+            const int b = a + half;
+            const int32_t wr = v->tw_re[j * stride];
+            const int32_t wi = v->tw_im[j * stride];
+            const int32_t tr = (wr * v->re[b] - wi * v->im[b]) >> 15;
+            const int32_t ti = (wr * v->im[b] + wi * v->re[b]) >> 15;
+            const int32_t ar = v->re[a];
+            const int32_t ai = v->im[a];
+            v->re[a] = (int16_t)((ar + tr) >> 1);
+            v->im[a] = (int16_t)((ai + ti) >> 1);
+            v->re[b] = (int16_t)((ar - tr) >> 1);
+            v->im[b] = (int16_t)((ai - ti) >> 1);
+        }
+    }
+}
+
+// 由 FFT 结果计算频带能量、RMS 与主频
+static void vib_compute_result(struct vib_t *v)
+{
+    vib_result_t *r = &v->result;
+    const float bin_hz = v->config.sample_rate_hz / VIB_FFT_SIZE;
+    // X_fft = FFT(x) * 2^shift / N，单边均方值 = 2/N² Σ|FFT(x)|² / 窗能量
+    const float unshift = ldexpf(1.0f, -v->shift);
+    const float inv_sens = 1.0f / v->config.acce_sensitivity;
+    const float power_scale = 2.0f * unshift * unshift * inv_sens * inv_sens / VIB_HANN_POWER;
+
+    float mag[VIB_FFT_SIZE / 2];
+    float total = 0;
+    int peak_bin = 1;
+
+    memset(r->band_energy, 0, sizeof(r->band_energy));
+    mag[0] = 0;
+    for (int k = 1; k < VIB_FFT_SIZE / 2; k++)
+    {
+        const float p = (float)((int32_t)v->re[k] * v->re[k] + (int32_t)v->im[k] * v->im[k]);
+        const float ms = p * power_scale;
+        mag[k] = sqrtf(p);
+        total += ms;
+        if (mag[k] > mag[peak_bin])
+        {
+            peak_bin = k;
+        }
+
+        const float f = k * bin_hz;
+        for (uint8_t i = 0; i < v->config.band_count; i++)
+        {
+            if (f >= v->config.band_edges_hz[i] && f < v->config.band_edges_hz[i + 1])
+            {
+                r->band_energy[i] += ms;
+                break;
+            }
+        }
+    }
+
+    // 相邻三点抛物线插值修正主频
+    float delta = 0;
+    if (peak_bin > 1 && peak_bin < VIB_FFT_SIZE / 2 - 1)
+    {
+        const float l = mag[peak_bin - 1], c = mag[peak_bin], rr = mag[peak_bin + 1];
+        const float den = l - 2.0f * c + rr;
+        if (den < 0)
+        {
+            delta = 0.5f * (l - rr) / den;
+        }
+    }
+
+    r->seq++;
+    r->timestamp_us = v->work_timestamp_us;
+    r->rms_g = sqrtf(total);
+    r->dominant_hz = (peak_bin + delta) * bin_hz;
+    r->dominant_amp_g = 2.0f * mag[peak_bin] * unshift * inv_sens / VIB_HANN_GAIN;
+    r->band_count = v->config.band_count;
+    v->has_result = true;
+}
+
+esp_err_t vib_process(vib_handle_t vib, uint8_t max_stages, bool *ready)
+{
+    if (NULL == vib)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (ready)
+    {
+        *ready = false;
+    }
+    if (!vib->busy)
+    {
+        return ESP_OK;
+    }
+
+    for (uint8_t i = 0; i < max_stages && vib->stage < VIB_FFT_STAGES; i++)
+    {
+        vib_fft_stage(vib, vib->stage++);
+    }
+    if (VIB_FFT_STAGES == vib->stage)
+    {
+        vib_compute_result(vib);
+        vib->busy = false;
+        if (ready)
+        {
+            *ready = true;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t vib_get_result(vib_handle_t vib, vib_result_t *const out)
+{
+    if (NULL == vib || NULL == out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!vib->has_result)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *out = vib->result;
+    return ESP_OK;
+}
+
+uint32_t vib_get_dropped(vib_handle_t vib)
+{
+    return vib ? vib->dropped : 0;
+}
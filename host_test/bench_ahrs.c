@@ -0,0 +1,62 @@
+/**
+ * AHRS 单次更新耗时（ns）：Madgwick 与 Mahony，输入为带噪声的小幅摆动。
+ * 开发机上的数字只用于两种算法之间以及前后版本之间的相对比较。
+ */
+
+#include <math.h>
+
+#include "ahrs.h"
+#include "test_util.h"
+
+#define SAMPLES 1024
+#define ROUNDS 2000
+#define DT_S 0.001f
+
+static mpu6050_acce_value_t s_acce[SAMPLES];
+static mpu6050_gyro_value_t s_gyro[SAMPLES];
+
+static double bench_algorithm(const ahrs_config_t *cfg)
+{
+    ahrs_handle_t ahrs = ahrs_create(cfg);
+    if (!ahrs)
+    {
+        return NAN;
+    }
+
+    const int64_t t0 = bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        for (int k = 0; k < SAMPLES; k++)
+        {
+            ahrs_update(ahrs, &s_acce[k], &s_gyro[k], DT_S);
+        }
+    }
+    const int64_t elapsed = bench_now_ns() - t0;
+
+    ahrs_quaternion_t q;
+    ahrs_get_quaternion(ahrs, &q);
+    BENCH_SINK(q.w * 1000);
+    ahrs_delete(ahrs);
+    return (double)elapsed / ((double)SAMPLES * ROUNDS);
+}
+
+int main(void)
+{
+    for (int k = 0; k < SAMPLES; k++)
+    {
+        const float t = k * DT_S;
+        s_acce[k].acce_x = 0.1f * sinf(2 * (float)M_PI * 3 * t);
+        s_acce[k].acce_y = 0.2f * cosf(2 * (float)M_PI * 2 * t);
+        s_acce[k].acce_z = 0.97f;
+        s_gyro[k].gyro_x = 15.0f * cosf(2 * (float)M_PI * 3 * t);
+        s_gyro[k].gyro_y = -10.0f * sinf(2 * (float)M_PI * 2 * t);
+        s_gyro[k].gyro_z = 0.5f;
+    }
+
+    const ahrs_config_t madgwick = {.algorithm = AHRS_ALGO_MADGWICK, .beta = 0.05f};
+    const ahrs_config_t mahony = {.algorithm = AHRS_ALGO_MAHONY, .kp = 1.0f, .ki = 0.01f};
+    printf("ahrs_update, %d updates per algorithm\n", SAMPLES * ROUNDS);
+    printf("  madgwick: %7.1f ns/update\n", bench_algorithm(&madgwick));
+    printf("  mahony:   %7.1f ns/update\n", bench_algorithm(&mahony));
+    return 0;
+}
@@ -0,0 +1,326 @@
+/**
+ * imu_record 每个采样的耗时（ns）：写入器序列化（512 字节缓冲、内存 sink），
+ * 以及读取器解析加换算（回放时每条记录的开销）。
+ *
+ * 之后把一段记录回放给各个姿态算法：互补滤波的浮点输入与原始输入两个入口、AHRS 的
+ * Madgwick 与 Mahony，输出每次更新的耗时与 roll/pitch 相对真值的误差。默认回放程序生成的
+ * 模拟记录（已知姿态的摆动，加上噪声与陀螺仪零偏）；命令行给出记录文件时回放该文件，
+ * 文件没有真值，只输出耗时。与 bench_mpu6050_filter 一样分别链接浮点版与定点版驱动。
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ahrs.h"
+#include "imu_record.h"
+#include "test_util.h"
+
+#define SAMPLES 20000 // 1 kHz，20 s
+#define PERIOD_US 1000
+#define ROUNDS 200
+#define REPLAY_ROUNDS 20
+#define SETTLE_SAMPLES 2000 // 前 2 s 等待收敛，不计误差
+
+// 模拟的摆动（度、Hz）与陀螺仪零偏（°/s）
+#define ROLL_AMPLITUDE 20.0
+#define ROLL_HZ 0.5
+#define PITCH_AMPLITUDE 15.0
+#define PITCH_HZ 0.3
+#define GYRO_BIAS_X 0.3f
+#define GYRO_BIAS_Y -0.2f
+#define GYRO_BIAS_Z 0.1f
+
+#if CONFIG_MPU6050_FIXED_POINT_FILTER
+#define FILTER_NAME "fixed-point"
+#else
+#define FILTER_NAME "float"
+#endif
+
+static mpu6050_sample_t s_samples[SAMPLES];
+static float s_truth_roll[SAMPLES];
+static float s_truth_pitch[SAMPLES]; // 右手定则，与 AHRS 相同
+static uint8_t s_file[IMU_RECORD_HEADER_SIZE + SAMPLES * IMU_RECORD_ENTRY_SIZE];
+static size_t s_file_len;
+
+// 回放时解码出的采样，以及各算法每次更新后的角度
+static mpu6050_sample_t *s_replay;
+static float *s_dt;
+static float *s_roll;
+static float *s_pitch;
+static size_t s_count;
+
+static esp_err_t mem_sink(void *ctx, const void *data, size_t len)
+{
+    memcpy(s_file + s_file_len, data, len);
+    s_file_len += len;
+    return ESP_OK;
+}
+
+// 确定性的均匀噪声，范围 [-amplitude, amplitude)
+static float noise(float amplitude)
+{
+    static uint32_t seed = 12345;
+    seed = seed * 1664525u + 1013904223u;
+    return amplitude * ((float)(seed >> 8) / (float)(1u << 23) - 1.0f);
+}
+
+static int16_t quantize(double value, float sensitivity)
+{
+    const long v = lround(value * sensitivity);
+    return (int16_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+// roll 绕 X、pitch 绕 Y 的摆动，yaw 保持 0：加速度为机体系下的重力，角速度为机体系角速度
+static void simulate(const imu_record_header_t *header)
+{
+    const double deg = M_PI / 180.0;
+    for (int k = 0; k < SAMPLES; k++)
+    {
+        const double t = k * (PERIOD_US * 1e-6);
+        const double w_roll = 2 * M_PI * ROLL_HZ;
+        const double w_pitch = 2 * M_PI * PITCH_HZ;
+        const double roll = ROLL_AMPLITUDE * sin(w_roll * t);
+        const double pitch = PITCH_AMPLITUDE * sin(w_pitch * t + 0.5);
+        const double roll_rate = ROLL_AMPLITUDE * w_roll * cos(w_roll * t);
+        const double pitch_rate = PITCH_AMPLITUDE * w_pitch * cos(w_pitch * t + 0.5);
+
+        const double ax = -sin(pitch * deg);
+        const double ay = sin(roll * deg) * cos(pitch * deg);
+        const double az = cos(roll * deg) * cos(pitch * deg);
+        const double gx = roll_rate;
+        const double gy = cos(roll * deg) * pitch_rate;
+        const double gz = -sin(roll * deg) * pitch_rate;
+
+        mpu6050_sample_t *s = &s_samples[k];
+        memset(s, 0, sizeof(*s));
+        s->timestamp_us = 1000000 + (int64_t)k * PERIOD_US;
+        s->raw.raw_acce.raw_acce_x = quantize(ax + noise(0.02f), header->acce_sensitivity);
+        s->raw.raw_acce.raw_acce_y = quantize(ay + noise(0.02f), header->acce_sensitivity);
+        s->raw.raw_acce.raw_acce_z = quantize(az + noise(0.02f), header->acce_sensitivity);
+        s->raw.raw_gyro.raw_gyro_x = quantize(gx + GYRO_BIAS_X + noise(0.2f), header->gyro_sensitivity);
+        s->raw.raw_gyro.raw_gyro_y = quantize(gy + GYRO_BIAS_Y + noise(0.2f), header->gyro_sensitivity);
+        s->raw.raw_gyro.raw_gyro_z = quantize(gz + GYRO_BIAS_Z + noise(0.2f), header->gyro_sensitivity);
+        s_truth_roll[k] = (float)roll;
+        s_truth_pitch[k] = (float)pitch;
+    }
+}
+
+static bool load_file(const char *path, uint8_t **data, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    const long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    *data = len > 0 ? malloc((size_t)len) : NULL;
+    const bool ok = *data && (size_t)len == fread(*data, 1, (size_t)len, f);
+    fclose(f);
+    *size = ok ? (size_t)len : 0;
+    return ok;
+}
+
+// 解码整段记录，回放计时只包含算法本身
+static bool decode(const uint8_t *data, size_t size, imu_record_reader_handle_t *reader)
+{
+    static imu_record_mem_source_t src; // 读取器在回放期间一直引用
+    src = (imu_record_mem_source_t){.data = data, .size = size};
+    imu_record_header_t header;
+    if (ESP_OK != imu_record_reader_open(imu_record_mem_read, &src, reader, &header))
+    {
+        return false;
+    }
+    const size_t capacity = (size - IMU_RECORD_HEADER_SIZE) / IMU_RECORD_ENTRY_SIZE;
+    s_replay = calloc(capacity, sizeof(*s_replay));
+    s_dt = calloc(capacity, sizeof(*s_dt));
+    s_roll = calloc(capacity, sizeof(*s_roll));
+    s_pitch = calloc(capacity, sizeof(*s_pitch));
+    mpu6050_handle_t sensor = imu_record_reader_create_sensor(*reader);
+    if (!s_replay || !s_dt || !s_roll || !s_pitch || !sensor)
+    {
+        return false;
+    }
+    while (s_count < capacity && ESP_OK == imu_record_reader_next(*reader, sensor, &s_replay[s_count]))
+    {
+        const int64_t prev = s_count ? s_replay[s_count - 1].timestamp_us : 0;
+        const uint32_t period = header.sample_period_us ? header.sample_period_us : PERIOD_US;
+        s_dt[s_count] = s_count ? (float)(s_replay[s_count].timestamp_us - prev) * 1e-6f : (float)period * 1e-6f;
+        s_count++;
+    }
+    mpu6050_delete(sensor);
+    return s_count > 0;
+}
+
+// 互补滤波的状态在传感器句柄里，每轮新建一个离线句柄从头开始
+static double replay_filter(imu_record_reader_handle_t reader, bool raw)
+{
+    int64_t ns = 0;
+    for (int r = 0; r < REPLAY_ROUNDS; r++)
+    {
+        mpu6050_handle_t sensor = imu_record_reader_create_sensor(reader);
+        complimentary_angle_t angle = {0};
+        const int64_t t0 = bench_now_ns();
+        for (size_t k = 0; k < s_count; k++)
+        {
+            const mpu6050_sample_t *s = &s_replay[k];
+            if (raw)
+            {
+                mpu6050_complimentory_filter_raw(sensor, &s->raw, s->timestamp_us, &angle);
+            }
+            else
+            {
+                mpu6050_complimentory_filter(sensor, &s->acce, &s->gyro, s->timestamp_us, &angle);
+            }
+            s_roll[k] = angle.roll;
+            s_pitch[k] = -angle.pitch; // 互补滤波的 pitch 与 AHRS 符号相反，见 ahrs.h
+        }
+        ns += bench_now_ns() - t0;
+        mpu6050_delete(sensor);
+    }
+    return (double)ns / ((double)s_count * REPLAY_ROUNDS);
+}
+
+static double replay_ahrs(const ahrs_config_t *cfg)
+{
+    int64_t ns = 0;
+    for (int r = 0; r < REPLAY_ROUNDS; r++)
+    {
+        ahrs_handle_t ahrs = ahrs_create(cfg);
+        ahrs_euler_t euler;
+        const int64_t t0 = bench_now_ns();
+        for (size_t k = 0; k < s_count; k++)
+        {
+            ahrs_update(ahrs, &s_replay[k].acce, &s_replay[k].gyro, s_dt[k]);
+            ahrs_get_euler(ahrs, &euler);
+            s_roll[k] = euler.roll;
+            s_pitch[k] = euler.pitch;
+        }
+        ns += bench_now_ns() - t0;
+        ahrs_delete(ahrs);
+    }
+    return (double)ns / ((double)s_count * REPLAY_ROUNDS);
+}
+
+static void report(const char *name, double ns, bool has_truth)
+{
+    BENCH_SINK(s_roll[s_count - 1] * 1000);
+    if (!has_truth || s_count <= SETTLE_SAMPLES)
+    {
+        printf("  %-16s %8.1f\n", name, ns);
+        return;
+    }
+    double roll_sq = 0, pitch_sq = 0, roll_max = 0, pitch_max = 0;
+    for (size_t k = SETTLE_SAMPLES; k < s_count; k++)
+    {
+        const double dr = fabs(s_roll[k] - s_truth_roll[k]);
+        const double dp = fabs(s_pitch[k] - s_truth_pitch[k]);
+        roll_sq += dr * dr;
+        pitch_sq += dp * dp;
+        roll_max = fmax(roll_max, dr);
+        pitch_max = fmax(pitch_max, dp);
+    }
+    const double n = (double)(s_count - SETTLE_SAMPLES);
+    printf("  %-16s %8.1f %10.2f %8.2f %10.2f %8.2f\n", name, ns, sqrt(roll_sq / n), roll_max, sqrt(pitch_sq / n),
+           pitch_max);
+}
+
+int main(int argc, char **argv)
+{
+    mpu6050_handle_t board = mpu6050_create(NULL, 0x68);
+    if (!board || ESP_OK != mpu6050_config(board, ACCE_FS_4G, GYRO_FS_500DPS))
+    {
+        return 1;
+    }
+    imu_record_header_t header;
+    imu_record_header_from_sensor(board, 1000000, &header);
+    header.sample_period_us = PERIOD_US;
+    simulate(&header);
+
+    const imu_record_writer_config_t cfg = {.sink = mem_sink};
+    imu_record_writer_handle_t w = imu_record_writer_create(&cfg);
+
+    int64_t write_ns = 0;
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        s_file_len = 0;
+        const int64_t t0 = bench_now_ns();
+        imu_record_writer_begin(w, &header);
+        imu_record_writer_append(w, s_samples, SAMPLES);
+        imu_record_writer_flush(w);
+        write_ns += bench_now_ns() - t0;
+    }
+    imu_record_writer_delete(w);
+
+    int64_t read_ns = 0;
+    mpu6050_sample_t s;
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        imu_record_mem_source_t src = {.data = s_file, .size = s_file_len};
+        const int64_t t0 = bench_now_ns();
+        imu_record_reader_handle_t reader = NULL;
+        imu_record_reader_open(imu_record_mem_read, &src, &reader, NULL);
+        mpu6050_handle_t sensor = imu_record_reader_create_sensor(reader);
+        while (ESP_OK == imu_record_reader_next(reader, sensor, &s))
+        {
+            BENCH_SINK(s.acce.acce_z * 1000);
+        }
+        mpu6050_delete(sensor);
+        imu_record_reader_close(reader);
+        read_ns += bench_now_ns() - t0;
+    }
+
+    printf("imu_record, %d samples x %d rounds, %zu bytes per recording\n", SAMPLES, ROUNDS, s_file_len);
+    printf("  append:          %6.2f ns/sample\n", (double)write_ns / ((double)SAMPLES * ROUNDS));
+    printf("  read + convert:  %6.2f ns/sample\n", (double)read_ns / ((double)SAMPLES * ROUNDS));
+    mpu6050_delete(board);
+
+    // 回放：默认为上面的模拟记录，命令行给出文件时回放该文件
+    const uint8_t *data = s_file;
+    size_t size = s_file_len;
+    const bool has_truth = argc < 2;
+    uint8_t *loaded = NULL;
+    if (!has_truth)
+    {
+        if (!load_file(argv[1], &loaded, &size))
+        {
+            printf("cannot read %s\n", argv[1]);
+            return 1;
+        }
+        data = loaded;
+    }
+    imu_record_reader_handle_t reader = NULL;
+    if (!decode(data, size, &reader))
+    {
+        printf("not a valid record\n");
+        return 1;
+    }
+
+    printf("%s replay through %s estimators, %zu samples x %d rounds\n", has_truth ? "simulated" : argv[1],
+           FILTER_NAME, s_count, REPLAY_ROUNDS);
+    if (has_truth)
+    {
+        printf("  %-16s %8s %10s %8s %10s %8s  (deg, after %d samples)\n", "", "ns/update", "roll rms", "max",
+               "pitch rms", "max", SETTLE_SAMPLES);
+    }
+    else
+    {
+        printf("  %-16s %8s\n", "", "ns/update");
+    }
+    report("cf float input", replay_filter(reader, false), has_truth);
+    report("cf raw input", replay_filter(reader, true), has_truth);
+    const ahrs_config_t madgwick = {.algorithm = AHRS_ALGO_MADGWICK, .beta = 0.05f};
+    const ahrs_config_t mahony = {.algorithm = AHRS_ALGO_MAHONY, .kp = 1.0f, .ki = 0.01f};
+    report("ahrs madgwick", replay_ahrs(&madgwick), has_truth);
+    report("ahrs mahony", replay_ahrs(&mahony), has_truth);
+
+    imu_record_reader_close(reader);
+    free(s_replay);
+    free(s_dt);
+    free(s_roll);
+    free(s_pitch);
+    free(loaded);
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * 互补滤波单次更新耗时（ns）：浮点输入（已换算好的 g、°/s）与原始采样输入。
+ * 与 test_mpu6050_filter 一样分别链接浮点版与定点版驱动；在开发机上只比较相对开销，
+ * 板上的周期数取决于 FPU 与 64 位除法的实现。
+ */
+
+#include <math.h>
+
+#include "mpu6050.h"
+#include "test_util.h"
+
+#define SAMPLES 1024
+#define ROUNDS 2000
+#define DT_US 1000
+
+#if CONFIG_MPU6050_FIXED_POINT_FILTER
+#define FILTER_NAME "fixed-point"
+#else
+#define FILTER_NAME "float"
+#endif
+
+static mpu6050_raw_motion_value_t s_raw[SAMPLES];
+static mpu6050_acce_value_t s_acce[SAMPLES];
+static mpu6050_gyro_value_t s_gyro[SAMPLES];
+
+int main(void)
+{
+    mpu6050_handle_t dev = mpu6050_create(NULL, 0x68);
+    if (!dev)
+    {
+        return 1;
+    }
+
+    for (int k = 0; k < SAMPLES; k++)
+    {
+        const double t = k * 1e-3;
+        s_raw[k].raw_acce.raw_acce_x = (int16_t)lround(3000 * sin(2 * M_PI * 3 * t));
+        s_raw[k].raw_acce.raw_acce_y = (int16_t)lround(4000 * cos(2 * M_PI * 2 * t));
+        s_raw[k].raw_acce.raw_acce_z = 15000;
+        s_raw[k].raw_gyro.raw_gyro_x = (int16_t)lround(2000 * cos(2 * M_PI * 3 * t));
+        s_raw[k].raw_gyro.raw_gyro_y = (int16_t)lround(-1500 * sin(2 * M_PI * 2 * t));
+        mpu6050_temp_value_t temp;
+        mpu6050_convert_motion(dev, &s_raw[k], &s_acce[k], &s_gyro[k], &temp);
+    }
+
+    complimentary_angle_t angle = {0};
+    int64_t ts = 0;
+    const int64_t n = (int64_t)SAMPLES * ROUNDS;
+
+    int64_t t0 = bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        for (int k = 0; k < SAMPLES; k++)
+        {
+            ts += DT_US;
+            mpu6050_complimentory_filter(dev, &s_acce[k], &s_gyro[k], ts, &angle);
+        }
+    }
+    const double float_ns = (double)(bench_now_ns() - t0) / n;
+    BENCH_SINK(angle.roll * 1000);
+
+    t0 = bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        for (int k = 0; k < SAMPLES; k++)
+        {
+            ts += DT_US;
+            mpu6050_complimentory_filter_raw(dev, &s_raw[k], ts, &angle);
+        }
+    }
+    const double raw_ns = (double)(bench_now_ns() - t0) / n;
+    BENCH_SINK(angle.pitch * 1000);
+
+    printf(FILTER_NAME " complementary filter, %lld updates\n", (long long)n);
+    printf("  float input: %7.1f ns/update\n", float_ns);
+    printf("  raw input:   %7.1f ns/update\n", raw_ns);
+
+    mpu6050_delete(dev);
+    return 0;
+}
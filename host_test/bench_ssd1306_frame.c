@@ -0,0 +1,128 @@
+/**
+ * ssd1306 绘图原语每秒调用数：每个原语各自加锁的版本，与 begin_frame/_nolock/end_frame
+ * 整帧只加一次锁的版本。帧内容仿照 UI 任务，每帧 31 个原语；另测每帧 1024 次画点的位图式页面。
+ * 主机上的互斥锁是 pthread 实现，绝对数值与板上不同，只看两者的比值。
+ */
+
+#include "ssd1306.h"
+#include "ssd1306_private.h"
+#include "test_util.h"
+
+#define FRAMES 20000
+#define UI_PRIMITIVES 31
+#define PIXEL_FRAMES 500
+#define PIXELS_PER_FRAME 1024
+
+// 不刷新，只需要一个能通过 connect 的总线
+static esp_err_t null_send(void *ctx, const uint8_t *buf, size_t n)
+{
+    return ESP_OK;
+}
+
+static const ssd1306_bus_vt_t s_null_vt = {
+    .send_cmd = null_send,
+    .send_data = null_send,
+    .reset = NULL,
+};
+
+esp_err_t ssd1306_bind_i2c(i2c_master_bus_handle_t bus, struct ssd1306_t *d, i2c_port_num_t port,
+                           uint8_t addr, gpio_num_t rst_gpio, bool zero_copy, uint16_t max_chunk)
+{
+    d->vt = &s_null_vt;
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_unbind_i2c(struct ssd1306_t *d)
+{
+    return ESP_OK;
+}
+
+static void ui_frame_per_call(ssd1306_handle_t h)
+{
+    ssd1306_clear(h);
+    ssd1306_draw_text(h, 2, 4, "MPU6050", true);
+    ssd1306_draw_rect(h, 0, 0, 127, 15, false);
+    for (int i = 0; i < 10; i++)
+    {
+        ssd1306_draw_line(h, 100, 40, 100 + i, 50, true);
+        ssd1306_draw_circle(h, 100, 40, 3 + i, false);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        ssd1306_draw_pixel(h, i, 60, true);
+    }
+}
+
+static void ui_frame_batched(ssd1306_handle_t h)
+{
+    ssd1306_begin_frame(h);
+    ssd1306_clear_nolock(h);
+    ssd1306_draw_text_nolock(h, 2, 4, "MPU6050", true);
+    ssd1306_draw_rect_nolock(h, 0, 0, 127, 15, false);
+    for (int i = 0; i < 10; i++)
+    {
+        ssd1306_draw_line_nolock(h, 100, 40, 100 + i, 50, true);
+        ssd1306_draw_circle_nolock(h, 100, 40, 3 + i, false);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        ssd1306_draw_pixel_nolock(h, i, 60, true);
+    }
+    ssd1306_end_frame(h);
+}
+
+static void pixel_frame_per_call(ssd1306_handle_t h)
+{
+    for (int i = 0; i < PIXELS_PER_FRAME; i++)
+    {
+        ssd1306_draw_pixel(h, i & 127, i >> 4, (i & 1) != 0);
+    }
+}
+
+static void pixel_frame_batched(ssd1306_handle_t h)
+{
+    ssd1306_begin_frame(h);
+    for (int i = 0; i < PIXELS_PER_FRAME; i++)
+    {
+        ssd1306_draw_pixel_nolock(h, i & 127, i >> 4, (i & 1) != 0);
+    }
+    ssd1306_end_frame(h);
+}
+
+// 返回每秒原语数
+static double bench(ssd1306_handle_t h, void (*frame)(ssd1306_handle_t), int frames, int per_frame)
+{
+    const int64_t t0 = bench_now_ns();
+    for (int f = 0; f < frames; f++)
+    {
+        frame(h);
+    }
+    const int64_t ns = bench_now_ns() - t0;
+    BENCH_SINK(h->fb[ns & 1023]);
+    return (double)frames * per_frame * 1e9 / (double)ns;
+}
+
+int main(void)
+{
+    const ssd1306_config_t cfg = {.width = 128, .height = 64, .rst_gpio = GPIO_NUM_NC, .addr = 0x3C};
+    ssd1306_handle_t h = NULL;
+    if (ESP_OK != ssd1306_connect_i2c(NULL, &cfg, &h))
+    {
+        return 1;
+    }
+
+    const double ui_locked = bench(h, ui_frame_per_call, FRAMES, UI_PRIMITIVES);
+    const double ui_batched = bench(h, ui_frame_batched, FRAMES, UI_PRIMITIVES);
+    const double px_locked = bench(h, pixel_frame_per_call, PIXEL_FRAMES, PIXELS_PER_FRAME);
+    const double px_batched = bench(h, pixel_frame_batched, PIXEL_FRAMES, PIXELS_PER_FRAME);
+
+    printf("ssd1306 primitives per second\n");
+    printf("  UI frame (%d primitives), %d frames\n", UI_PRIMITIVES, FRAMES);
+    printf("    per-call: %12.0f\n", ui_locked);
+    printf("    batched:  %12.0f  (x%.2f)\n", ui_batched, ui_batched / ui_locked);
+    printf("  pixels (%d per frame), %d frames\n", PIXELS_PER_FRAME, PIXEL_FRAMES);
+    printf("    per-call: %12.0f\n", px_locked);
+    printf("    batched:  %12.0f  (x%.2f)\n", px_batched, px_batched / px_locked);
+    ssd1306_del(h);
+    return 0;
+}
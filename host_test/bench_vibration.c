@@ -0,0 +1,65 @@
+/**
+ * vibration 每窗耗时（ns）：加载窗口（去直流、加窗、归一化、位反序）、全部蝶形级与频谱统计，
+ * 另给出单个蝶形级的平均耗时，即 vib_process(vib, 1, ...) 在采集任务间隙占用 CPU 的时长。
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "test_util.h"
+#include "vibration.h"
+
+#define FS_HZ 1000.0f
+#define SENS 8192.0f
+#define ROUNDS 4000
+
+static mpu6050_sample_t s_samples[VIB_FFT_SIZE];
+
+int main(void)
+{
+    for (int n = 0; n < VIB_FFT_SIZE; n++)
+    {
+        const float t = n / FS_HZ;
+        const float g = 1.0f + 0.2f * sinf(2 * (float)M_PI * 78.0f * t) + 0.05f * sinf(2 * (float)M_PI * 210.0f * t);
+        s_samples[n].timestamp_us = n * 1000;
+        s_samples[n].raw.raw_acce.raw_acce_z = (int16_t)lroundf(g * SENS);
+    }
+
+    const vib_config_t cfg = {
+        .sample_rate_hz = FS_HZ,
+        .acce_sensitivity = SENS,
+        .axis = VIB_AXIS_Z,
+        .band_count = 3,
+        .band_edges_hz = {0.0f, 40.0f, 100.0f, 500.0f},
+    };
+    vib_handle_t vib = vib_create(&cfg);
+    if (!vib)
+    {
+        return 1;
+    }
+
+    // hop 为整窗，每次送入 VIB_FFT_SIZE 个采样正好触发一次加载
+    int64_t push_ns = 0;
+    int64_t fft_ns = 0;
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        const int64_t t0 = bench_now_ns();
+        vib_push(vib, s_samples, VIB_FFT_SIZE);
+        const int64_t t1 = bench_now_ns();
+        vib_process(vib, VIB_FFT_STAGES, NULL);
+        fft_ns += bench_now_ns() - t1;
+        push_ns += t1 - t0;
+    }
+
+    vib_result_t result;
+    vib_get_result(vib, &result);
+    BENCH_SINK(result.dominant_hz);
+    printf("vibration, %d-point window, %d windows\n", VIB_FFT_SIZE, ROUNDS);
+    printf("  push+load:    %8.1f ns/window (%.2f ns/sample)\n", (double)push_ns / ROUNDS,
+           (double)push_ns / ROUNDS / VIB_FFT_SIZE);
+    printf("  fft+stats:    %8.1f ns/window\n", (double)fft_ns / ROUNDS);
+    printf("  per stage:    %8.1f ns (incl. stats share)\n", (double)fft_ns / ROUNDS / VIB_FFT_STAGES);
+    printf("  dominant %.2f Hz, %.3f g\n", result.dominant_hz, result.dominant_amp_g);
+    vib_delete(vib);
+    return 0;
+}
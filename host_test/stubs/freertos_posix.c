@@ -0,0 +1,406 @@
+/**
+ * FreeRTOS 替身：任务为 pthread，信号量与任务通知由互斥锁 + 条件变量实现。
+ * 优先级只记录不调度，测试可以用 uxTaskPriorityGet() 检查组件对优先级的调整。
+ * 互斥锁按 FreeRTOS 的规则做优先级继承：阻塞等待时把持有者提升到等待者的优先级，
+ * 持有者释放全部互斥锁后回到基础优先级；等待超时不回退（FreeRTOS 会降到剩余等待者的最高值）。
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+struct QueueDefinition
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    UBaseType_t count;
+    UBaseType_t max;
+    TaskHandle_t owner; // 递归互斥锁的持有者与嵌套深度
+    UBaseType_t depth;
+    bool is_mutex;
+    TaskHandle_t holder; // 互斥锁的持有者，用于优先级继承
+};
+
+struct tskTaskControlBlock
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify;
+    UBaseType_t priority;      // 当前优先级，可能是继承来的
+    UBaseType_t base_priority; // vTaskPrioritySet() 设置的优先级
+    UBaseType_t mutexes_held;
+    TaskFunction_t entry;
+    void *arg;
+};
+
+static pthread_mutex_t s_critical = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static __thread struct tskTaskControlBlock *s_self;
+
+static void cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+// 在 lock 已持有时等待 cond，deadline 为 NULL 时不超时；超时返回 false
+static bool cond_wait_ticks(pthread_cond_t *cond, pthread_mutex_t *lock, const struct timespec *deadline)
+{
+    if (NULL == deadline)
+    {
+        pthread_cond_wait(cond, lock);
+        return true;
+    }
+    return 0 == pthread_cond_timedwait(cond, lock, deadline);
+}
+
+static const struct timespec *deadline_after(TickType_t ticks, struct timespec *ts)
+{
+    if (portMAX_DELAY == ticks)
+    {
+        return NULL;
+    }
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += ticks / 1000;
+    ts->tv_nsec += (long)(ticks % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L)
+    {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+void vPortEnterCritical(portMUX_TYPE *mux)
+{
+    (void)mux;
+    pthread_mutex_lock(&s_critical);
+}
+
+void vPortExitCritical(portMUX_TYPE *mux)
+{
+    (void)mux;
+    pthread_mutex_unlock(&s_critical);
+}
+
+static SemaphoreHandle_t sem_create(UBaseType_t max, UBaseType_t initial)
+{
+    SemaphoreHandle_t sem = calloc(1, sizeof(*sem));
+    if (sem)
+    {
+        pthread_mutex_init(&sem->lock, NULL);
+        cond_init(&sem->cond);
+        sem->count = initial;
+        sem->max = max;
+    }
+    return sem;
+}
+
+static SemaphoreHandle_t mutex_create(void)
+{
+    SemaphoreHandle_t sem = sem_create(1, 1);
+    if (sem)
+    {
+        sem->is_mutex = true;
+    }
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return mutex_create();
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+    return mutex_create();
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return sem_create(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount)
+{
+    return sem_create(uxMaxCount, uxInitialCount);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime)
+{
+    struct timespec ts;
+    const struct timespec *deadline = deadline_after(xBlockTime, &ts);
+    BaseType_t ret = pdTRUE;
+
+    struct tskTaskControlBlock *self = xSemaphore->is_mutex ? xTaskGetCurrentTaskHandle() : NULL;
+    const UBaseType_t self_priority = self ? uxTaskPriorityGet(self) : 0;
+
+    pthread_mutex_lock(&xSemaphore->lock);
+    while (0 == xSemaphore->count)
+    {
+        if (0 == xBlockTime)
+        {
+            ret = pdFALSE;
+            break;
+        }
+        struct tskTaskControlBlock *holder = xSemaphore->holder;
+        if (holder)
+        {
+            // 锁顺序：信号量锁 -> 任务锁
+            pthread_mutex_lock(&holder->lock);
+            if (holder->priority < self_priority)
+            {
+                holder->priority = self_priority;
+            }
+            pthread_mutex_unlock(&holder->lock);
+        }
+        if (!cond_wait_ticks(&xSemaphore->cond, &xSemaphore->lock, deadline))
+        {
+            ret = pdFALSE;
+            break;
+        }
+    }
+    if (pdTRUE == ret)
+    {
+        xSemaphore->count--;
+        if (self)
+        {
+            xSemaphore->holder = self;
+            pthread_mutex_lock(&self->lock);
+            self->mutexes_held++;
+            pthread_mutex_unlock(&self->lock);
+        }
+    }
+    pthread_mutex_unlock(&xSemaphore->lock);
+    return ret;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore)
+{
+    BaseType_t ret = pdFALSE;
+
+    pthread_mutex_lock(&xSemaphore->lock);
+    if (xSemaphore->count < xSemaphore->max)
+    {
+        struct tskTaskControlBlock *holder = xSemaphore->holder;
+        if (holder)
+        {
+            xSemaphore->holder = NULL;
+            pthread_mutex_lock(&holder->lock);
+            if (0 == --holder->mutexes_held)
+            {
+                holder->priority = holder->base_priority;
+            }
+            pthread_mutex_unlock(&holder->lock);
+        }
+        xSemaphore->count++;
+        pthread_cond_signal(&xSemaphore->cond);
+        ret = pdTRUE;
+    }
+    pthread_mutex_unlock(&xSemaphore->lock);
+    return ret;
+}
+
+// owner/depth 只由持有者自己修改，其他任务读到的旧值不会等于它们自己的句柄
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xBlockTime)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    if (__atomic_load_n(&xMutex->owner, __ATOMIC_RELAXED) == self)
+    {
+        xMutex->depth++;
+        return pdTRUE;
+    }
+    if (pdTRUE != xSemaphoreTake(xMutex, xBlockTime))
+    {
+        return pdFALSE;
+    }
+    __atomic_store_n(&xMutex->owner, self, __ATOMIC_RELAXED);
+    xMutex->depth = 1;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex)
+{
+    if (__atomic_load_n(&xMutex->owner, __ATOMIC_RELAXED) != xTaskGetCurrentTaskHandle())
+    {
+        return pdFALSE;
+    }
+    if (0 == --xMutex->depth)
+    {
+        __atomic_store_n(&xMutex->owner, NULL, __ATOMIC_RELAXED);
+        xSemaphoreGive(xMutex);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    if (pxHigherPriorityTaskWoken)
+    {
+        *pxHigherPriorityTaskWoken = pdFALSE;
+    }
+    return xSemaphoreGive(xSemaphore);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore)
+{
+    if (xSemaphore)
+    {
+        pthread_cond_destroy(&xSemaphore->cond);
+        pthread_mutex_destroy(&xSemaphore->lock);
+        free(xSemaphore);
+    }
+}
+
+static struct tskTaskControlBlock *tcb_create(TaskFunction_t entry, void *arg, UBaseType_t priority)
+{
+    struct tskTaskControlBlock *tcb = calloc(1, sizeof(*tcb));
+    if (tcb)
+    {
+        pthread_mutex_init(&tcb->lock, NULL);
+        cond_init(&tcb->cond);
+        tcb->priority = priority;
+        tcb->base_priority = priority;
+        tcb->entry = entry;
+        tcb->arg = arg;
+    }
+    return tcb;
+}
+
+static void *task_trampoline(void *arg)
+{
+    s_self = arg;
+    s_self->entry(s_self->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask)
+{
+    (void)pcName;
+    (void)usStackDepth;
+    struct tskTaskControlBlock *tcb = tcb_create(pxTaskCode, pvParameters, uxPriority);
+    if (NULL == tcb)
+    {
+        return pdFAIL;
+    }
+    if (pxCreatedTask)
+    {
+        *pxCreatedTask = tcb;
+    }
+    if (0 != pthread_create(&tcb->thread, NULL, task_trampoline, tcb))
+    {
+        free(tcb);
+        return pdFAIL;
+    }
+    pthread_detach(tcb->thread);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char *pcName, uint32_t usStackDepth,
+                                   void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask,
+                                   BaseType_t xCoreID)
+{
+    (void)xCoreID;
+    return xTaskCreate(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask);
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete)
+{
+    // 控制块不释放：其他线程此后仍可能对旧句柄发通知
+    (void)xTaskToDelete;
+    pthread_exit(NULL);
+}
+
+void vTaskDelay(TickType_t xTicksToDelay)
+{
+    usleep((useconds_t)xTicksToDelay * 1000u);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if (NULL == s_self)
+    {
+        s_self = tcb_create(NULL, NULL, 1); // 主线程或测试自建的线程
+        s_self->thread = pthread_self();
+    }
+    return s_self;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask)
+{
+    struct tskTaskControlBlock *tcb = xTask ? xTask : xTaskGetCurrentTaskHandle();
+    pthread_mutex_lock(&tcb->lock);
+    UBaseType_t priority = tcb->priority;
+    pthread_mutex_unlock(&tcb->lock);
+    return priority;
+}
+
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority)
+{
+    struct tskTaskControlBlock *tcb = xTask ? xTask : xTaskGetCurrentTaskHandle();
+    pthread_mutex_lock(&tcb->lock);
+    // 与 FreeRTOS 相同：改的是基础优先级，继承来的更高优先级保持到释放互斥锁为止
+    if (tcb->priority == tcb->base_priority || uxNewPriority > tcb->priority)
+    {
+        tcb->priority = uxNewPriority;
+    }
+    tcb->base_priority = uxNewPriority;
+    pthread_mutex_unlock(&tcb->lock);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    struct tskTaskControlBlock *tcb = xTaskGetCurrentTaskHandle();
+    struct timespec ts;
+    const struct timespec *deadline = deadline_after(xTicksToWait, &ts);
+
+    pthread_mutex_lock(&tcb->lock);
+    while (0 == tcb->notify && 0 != xTicksToWait)
+    {
+        if (!cond_wait_ticks(&tcb->cond, &tcb->lock, deadline))
+        {
+            break;
+        }
+    }
+    const uint32_t value = tcb->notify;
+    if (value)
+    {
+        tcb->notify = xClearCountOnExit ? 0 : value - 1;
+    }
+    pthread_mutex_unlock(&tcb->lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+    pthread_mutex_lock(&xTaskToNotify->lock);
+    xTaskToNotify->notify++;
+    pthread_cond_signal(&xTaskToNotify->cond);
+    pthread_mutex_unlock(&xTaskToNotify->lock);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    if (pxHigherPriorityTaskWoken)
+    {
+        *pxHigherPriorityTaskWoken = pdFALSE;
+    }
+    xTaskNotifyGive(xTaskToNotify);
+}
@@ -0,0 +1,157 @@
+/**
+ * esp_timer / esp_rom / esp_err 的主机实现
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include "esp_err.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+struct esp_timer
+{
+    esp_timer_create_args_t args;
+    pthread_t thread;
+    uint64_t period_us;
+    atomic_bool running;
+};
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void esp_rom_delay_us(uint32_t us)
+{
+    usleep(us);
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:
+        return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED:
+        return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_RESPONSE:
+        return "ESP_ERR_INVALID_RESPONSE";
+    case ESP_ERR_INVALID_CRC:
+        return "ESP_ERR_INVALID_CRC";
+    case ESP_ERR_INVALID_VERSION:
+        return "ESP_ERR_INVALID_VERSION";
+    default:
+        return "UNKNOWN ERROR";
+    }
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle)
+{
+    if (NULL == create_args || NULL == create_args->callback || NULL == out_handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct esp_timer *timer = calloc(1, sizeof(*timer));
+    if (NULL == timer)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    timer->args = *create_args;
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+static void *timer_thread(void *arg)
+{
+    struct esp_timer *timer = arg;
+    int64_t next = esp_timer_get_time() + (int64_t)timer->period_us;
+
+    while (atomic_load(&timer->running))
+    {
+        const int64_t wait = next - esp_timer_get_time();
+        if (wait > 0)
+        {
+            usleep((useconds_t)wait);
+        }
+        if (!atomic_load(&timer->running))
+        {
+            break;
+        }
+        timer->args.callback(timer->args.arg);
+        next += (int64_t)timer->period_us;
+    }
+    return NULL;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period)
+{
+    if (NULL == timer || 0 == period)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (atomic_load(&timer->running))
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->period_us = period;
+    atomic_store(&timer->running, true);
+    if (0 != pthread_create(&timer->thread, NULL, timer_thread, timer))
+    {
+        atomic_store(&timer->running, false);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (NULL == timer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!atomic_exchange(&timer->running, false))
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!pthread_equal(pthread_self(), timer->thread))
+    {
+        pthread_join(timer->thread, NULL);
+    }
+    else
+    {
+        pthread_detach(timer->thread); // 回调里停止自身
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (NULL == timer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (atomic_load(&timer->running))
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    free(timer);
+    return ESP_OK;
+}
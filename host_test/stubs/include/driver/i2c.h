@@ -0,0 +1,4 @@
+#pragma once
+
+// 旧版驱动头，组件只用到其中的端口与新版 i2c_master 类型
+#include "driver/i2c_master.h"
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "esp_err.h"
+
+typedef int i2c_port_num_t;
+
+#define I2C_NUM_0 0
+#define I2C_NUM_1 1
+
+typedef struct i2c_master_bus_t *i2c_master_bus_handle_t;
+typedef struct i2c_master_dev_t *i2c_master_dev_handle_t;
+
+typedef enum
+{
+    I2C_ADDR_BIT_LEN_7 = 0,
+    I2C_ADDR_BIT_LEN_10 = 1,
+} i2c_addr_bit_len_t;
+
+typedef enum
+{
+    I2C_CLK_SRC_DEFAULT = 0,
+} i2c_clock_source_t;
@@ -0,0 +1,4 @@
+/**
+ * 主机测试不经过 menuconfig，需要的 CONFIG_* 由 CMake 以编译定义给出
+ */
+#pragma once
@@ -0,0 +1,112 @@
+/**
+ * AHRS 欧拉角的符号约定：静止倾斜时与互补滤波的 roll 一致、pitch 相反；
+ * 绕 +Y 轴正转时 pitch 增大（右手定则）。
+ */
+
+#include <math.h>
+
+#include "ahrs.h"
+#include "mpu6050.h"
+#include "test_util.h"
+
+#define DT_S 0.01f
+
+static mpu6050_handle_t s_dev;
+
+void setUp(void)
+{
+    s_dev = mpu6050_create(NULL, 0x68); // 离线句柄，只用互补滤波
+    TEST_ASSERT(s_dev);
+}
+
+void tearDown(void)
+{
+    mpu6050_delete(s_dev);
+    s_dev = NULL;
+}
+
+// 右手定则下 roll=φ、pitch=θ 时机体坐标系中的重力方向
+static mpu6050_acce_value_t gravity_for(float roll_deg, float pitch_deg)
+{
+    const float r = roll_deg * (float)M_PI / 180, p = pitch_deg * (float)M_PI / 180;
+    const mpu6050_acce_value_t acce = {
+        .acce_x = -sinf(p),
+        .acce_y = sinf(r) * cosf(p),
+        .acce_z = cosf(r) * cosf(p),
+    };
+    return acce;
+}
+
+static void check_static_tilt(ahrs_algorithm_t algorithm)
+{
+    const ahrs_config_t cfg = {.algorithm = algorithm, .beta = 0.03f, .kp = 1.0f};
+    ahrs_handle_t ahrs = ahrs_create(&cfg);
+    TEST_ASSERT(ahrs);
+
+    const mpu6050_acce_value_t acce = gravity_for(10, 20);
+    const mpu6050_gyro_value_t gyro = {0};
+    complimentary_angle_t cf = {0};
+    for (int k = 0; k < 50; k++)
+    {
+        TEST_ASSERT_ESP_OK(ahrs_update(ahrs, &acce, &gyro, DT_S));
+        TEST_ASSERT_ESP_OK(mpu6050_complimentory_filter(s_dev, &acce, &gyro, 1000 + k * 10000, &cf));
+    }
+
+    ahrs_euler_t euler;
+    TEST_ASSERT_ESP_OK(ahrs_get_euler(ahrs, &euler));
+    ahrs_delete(ahrs);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 10.0, euler.roll);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 20.0, euler.pitch);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 0.0, euler.yaw);
+    // 互补滤波：roll 相同，pitch 取 atan2(acce_x, acce_z) 后反号（且不是 asin 形式）
+    TEST_ASSERT_FLOAT_WITHIN(0.1, euler.roll, cf.roll);
+    TEST_ASSERT(cf.pitch < 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, atan2f(acce.acce_x, acce.acce_z) * 180 / M_PI, cf.pitch);
+}
+
+static void test_static_tilt_madgwick(void)
+{
+    check_static_tilt(AHRS_ALGO_MADGWICK);
+}
+
+static void test_static_tilt_mahony(void)
+{
+    check_static_tilt(AHRS_ALGO_MAHONY);
+}
+
+static void check_positive_gyro_y_raises_pitch(ahrs_algorithm_t algorithm)
+{
+    // 增益为 0，只做陀螺仪积分：+10°/s 绕 Y 轴转 1s
+    const ahrs_config_t cfg = {.algorithm = algorithm};
+    ahrs_handle_t ahrs = ahrs_create(&cfg);
+    TEST_ASSERT(ahrs);
+
+    const mpu6050_acce_value_t level = gravity_for(0, 0);
+    const mpu6050_gyro_value_t gyro = {.gyro_y = 10.0f};
+    TEST_ASSERT_ESP_OK(ahrs_update(ahrs, &level, &gyro, DT_S)); // 由加速度初始化
+    for (int k = 0; k < 100; k++)
+    {
+        TEST_ASSERT_ESP_OK(ahrs_update(ahrs, &level, &gyro, DT_S));
+    }
+
+    ahrs_euler_t euler;
+    TEST_ASSERT_ESP_OK(ahrs_get_euler(ahrs, &euler));
+    ahrs_delete(ahrs);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 10.0, euler.pitch);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 0.0, euler.roll);
+}
+
+static void test_positive_gyro_y_raises_pitch(void)
+{
+    check_positive_gyro_y_raises_pitch(AHRS_ALGO_MADGWICK);
+    check_positive_gyro_y_raises_pitch(AHRS_ALGO_MAHONY);
+}
+
+int main(void)
+{
+    RUN_TEST(test_static_tilt_madgwick);
+    RUN_TEST(test_static_tilt_mahony);
+    RUN_TEST(test_positive_gyro_y_raises_pitch);
+    return TEST_END();
+}
@@ -0,0 +1,281 @@
+/**
+ * i2c_bus_mgr 的仲裁：总线使用权是互斥锁，高优先级任务来等待时，持有总线的低优先级任务由内核
+ * 提升到等待者的优先级，释放后恢复；高优先级设备的事务先于低优先级设备，即使后者的任务优先级更高；
+ * 持有者另外持有的互斥锁所继承的优先级不受影响，也不会被写成基础优先级。
+ * 模拟层只记录优先级不调度，测试在持有总线期间（模拟器写回调里）用 uxTaskPriorityGet() 检查。
+ */
+
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "driver/i2c_master.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "i2c_bus_mgr.h"
+#include "mpu6050_sim.h"
+#include "test_util.h"
+
+#define DISP_ADDR 0x3C // 第二个模拟器只当作占用总线的显示屏
+#define IMU_ADDR 0x68
+#define REG_SMPLRT_DIV 0x19
+#define REG_CONFIG 0x1A
+#define DISP_TASK_PRIO 4
+
+static i2c_master_bus_handle_t s_bus;
+static mpu6050_sim_handle_t s_disp_sim;
+static mpu6050_sim_handle_t s_imu_sim;
+static i2c_master_dev_handle_t s_disp; // LOW
+static i2c_master_dev_handle_t s_imu;  // HIGH
+static i2c_master_dev_handle_t s_log;  // LOW，与 IMU 同一地址
+
+// 持有总线期间在显示屏写回调里执行的动作
+static void (*s_on_disp_write)(void);
+static atomic_int s_disp_writes;
+static atomic_int s_owner_prio_seen; // 写回调里看到的持有者优先级
+static char s_imu_order[8];            // IMU 模拟器依次收到的写入：A 写 SMPLRT_DIV，B 写 CONFIG
+static atomic_int s_imu_order_len;
+
+typedef struct
+{
+    i2c_master_dev_handle_t dev;
+    uint8_t reg;
+    esp_err_t ret;
+    UBaseType_t prio_after; // 事务返回后自己的优先级
+    SemaphoreHandle_t done;
+} bus_user_t;
+
+static bus_user_t s_user_a;
+static bus_user_t s_user_b;
+
+static void disp_write_cb(uint8_t reg, uint8_t value, void *ctx)
+{
+    if (1 == atomic_fetch_add(&s_disp_writes, 1) + 1 && s_on_disp_write)
+    {
+        s_on_disp_write();
+    }
+}
+
+static void imu_write_cb(uint8_t reg, uint8_t value, void *ctx)
+{
+    const int n = atomic_fetch_add(&s_imu_order_len, 1);
+    if (n < (int)sizeof(s_imu_order) - 1)
+    {
+        s_imu_order[n] = REG_SMPLRT_DIV == reg ? 'A' : 'B';
+    }
+}
+
+static void bus_user_task(void *arg)
+{
+    bus_user_t *u = arg;
+    const uint8_t buf[2] = {u->reg, 9};
+    u->ret = i2c_mgr_transmit(u->dev, buf, sizeof(buf), 1000);
+    u->prio_after = uxTaskPriorityGet(NULL);
+    xSemaphoreGive(u->done);
+    vTaskDelete(NULL);
+}
+
+static void start_user(bus_user_t *u, i2c_master_dev_handle_t dev, uint8_t reg, UBaseType_t prio)
+{
+    u->dev = dev;
+    u->reg = reg;
+    u->ret = ESP_FAIL;
+    TEST_ASSERT(pdPASS == xTaskCreate(bus_user_task, "bus_user", 4096, u, prio, NULL));
+}
+
+static void join_user(bus_user_t *u)
+{
+    TEST_ASSERT(pdTRUE == xSemaphoreTake(u->done, pdMS_TO_TICKS(2000)));
+}
+
+// 等当前任务的优先级变为 expected（等待者登记后才会提升），返回最后看到的值
+static UBaseType_t wait_own_priority(UBaseType_t expected)
+{
+    UBaseType_t prio = uxTaskPriorityGet(NULL);
+    for (int i = 0; i < 2000 && prio != expected; i++)
+    {
+        usleep(1000);
+        prio = uxTaskPriorityGet(NULL);
+    }
+    return prio;
+}
+
+static void add_device(uint16_t addr, const char *name, i2c_mgr_priority_t prio, i2c_master_dev_handle_t *ret)
+{
+    const i2c_device_config_t dev_cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = addr,
+        .scl_speed_hz = 400000,
+    };
+    const i2c_mgr_device_config_t mgr_cfg = {.name = name, .priority = prio};
+    TEST_ASSERT_ESP_OK(i2c_mgr_add_device(s_bus, &dev_cfg, &mgr_cfg, ret));
+}
+
+void setUp(void)
+{
+    const mpu6050_sim_config_t disp_cfg = {.address = DISP_ADDR, .temp_c = 25.0f};
+    const mpu6050_sim_config_t imu_cfg = {.address = IMU_ADDR, .temp_c = 25.0f};
+    s_disp_sim = mpu6050_sim_create(&disp_cfg);
+    s_imu_sim = mpu6050_sim_create(&imu_cfg);
+    TEST_ASSERT(s_disp_sim && s_imu_sim);
+    TEST_ASSERT_ESP_OK(mpu6050_sim_attach(s_disp_sim));
+    TEST_ASSERT_ESP_OK(mpu6050_sim_attach(s_imu_sim));
+    mpu6050_sim_set_write_callback(s_disp_sim, disp_write_cb, NULL);
+    mpu6050_sim_set_write_callback(s_imu_sim, imu_write_cb, NULL);
+
+    const i2c_master_bus_config_t bus_cfg = {.i2c_port = I2C_NUM_0};
+    TEST_ASSERT_ESP_OK(i2c_new_master_bus(&bus_cfg, &s_bus));
+    add_device(DISP_ADDR, "ssd1306", I2C_MGR_PRIO_LOW, &s_disp);
+    add_device(IMU_ADDR, "mpu6050", I2C_MGR_PRIO_HIGH, &s_imu);
+    add_device(IMU_ADDR, "logger", I2C_MGR_PRIO_LOW, &s_log);
+
+    s_on_disp_write = NULL;
+    atomic_store(&s_disp_writes, 0);
+    atomic_store(&s_owner_prio_seen, -1);
+    memset(s_imu_order, 0, sizeof(s_imu_order));
+    atomic_store(&s_imu_order_len, 0);
+    if (!s_user_a.done)
+    {
+        s_user_a.done = xSemaphoreCreateBinary();
+        s_user_b.done = xSemaphoreCreateBinary();
+    }
+    vTaskPrioritySet(NULL, DISP_TASK_PRIO);
+}
+
+void tearDown(void)
+{
+    mpu6050_sim_set_write_callback(s_disp_sim, NULL, NULL);
+    mpu6050_sim_set_write_callback(s_imu_sim, NULL, NULL);
+    i2c_mgr_rm_device(s_disp);
+    i2c_mgr_rm_device(s_imu);
+    i2c_mgr_rm_device(s_log);
+    i2c_del_master_bus(s_bus);
+    s_bus = NULL;
+    mpu6050_sim_delete(s_disp_sim);
+    mpu6050_sim_delete(s_imu_sim);
+    s_disp_sim = s_imu_sim = NULL;
+}
+
+// 显示屏任务写一个寄存器，写回调执行时它正持有总线
+static void disp_transfer(void)
+{
+    const uint8_t buf[2] = {REG_SMPLRT_DIV, 0};
+    TEST_ASSERT_ESP_OK(i2c_mgr_transmit(s_disp, buf, sizeof(buf), 1000));
+    TEST_ASSERT_EQUAL_INT(1, atomic_load(&s_disp_writes));
+}
+
+static void record_own_priority(void)
+{
+    atomic_store(&s_owner_prio_seen, (int)uxTaskPriorityGet(NULL));
+}
+
+static void test_no_boost_without_waiters(void)
+{
+    s_on_disp_write = record_own_priority;
+    disp_transfer();
+    TEST_ASSERT_EQUAL_INT(DISP_TASK_PRIO, atomic_load(&s_owner_prio_seen));
+    TEST_ASSERT_EQUAL_INT(DISP_TASK_PRIO, uxTaskPriorityGet(NULL));
+}
+
+static void imu_waits_while_disp_owns(void)
+{
+    start_user(&s_user_a, s_imu, REG_SMPLRT_DIV, 10);
+    atomic_store(&s_owner_prio_seen, (int)wait_own_priority(10));
+}
+
+static void test_owner_inherits_waiter_priority(void)
+{
+    s_on_disp_write = imu_waits_while_disp_owns;
+    disp_transfer();
+    TEST_ASSERT_EQUAL_INT(10, atomic_load(&s_owner_prio_seen));
+    // 释放即恢复
+    TEST_ASSERT_EQUAL_INT(DISP_TASK_PRIO, uxTaskPriorityGet(NULL));
+
+    join_user(&s_user_a);
+    TEST_ASSERT_ESP_OK(s_user_a.ret);
+    TEST_ASSERT_EQUAL_INT(10, s_user_a.prio_after);
+
+    // IMU 的等待计入统计
+    i2c_mgr_report_t report;
+    i2c_mgr_get_report(&report, true);
+    const i2c_mgr_dev_stats_t *imu = NULL;
+    for (int i = 0; i < report.device_count; i++)
+    {
+        imu = 0 == strcmp("mpu6050", report.devices[i].name) ? &report.devices[i] : imu;
+    }
+    TEST_ASSERT(imu && imu->max_wait_us > 0);
+}
+
+// A 的设备优先级高但任务优先级低（5），B 相反（8）
+static void two_waiters_while_disp_owns(void)
+{
+    start_user(&s_user_a, s_imu, REG_SMPLRT_DIV, 5);
+    const UBaseType_t after_a = wait_own_priority(5);
+    start_user(&s_user_b, s_log, REG_CONFIG, 8);
+    const UBaseType_t after_b = wait_own_priority(8);
+    atomic_store(&s_owner_prio_seen, (int)(5 == after_a ? after_b : after_a));
+}
+
+static void test_high_device_goes_first(void)
+{
+    s_on_disp_write = two_waiters_while_disp_owns;
+    disp_transfer();
+    TEST_ASSERT_EQUAL_INT(8, atomic_load(&s_owner_prio_seen));
+    TEST_ASSERT_EQUAL_INT(DISP_TASK_PRIO, uxTaskPriorityGet(NULL));
+
+    // 总线先交给高优先级设备 A，B 的任务优先级虽高也要等它
+    join_user(&s_user_a);
+    join_user(&s_user_b);
+    TEST_ASSERT_ESP_OK(s_user_a.ret);
+    TEST_ASSERT_ESP_OK(s_user_b.ret);
+    TEST_ASSERT(0 == strcmp("AB", s_imu_order));
+    TEST_ASSERT_EQUAL_INT(5, s_user_a.prio_after);
+    TEST_ASSERT_EQUAL_INT(8, s_user_b.prio_after);
+}
+
+// 显示任务另外持有 UI 互斥锁，C（6）在等它
+static SemaphoreHandle_t s_ui_mutex;
+static SemaphoreHandle_t s_c_done;
+
+static void ui_user_task(void *arg)
+{
+    xSemaphoreTake(s_ui_mutex, portMAX_DELAY);
+    xSemaphoreGive(s_ui_mutex);
+    xSemaphoreGive(s_c_done);
+    vTaskDelete(NULL);
+}
+
+static void test_keeps_priority_inherited_from_other_mutex(void)
+{
+    s_ui_mutex = xSemaphoreCreateMutex();
+    s_c_done = xSemaphoreCreateBinary();
+    TEST_ASSERT(s_ui_mutex && s_c_done);
+    TEST_ASSERT(pdTRUE == xSemaphoreTake(s_ui_mutex, 0));
+    TEST_ASSERT(pdPASS == xTaskCreate(ui_user_task, "ui_user", 4096, NULL, 6, NULL));
+    TEST_ASSERT_EQUAL_INT(6, wait_own_priority(6));
+
+    s_on_disp_write = imu_waits_while_disp_owns;
+    disp_transfer();
+    TEST_ASSERT_EQUAL_INT(10, atomic_load(&s_owner_prio_seen));
+    join_user(&s_user_a);
+    TEST_ASSERT_ESP_OK(s_user_a.ret);
+    // 仍持有 UI 互斥锁，继承来的优先级还在（FreeRTOS 释放全部互斥锁后才回落）
+    TEST_ASSERT(uxTaskPriorityGet(NULL) >= 6);
+
+    // 基础优先级没有被改写，释放后回到 4
+    xSemaphoreGive(s_ui_mutex);
+    TEST_ASSERT_EQUAL_INT(DISP_TASK_PRIO, uxTaskPriorityGet(NULL));
+    TEST_ASSERT(pdTRUE == xSemaphoreTake(s_c_done, pdMS_TO_TICKS(2000)));
+    vSemaphoreDelete(s_c_done);
+    vSemaphoreDelete(s_ui_mutex);
+}
+
+int main(void)
+{
+    RUN_TEST(test_no_boost_without_waiters);
+    RUN_TEST(test_owner_inherits_waiter_priority);
+    RUN_TEST(test_high_device_goes_first);
+    RUN_TEST(test_keeps_priority_inherited_from_other_mutex);
+    return TEST_END();
+}
@@ -0,0 +1,239 @@
+/**
+ * imu_filter 的阶跃与冲激响应：浮点与 Q15 内核都与双精度转置直接 II 型参考实现逐点比较，
+ * 另外检查陷波器对中心频率的衰减，以及 process_raw 与 Q15 内核结果一致。
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "imu_filter.h"
+#include "test_util.h"
+
+#define FS_HZ 1000.0f
+#define N 600
+#define Q15_AMP 8192 // 四分之一满量程，两节级联的过冲不会饱和
+
+// 双精度 RBJ 设计 + 转置直接 II 型，作为参考
+typedef struct
+{
+    double b0, b1, b2, a1, a2;
+    double s1, s2;
+} ref_biquad_t;
+
+static void ref_design(const imu_filter_stage_config_t *stage, double fs, ref_biquad_t *r)
+{
+    const double w0 = 2.0 * M_PI * stage->freq_hz / fs;
+    const double cw = cos(w0);
+    const double alpha = sin(w0) / (2.0 * stage->q);
+    const double a0 = 1.0 + alpha;
+    if (IMU_FILTER_LOWPASS == stage->type)
+    {
+        r->b0 = (1.0 - cw) * 0.5 / a0;
+        r->b1 = (1.0 - cw) / a0;
+        r->b2 = r->b0;
+    }
+    else
+    {
+        r->b0 = 1.0 / a0;
+        r->b1 = -2.0 * cw / a0;
+        r->b2 = 1.0 / a0;
+    }
+    r->a1 = -2.0 * cw / a0;
+    r->a2 = (1.0 - alpha) / a0;
+    r->s1 = r->s2 = 0;
+}
+
+static void ref_run(const imu_filter_config_t *cfg, const double *in, double *out, size_t count)
+{
+    ref_biquad_t st[IMU_FILTER_MAX_STAGES];
+    for (int i = 0; i < cfg->stage_count; i++)
+    {
+        ref_design(&cfg->stages[i], cfg->sample_rate_hz, &st[i]);
+    }
+    for (size_t n = 0; n < count; n++)
+    {
+        double x = in[n];
+        for (int i = 0; i < cfg->stage_count; i++)
+        {
+            ref_biquad_t *r = &st[i];
+            const double y = r->b0 * x + r->s1;
+            r->s1 = r->b1 * x - r->a1 * y + r->s2;
+            r->s2 = r->b2 * x - r->a2 * y;
+            x = y;
+        }
+        out[n] = x;
+    }
+}
+
+// 两节 30Hz 巴特沃斯低通（四阶）
+static const imu_filter_config_t s_lowpass = {
+    .sample_rate_hz = FS_HZ,
+    .stage_count = 2,
+    .stages = {
+        {.type = IMU_FILTER_LOWPASS, .freq_hz = 30.0f, .q = 0.7071f},
+        {.type = IMU_FILTER_LOWPASS, .freq_hz = 30.0f, .q = 0.7071f},
+    },
+};
+
+// 120Hz 陷波 + 80Hz 低通
+static const imu_filter_config_t s_notch = {
+    .sample_rate_hz = FS_HZ,
+    .stage_count = 2,
+    .stages = {
+        {.type = IMU_FILTER_NOTCH, .freq_hz = 120.0f, .q = 5.0f},
+        {.type = IMU_FILTER_LOWPASS, .freq_hz = 80.0f, .q = 0.7071f},
+    },
+};
+
+static imu_filter_handle_t s_filter;
+static double s_in[N], s_ref[N];
+static float s_f32[IMU_FILTER_CHANNELS][N];
+static int16_t s_q15[IMU_FILTER_CHANNELS][N];
+
+void setUp(void)
+{
+    s_filter = NULL;
+}
+
+void tearDown(void)
+{
+    imu_filter_delete(s_filter);
+}
+
+// 同一输入送入全部六个通道，参考输出写入 s_ref
+static void run_all(const imu_filter_config_t *cfg, double amp)
+{
+    s_filter = imu_filter_create(cfg);
+    TEST_ASSERT(s_filter);
+    ref_run(cfg, s_in, s_ref, N);
+
+    float *f32[IMU_FILTER_CHANNELS];
+    int16_t *q15[IMU_FILTER_CHANNELS];
+    for (int ch = 0; ch < IMU_FILTER_CHANNELS; ch++)
+    {
+        for (int n = 0; n < N; n++)
+        {
+            s_f32[ch][n] = (float)s_in[n];
+            s_q15[ch][n] = (int16_t)lround(s_in[n] * amp);
+        }
+        f32[ch] = s_f32[ch];
+        q15[ch] = s_q15[ch];
+    }
+    // 分两批处理，确认状态在批次之间延续
+    TEST_ASSERT_ESP_OK(imu_filter_process_f32(s_filter, f32, N / 3));
+    TEST_ASSERT_ESP_OK(imu_filter_process_q15(s_filter, q15, N / 3));
+    for (int ch = 0; ch < IMU_FILTER_CHANNELS; ch++)
+    {
+        f32[ch] += N / 3;
+        q15[ch] += N / 3;
+    }
+    TEST_ASSERT_ESP_OK(imu_filter_process_f32(s_filter, f32, N - N / 3));
+    TEST_ASSERT_ESP_OK(imu_filter_process_q15(s_filter, q15, N - N / 3));
+}
+
+// f32_tol 相对输入幅度 1.0，q15_tol 为 LSB
+static void check_against_ref(double amp, double f32_tol, double q15_tol)
+{
+    for (int ch = 0; ch < IMU_FILTER_CHANNELS; ch++)
+    {
+        for (int n = 0; n < N; n++)
+        {
+            TEST_ASSERT_FLOAT_WITHIN(f32_tol, s_ref[n], s_f32[ch][n]);
+            TEST_ASSERT_FLOAT_WITHIN(q15_tol, s_ref[n] * amp, s_q15[ch][n]);
+        }
+    }
+}
+
+static void test_lowpass_step_response(void)
+{
+    for (int n = 0; n < N; n++)
+    {
+        s_in[n] = 1.0;
+    }
+    run_all(&s_lowpass, Q15_AMP);
+    // 30Hz 时极点靠近单位圆，Q14 系数的量化误差主要体现为直流增益偏差（约 0.1%）
+    check_against_ref(Q15_AMP, 2e-5, 16);
+    // 直流增益为 1
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 1.0, s_f32[0][N - 1]);
+    TEST_ASSERT_FLOAT_WITHIN(16, Q15_AMP, s_q15[0][N - 1]);
+}
+
+static void test_lowpass_impulse_response(void)
+{
+    memset(s_in, 0, sizeof(s_in));
+    s_in[0] = 1.0;
+    run_all(&s_lowpass, INT16_MAX);
+    check_against_ref(INT16_MAX, 1e-6, 8);
+}
+
+static void test_notch_rejects_center_tone(void)
+{
+    for (int n = 0; n < N; n++)
+    {
+        s_in[n] = 0.5 * sin(2 * M_PI * 120.0 * n / FS_HZ);
+    }
+    run_all(&s_notch, 2 * Q15_AMP);
+    check_against_ref(2 * Q15_AMP, 1e-6, 4);
+
+    // 建立时间之后残留幅度低于输入的 1%（-40dB）
+    float peak_f32 = 0;
+    int peak_q15 = 0;
+    for (int n = N / 2; n < N; n++)
+    {
+        peak_f32 = fmaxf(peak_f32, fabsf(s_f32[0][n]));
+        peak_q15 = abs(s_q15[0][n]) > peak_q15 ? abs(s_q15[0][n]) : peak_q15;
+    }
+    TEST_ASSERT(peak_f32 < 0.005f);
+    TEST_ASSERT(peak_q15 < 0.005 * 2 * Q15_AMP);
+}
+
+static void test_raw_frames_match_q15(void)
+{
+    // 帧数不是转置块大小的整数倍
+    enum { FRAMES = 77 };
+    s_filter = imu_filter_create(&s_notch);
+    imu_filter_handle_t soa = imu_filter_create(&s_notch);
+    TEST_ASSERT(s_filter && soa);
+
+    mpu6050_raw_motion_value_t frames[FRAMES];
+    int16_t ch_data[IMU_FILTER_CHANNELS][FRAMES];
+    for (int n = 0; n < FRAMES; n++)
+    {
+        for (int ch = 0; ch < IMU_FILTER_CHANNELS; ch++)
+        {
+            ch_data[ch][n] = (int16_t)(4000 * sin(0.3 * n + ch) + 1000 * ch);
+        }
+        frames[n].raw_acce.raw_acce_x = ch_data[0][n];
+        frames[n].raw_acce.raw_acce_y = ch_data[1][n];
+        frames[n].raw_acce.raw_acce_z = ch_data[2][n];
+        frames[n].raw_gyro.raw_gyro_x = ch_data[3][n];
+        frames[n].raw_gyro.raw_gyro_y = ch_data[4][n];
+        frames[n].raw_gyro.raw_gyro_z = ch_data[5][n];
+        frames[n].raw_temp = 1234;
+    }
+
+    int16_t *const channels[IMU_FILTER_CHANNELS] = {ch_data[0], ch_data[1], ch_data[2],
+                                                    ch_data[3], ch_data[4], ch_data[5]};
+    TEST_ASSERT_ESP_OK(imu_filter_process_q15(soa, channels, FRAMES));
+    TEST_ASSERT_ESP_OK(imu_filter_process_raw(s_filter, frames, FRAMES));
+    imu_filter_delete(soa);
+
+    for (int n = 0; n < FRAMES; n++)
+    {
+        TEST_ASSERT_EQUAL_INT(ch_data[0][n], frames[n].raw_acce.raw_acce_x);
+        TEST_ASSERT_EQUAL_INT(ch_data[2][n], frames[n].raw_acce.raw_acce_z);
+        TEST_ASSERT_EQUAL_INT(ch_data[4][n], frames[n].raw_gyro.raw_gyro_y);
+        TEST_ASSERT_EQUAL_INT(ch_data[5][n], frames[n].raw_gyro.raw_gyro_z);
+        TEST_ASSERT_EQUAL_INT(1234, frames[n].raw_temp);
+    }
+}
+
+int main(void)
+{
+    RUN_TEST(test_lowpass_step_response);
+    RUN_TEST(test_lowpass_impulse_response);
+    RUN_TEST(test_notch_rejects_center_tone);
+    RUN_TEST(test_raw_frames_match_q15);
+    return TEST_END();
+}
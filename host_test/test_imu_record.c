@@ -0,0 +1,193 @@
+/**
+ * imu_record 的写入与回放：软件零偏随头部保存、回放换算与在板上一致；
+ * sink 中途出错时写入器停止追加，读取器读出全部完整记录后在半条记录处结束；
+ * 时间戳非法的批次整批拒绝；版本 1 的文件仍可读取。
+ */
+
+#include <string.h>
+
+#include "imu_record.h"
+#include "mpu6050_calib.h"
+#include "test_util.h"
+
+#define SAMPLES 40
+#define PERIOD_US 1000
+
+// 内存 sink：fail_at 之后的字节写不进去，模拟写到一半出错的存储
+static uint8_t s_file[4096];
+static size_t s_file_len;
+static size_t s_fail_at;
+
+static esp_err_t mem_sink(void *ctx, const void *data, size_t len)
+{
+    size_t n = len;
+    if (s_file_len + n > s_fail_at)
+    {
+        n = s_fail_at - s_file_len;
+    }
+    memcpy(s_file + s_file_len, data, n);
+    s_file_len += n;
+    return n == len ? ESP_OK : ESP_FAIL;
+}
+
+static mpu6050_handle_t s_board;
+static mpu6050_sample_t s_samples[SAMPLES];
+
+static const mpu6050_calib_t s_calib = {
+    .acce_bias = {0.02f, -0.015f, 0.04f},
+    .gyro_bias = {1.25f, -0.5f, 0.75f},
+};
+
+// 在板上的驱动：±4g / ±500°/s，扣除软件零偏
+void setUp(void)
+{
+    s_file_len = 0;
+    s_fail_at = sizeof(s_file);
+    s_board = mpu6050_create(NULL, 0x68);
+    TEST_ASSERT(s_board);
+    TEST_ASSERT_ESP_OK(mpu6050_config(s_board, ACCE_FS_4G, GYRO_FS_500DPS));
+    TEST_ASSERT_ESP_OK(mpu6050_set_calibration(s_board, &s_calib));
+
+    for (int k = 0; k < SAMPLES; k++)
+    {
+        mpu6050_sample_t *s = &s_samples[k];
+        memset(s, 0, sizeof(*s));
+        s->timestamp_us = 5000000 + k * PERIOD_US + (k % 3); // 带一点抖动
+        s->raw.raw_acce.raw_acce_x = (int16_t)(100 * k - 2000);
+        s->raw.raw_acce.raw_acce_y = (int16_t)(-37 * k);
+        s->raw.raw_acce.raw_acce_z = (int16_t)(8192 + k);
+        s->raw.raw_temp = (int16_t)(-1200 + k);
+        s->raw.raw_gyro.raw_gyro_x = (int16_t)(13 * k);
+        s->raw.raw_gyro.raw_gyro_y = (int16_t)(-300 + 7 * k);
+        s->raw.raw_gyro.raw_gyro_z = (int16_t)(32767 - k);
+        TEST_ASSERT_ESP_OK(mpu6050_convert_motion(s_board, &s->raw, &s->acce, &s->gyro, &s->temp));
+    }
+}
+
+void tearDown(void)
+{
+    mpu6050_delete(s_board);
+    s_board = NULL;
+}
+
+static imu_record_writer_handle_t create_writer(size_t buffer_size)
+{
+    const imu_record_writer_config_t cfg = {.sink = mem_sink, .buffer_size = buffer_size};
+    imu_record_writer_handle_t w = imu_record_writer_create(&cfg);
+    TEST_ASSERT(w);
+    imu_record_header_t header;
+    TEST_ASSERT_ESP_OK(imu_record_header_from_sensor(s_board, s_samples[0].timestamp_us, &header));
+    TEST_ASSERT_ESP_OK(imu_record_writer_begin(w, &header));
+    return w;
+}
+
+static void assert_same_raw(const mpu6050_sample_t *e, const mpu6050_sample_t *a)
+{
+    TEST_ASSERT_EQUAL_INT(e->timestamp_us, a->timestamp_us);
+    TEST_ASSERT(0 == memcmp(&e->raw, &a->raw, sizeof(e->raw)));
+}
+
+// 读出全部记录，返回条数
+static int read_back(imu_record_header_t *header, bool convert)
+{
+    imu_record_mem_source_t src = {.data = s_file, .size = s_file_len};
+    imu_record_reader_handle_t r = NULL;
+    TEST_ASSERT_ESP_OK(imu_record_reader_open(imu_record_mem_read, &src, &r, header));
+    mpu6050_handle_t sensor = convert ? imu_record_reader_create_sensor(r) : NULL;
+    TEST_ASSERT(!convert || sensor);
+
+    int n = 0;
+    mpu6050_sample_t s;
+    esp_err_t ret;
+    while (ESP_OK == (ret = imu_record_reader_next(r, sensor, &s)))
+    {
+        TEST_ASSERT(n < SAMPLES);
+        assert_same_raw(&s_samples[n], &s);
+        if (convert)
+        {
+            // 同样的量程与零偏、同样的运算，结果逐位相同
+            TEST_ASSERT(0 == memcmp(&s_samples[n].acce, &s.acce, sizeof(s.acce)));
+            TEST_ASSERT(0 == memcmp(&s_samples[n].gyro, &s.gyro, sizeof(s.gyro)));
+        }
+        n++;
+    }
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_FOUND, ret);
+    mpu6050_delete(sensor);
+    imu_record_reader_close(r);
+    return n;
+}
+
+static void test_replay_matches_on_board(void)
+{
+    imu_record_writer_handle_t w = create_writer(0);
+    TEST_ASSERT_ESP_OK(imu_record_writer_append(w, s_samples, 7));
+    TEST_ASSERT_ESP_OK(imu_record_writer_append(w, s_samples + 7, SAMPLES - 7));
+    TEST_ASSERT_ESP_OK(imu_record_writer_flush(w));
+    imu_record_writer_delete(w);
+    TEST_ASSERT_EQUAL_INT(IMU_RECORD_HEADER_SIZE + SAMPLES * IMU_RECORD_ENTRY_SIZE, s_file_len);
+
+    imu_record_header_t header;
+    TEST_ASSERT_EQUAL_INT(SAMPLES, read_back(&header, true));
+    TEST_ASSERT_EQUAL_INT(IMU_RECORD_VERSION, header.version);
+    TEST_ASSERT_EQUAL_INT(ACCE_FS_4G, header.acce_fs);
+    TEST_ASSERT_EQUAL_INT(GYRO_FS_500DPS, header.gyro_fs);
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT(s_calib.acce_bias[i] == header.acce_bias[i]);
+        TEST_ASSERT(s_calib.gyro_bias[i] == header.gyro_bias[i]);
+    }
+}
+
+static void test_sink_error_stops_writer(void)
+{
+    // 每次写出 4 条记录，第三批只写进去 10 个字节
+    const size_t buffer = 4 * IMU_RECORD_ENTRY_SIZE;
+    s_fail_at = IMU_RECORD_HEADER_SIZE + 8 * IMU_RECORD_ENTRY_SIZE + 10;
+    imu_record_writer_handle_t w = create_writer(buffer);
+
+    TEST_ASSERT_EQUAL_INT(ESP_FAIL, imu_record_writer_append(w, s_samples, SAMPLES));
+    const size_t written = s_file_len;
+    TEST_ASSERT_EQUAL_INT(s_fail_at, written);
+
+    // 之后的数据不能接在半条记录后面
+    s_fail_at = sizeof(s_file);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, imu_record_writer_append(w, s_samples + 20, 1));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, imu_record_writer_flush(w));
+    TEST_ASSERT_EQUAL_INT(written, s_file_len);
+
+    // 完整的记录都能读出，半条记录处结束
+    TEST_ASSERT_EQUAL_INT(8, read_back(NULL, true));
+
+    // 重新开始一段记录后恢复正常
+    s_file_len = 0;
+    imu_record_header_t header;
+    TEST_ASSERT_ESP_OK(imu_record_header_from_sensor(s_board, s_samples[0].timestamp_us, &header));
+    TEST_ASSERT_ESP_OK(imu_record_writer_begin(w, &header));
+    TEST_ASSERT_ESP_OK(imu_record_writer_append(w, s_samples, 3));
+    TEST_ASSERT_ESP_OK(imu_record_writer_flush(w));
+    imu_record_writer_delete(w);
+    TEST_ASSERT_EQUAL_INT(3, read_back(NULL, false));
+}
+
+static void test_bad_timestamp_rejects_whole_batch(void)
+{
+    imu_record_writer_handle_t w = create_writer(0);
+    mpu6050_sample_t batch[6];
+    memcpy(batch, s_samples, sizeof(batch));
+    batch[4].timestamp_us = batch[3].timestamp_us - 1;
+
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_ARG, imu_record_writer_append(w, batch, 6));
+    // 整批未写入，之后的合法批次接在头部后面
+    TEST_ASSERT_ESP_OK(imu_record_writer_append(w, s_samples, 5));
+    TEST_ASSERT_ESP_OK(imu_record_writer_flush(w));
+    imu_record_writer_delete(w);
+    TEST_ASSERT_EQUAL_INT(5, read_back(NULL, true));
+}
+
+int main(void)
+{
+    RUN_TEST(test_replay_matches_on_board);
+    RUN_TEST(test_sink_error_stops_writer);
+    RUN_TEST(test_bad_timestamp_rejects_whole_batch);
+    return TEST_END();
+}
@@ -0,0 +1,171 @@
+/**
+ * imu_ring 批量写入：超过容量的批次、与逐帧写入等价，以及读者抢占写入时
+ * 读到的每一帧都完整（不撕裂）、序号连续且丢帧全部计入 overruns。
+ * 以 IMU_RING_CAPACITY=16 编译，让抢占测试频繁绕回。
+ */
+
+#include <signal.h>
+#include <time.h>
+
+#include "imu_ring.h"
+#include "test_util.h"
+
+static imu_ring_t s_ring = IMU_RING_INIT;
+
+void setUp(void)
+{
+    s_ring.head = 0;
+}
+
+void tearDown(void)
+{
+}
+
+// 帧内每个字段都由序号导出，读者据此判断是否撕裂
+static void make_sample(uint32_t seq, mpu6050_sample_t *s)
+{
+    s->timestamp_us = seq;
+    s->raw.raw_acce.raw_acce_x = (int16_t)seq;
+    s->raw.raw_gyro.raw_gyro_z = (int16_t)~seq;
+    s->acce.acce_x = (float)(seq & 0xffff);
+    s->gyro.gyro_z = -(float)(seq & 0xffff);
+    s->temp.temp = (float)(seq & 0xff);
+}
+
+static bool sample_is_whole(const mpu6050_sample_t *s)
+{
+    const uint32_t seq = (uint32_t)s->timestamp_us;
+    return s->raw.raw_acce.raw_acce_x == (int16_t)seq &&
+           s->raw.raw_gyro.raw_gyro_z == (int16_t)~seq &&
+           s->acce.acce_x == (float)(seq & 0xffff) &&
+           s->gyro.gyro_z == -(float)(seq & 0xffff) &&
+           s->temp.temp == (float)(seq & 0xff);
+}
+
+static void push_range(uint32_t first, size_t count)
+{
+    mpu6050_sample_t batch[64];
+    TEST_ASSERT(count <= 64);
+    for (size_t i = 0; i < count; i++)
+    {
+        make_sample(first + (uint32_t)i, &batch[i]);
+    }
+    imu_ring_push_batch(&s_ring, batch, count);
+}
+
+static void test_batch_in_order(void)
+{
+    imu_ring_reader_t reader;
+    imu_ring_reader_init(&reader, &s_ring);
+    push_range(0, 5);
+    push_range(5, 7);
+    TEST_ASSERT_EQUAL_INT(12, imu_ring_available(&reader));
+
+    mpu6050_sample_t out[IMU_RING_CAPACITY];
+    const size_t n = imu_ring_read(&reader, out, IMU_RING_CAPACITY);
+    TEST_ASSERT_EQUAL_INT(12, n);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT(sample_is_whole(&out[i]));
+        TEST_ASSERT_EQUAL_INT(i, out[i].timestamp_us);
+    }
+    TEST_ASSERT_EQUAL_INT(0, reader.overruns);
+}
+
+static void test_batch_larger_than_capacity(void)
+{
+    imu_ring_reader_t reader;
+    imu_ring_reader_init(&reader, &s_ring);
+    const size_t count = IMU_RING_CAPACITY * 2 + 3;
+    push_range(100, count);
+
+    // 只剩最新的 CAPACITY - 1 帧可读，其余计入 overruns
+    mpu6050_sample_t out[IMU_RING_CAPACITY];
+    const size_t n = imu_ring_read(&reader, out, IMU_RING_CAPACITY);
+    TEST_ASSERT_EQUAL_INT(IMU_RING_CAPACITY - 1, n);
+    TEST_ASSERT_EQUAL_INT(count - n, reader.overruns);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT(sample_is_whole(&out[i]));
+        TEST_ASSERT_EQUAL_INT(100 + count - n + i, out[i].timestamp_us);
+    }
+}
+
+// 读者在高频定时器信号中运行，相当于抢占生产者的高优先级任务：
+// 它会在 imu_ring_push_batch() 写到一半时读取，单核机器上也能覆盖这种交错
+#define STRESS_SAMPLES 2000000u
+#define READER_PERIOD_NS 20000
+
+static imu_ring_reader_t s_reader;
+static volatile uint32_t s_expected, s_received, s_torn, s_gaps, s_reads;
+
+static void reader_signal(int sig)
+{
+    mpu6050_sample_t out[8];
+    const size_t n = imu_ring_read(&s_reader, out, 8);
+    for (size_t i = 0; i < n; i++)
+    {
+        s_torn += !sample_is_whole(&out[i]);
+        const uint32_t seq = (uint32_t)out[i].timestamp_us;
+        s_gaps += (seq < s_expected);
+        s_expected = seq + 1;
+    }
+    s_received += (uint32_t)n;
+    s_reads++;
+}
+
+static void test_preempting_reader_never_sees_torn_frames(void)
+{
+    imu_ring_reader_init(&s_reader, &s_ring);
+    s_expected = s_received = s_torn = s_gaps = s_reads = 0;
+
+    struct sigaction sa = {.sa_handler = reader_signal};
+    sigemptyset(&sa.sa_mask);
+    TEST_ASSERT_EQUAL_INT(0, sigaction(SIGALRM, &sa, NULL));
+    timer_t timer;
+    struct sigevent sev = {.sigev_notify = SIGEV_SIGNAL, .sigev_signo = SIGALRM};
+    TEST_ASSERT_EQUAL_INT(0, timer_create(CLOCK_MONOTONIC, &sev, &timer));
+    const struct itimerspec period = {
+        .it_interval = {.tv_nsec = READER_PERIOD_NS},
+        .it_value = {.tv_nsec = READER_PERIOD_NS},
+    };
+    TEST_ASSERT_EQUAL_INT(0, timer_settime(timer, 0, &period, NULL));
+
+    mpu6050_sample_t batch[IMU_RING_CAPACITY + 8];
+    uint32_t seq = 0;
+    uint32_t rng = 12345;
+    while (seq < STRESS_SAMPLES)
+    {
+        rng = rng * 1103515245u + 12345u;
+        const size_t count = 1 + (rng >> 16) % (IMU_RING_CAPACITY + 8); // 偶尔超过容量
+        for (size_t i = 0; i < count; i++)
+        {
+            make_sample(seq + (uint32_t)i, &batch[i]);
+        }
+        imu_ring_push_batch(&s_ring, batch, count);
+        seq += (uint32_t)count;
+    }
+
+    timer_delete(timer);
+    signal(SIGALRM, SIG_DFL);
+    while (imu_ring_available(&s_reader) > 0)
+    {
+        reader_signal(0); // 读完剩余的帧
+    }
+
+    printf("  %u reads, received %u, overruns %u\n", s_reads, s_received, s_reader.overruns);
+    TEST_ASSERT(s_reads > 100);
+    TEST_ASSERT_EQUAL_INT(0, s_torn);
+    TEST_ASSERT_EQUAL_INT(0, s_gaps);
+    // 每一帧要么读到，要么计入 overruns
+    TEST_ASSERT_EQUAL_INT(s_reader.cursor, s_received + s_reader.overruns);
+    TEST_ASSERT_EQUAL_INT(s_ring.head, s_reader.cursor);
+}
+
+int main(void)
+{
+    RUN_TEST(test_batch_in_order);
+    RUN_TEST(test_batch_larger_than_capacity);
+    RUN_TEST(test_preempting_reader_never_sees_torn_frames);
+    return TEST_END();
+}
@@ -0,0 +1,203 @@
+/**
+ * mpu6050_calibrate() / mpu6050_set_calibration() 对接寄存器级模拟器：硬件偏置寄存器的写入、
+ * 出厂微调值随标定结果保存，以及 MCU 热复位（传感器不掉电、驱动句柄重建）后清除硬件偏置。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/i2c_master.h"
+#include "mpu6050.h"
+#include "mpu6050_calib.h"
+#include "mpu6050_sim.h"
+#include "test_util.h"
+
+#define SIM_ADDR 0x68
+#define XA_OFFS_H 0x06
+#define XG_OFFS_USRH 0x13
+
+// 出厂微调值，bit0 为温度补偿保留位
+static const int16_t s_factory_trim[3] = {1001, -2000, 3003};
+
+static i2c_master_bus_handle_t s_bus;
+static mpu6050_sim_handle_t s_sim;
+static mpu6050_handle_t s_dev;
+
+// 内存实现的存储后端，只保存一条记录
+static uint8_t s_store_buf[128];
+static size_t s_store_len;
+
+static esp_err_t mem_load(void *ctx, const char *key, void *buf, size_t len)
+{
+    if (0 == s_store_len)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (len != s_store_len)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(buf, s_store_buf, len);
+    return ESP_OK;
+}
+
+static esp_err_t mem_save(void *ctx, const char *key, const void *buf, size_t len)
+{
+    if (len > sizeof(s_store_buf))
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(s_store_buf, buf, len);
+    s_store_len = len;
+    return ESP_OK;
+}
+
+static const mpu6050_calib_store_t s_mem_store = {.load = mem_load, .save = mem_save};
+
+static void open_sensor(void)
+{
+    s_dev = mpu6050_create(s_bus, SIM_ADDR);
+    TEST_ASSERT(s_dev);
+    TEST_ASSERT_ESP_OK(mpu6050_config(s_dev, ACCE_FS_4G, GYRO_FS_500DPS));
+    const mpu6050_rate_config_t rate = {.dlpf = MPU6050_DLPF_184HZ, .odr_hz = 1000};
+    TEST_ASSERT_ESP_OK(mpu6050_config_rate(s_dev, &rate, NULL));
+    TEST_ASSERT_ESP_OK(mpu6050_wake_up(s_dev));
+    mpu6050_sim_advance(s_sim, 1000);
+}
+
+// MCU 热复位：驱动句柄重建，传感器寄存器保持不变
+static void warm_reboot(void)
+{
+    mpu6050_delete(s_dev);
+    open_sensor();
+}
+
+void setUp(void)
+{
+    const mpu6050_sim_config_t sim_cfg = {
+        .address = SIM_ADDR,
+        .temp_c = 25.0f,
+        .acce_bias_g = {0.05f, -0.02f, 0.03f},
+        .gyro_bias_dps = {2.0f, -1.5f, 0.5f},
+    };
+    s_sim = mpu6050_sim_create(&sim_cfg);
+    TEST_ASSERT(s_sim);
+    TEST_ASSERT_ESP_OK(mpu6050_sim_attach(s_sim));
+
+    uint8_t trim[7] = {XA_OFFS_H};
+    for (int i = 0; i < 3; i++)
+    {
+        trim[1 + 2 * i] = (uint8_t)((uint16_t)s_factory_trim[i] >> 8);
+        trim[2 + 2 * i] = (uint8_t)s_factory_trim[i];
+    }
+    TEST_ASSERT_ESP_OK(mpu6050_sim_write(s_sim, trim, sizeof(trim)));
+
+    const i2c_master_bus_config_t bus_cfg = {.i2c_port = I2C_NUM_0};
+    TEST_ASSERT_ESP_OK(i2c_new_master_bus(&bus_cfg, &s_bus));
+    open_sensor();
+    s_store_len = 0;
+}
+
+void tearDown(void)
+{
+    mpu6050_delete(s_dev);
+    s_dev = NULL;
+    if (s_bus)
+    {
+        i2c_del_master_bus(s_bus);
+        s_bus = NULL;
+    }
+    mpu6050_sim_delete(s_sim);
+    s_sim = NULL;
+}
+
+static int16_t peek16(uint8_t reg)
+{
+    return (int16_t)((mpu6050_sim_peek(s_sim, reg) << 8) | mpu6050_sim_peek(s_sim, reg + 1));
+}
+
+static void calibrate_hw(mpu6050_calib_t *out)
+{
+    const mpu6050_calib_config_t cfg = {.samples = 4, .write_hw_offsets = true};
+    TEST_ASSERT_ESP_OK(mpu6050_calibrate(s_dev, &cfg, out));
+    TEST_ASSERT(out->hw_offsets);
+}
+
+static void test_calibrate_writes_offsets_and_records_trim(void)
+{
+    mpu6050_calib_t calib;
+    calibrate_hw(&calib);
+
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(s_factory_trim[i], calib.acce_factory_trim[i]);
+        TEST_ASSERT_EQUAL_INT(calib.acce_offset_regs[i], peek16(XA_OFFS_H + 2 * i));
+        TEST_ASSERT_EQUAL_INT(calib.gyro_offset_regs[i], peek16(XG_OFFS_USRH + 2 * i));
+        // bit0 保持出厂值
+        TEST_ASSERT_EQUAL_INT(s_factory_trim[i] & 1, calib.acce_offset_regs[i] & 1);
+    }
+    // 0.05g * 2048 LSB/g ≈ 102，2°/s * 32.8 LSB/(°/s) ≈ 66
+    TEST_ASSERT(abs(s_factory_trim[0] - 102 - calib.acce_offset_regs[0]) <= 1);
+    TEST_ASSERT_EQUAL_INT(-66, calib.gyro_offset_regs[0]);
+}
+
+static void test_clear_after_warm_reboot(void)
+{
+    mpu6050_calib_t calib;
+    calibrate_hw(&calib);
+
+    // 新句柄没有缓存出厂值，清除时陀螺仪偏置寄存器仍要归零
+    warm_reboot();
+    TEST_ASSERT_ESP_OK(mpu6050_set_calibration(s_dev, NULL));
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, peek16(XG_OFFS_USRH + 2 * i));
+    }
+}
+
+static void test_saved_calibration_restores_factory_trim(void)
+{
+    mpu6050_calib_t calib;
+    calibrate_hw(&calib);
+    TEST_ASSERT_ESP_OK(mpu6050_calib_save(&s_mem_store, "imu0", &calib));
+
+    // 热复位后先应用保存的标定，出厂值取自标定结果而不是寄存器里的残留值
+    warm_reboot();
+    mpu6050_calib_t loaded;
+    TEST_ASSERT_ESP_OK(mpu6050_calib_load(&s_mem_store, "imu0", &loaded));
+    TEST_ASSERT_ESP_OK(mpu6050_set_calibration(s_dev, &loaded));
+    TEST_ASSERT_ESP_OK(mpu6050_set_calibration(s_dev, NULL));
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(s_factory_trim[i], peek16(XA_OFFS_H + 2 * i));
+        TEST_ASSERT_EQUAL_INT(0, peek16(XG_OFFS_USRH + 2 * i));
+    }
+
+    // 重新标定得到相同的寄存器值
+    mpu6050_calib_t again;
+    calibrate_hw(&again);
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(calib.acce_offset_regs[i], again.acce_offset_regs[i]);
+        TEST_ASSERT_EQUAL_INT(calib.gyro_offset_regs[i], again.gyro_offset_regs[i]);
+    }
+}
+
+static void test_offline_handle_clears_software_bias(void)
+{
+    mpu6050_handle_t offline = mpu6050_create(NULL, SIM_ADDR);
+    TEST_ASSERT(offline);
+    const mpu6050_calib_t calib = {.acce_bias = {0.1f, 0, 0}, .gyro_bias = {1.0f, 0, 0}};
+    TEST_ASSERT_ESP_OK(mpu6050_set_calibration(offline, &calib));
+    TEST_ASSERT_ESP_OK(mpu6050_set_calibration(offline, NULL));
+    mpu6050_delete(offline);
+}
+
+int main(void)
+{
+    RUN_TEST(test_calibrate_writes_offsets_and_records_trim);
+    RUN_TEST(test_clear_after_warm_reboot);
+    RUN_TEST(test_saved_calibration_restores_factory_trim);
+    RUN_TEST(test_offline_handle_clears_software_bias);
+    return TEST_END();
+}
@@ -0,0 +1,218 @@
+/**
+ * mpu6050_fifo_read_frames() 对接寄存器级模拟器：部分通道的帧解析、
+ * 分批取出时的帧顺序与时间戳，以及 FIFO 溢出后的自动清空与重新对齐；
+ * 自动清零的 FIFO_RST 不留在影子副本里。
+ */
+
+#include <stdlib.h>
+
+#include "driver/i2c_master.h"
+#include "mpu6050.h"
+#include "mpu6050_private.h"
+#include "mpu6050_sim.h"
+#include "test_util.h"
+
+#define SIM_ADDR 0x68
+#define SAMPLE_US 20000 // 1kHz 陀螺仪时钟 / 20
+#define FIFO_SIZE 1024
+#define REG_USER_CTRL 0x6A
+#define USER_CTRL_FIFO_EN 0x40
+#define USER_CTRL_FIFO_RST 0x04
+
+static i2c_master_bus_handle_t s_bus;
+static mpu6050_sim_handle_t s_sim;
+static mpu6050_handle_t s_dev;
+
+// 无噪声模拟器 + 已唤醒、±4g/±500°/s、50Hz 输出的驱动
+void setUp(void)
+{
+    const mpu6050_sim_config_t sim_cfg = {.address = SIM_ADDR, .temp_c = 25.0f};
+    s_sim = mpu6050_sim_create(&sim_cfg);
+    TEST_ASSERT(s_sim);
+    TEST_ASSERT_ESP_OK(mpu6050_sim_attach(s_sim));
+
+    const i2c_master_bus_config_t bus_cfg = {.i2c_port = I2C_NUM_0};
+    TEST_ASSERT_ESP_OK(i2c_new_master_bus(&bus_cfg, &s_bus));
+    s_dev = mpu6050_create(s_bus, SIM_ADDR);
+    TEST_ASSERT(s_dev);
+    TEST_ASSERT_ESP_OK(mpu6050_config(s_dev, ACCE_FS_4G, GYRO_FS_500DPS));
+    const mpu6050_rate_config_t rate = {.dlpf = MPU6050_DLPF_21HZ, .odr_hz = 50};
+    TEST_ASSERT_ESP_OK(mpu6050_config_rate(s_dev, &rate, NULL));
+    TEST_ASSERT_ESP_OK(mpu6050_wake_up(s_dev));
+    mpu6050_sim_advance(s_sim, SAMPLE_US / 2); // 唤醒时刻的第一个采样
+}
+
+void tearDown(void)
+{
+    mpu6050_delete(s_dev);
+    s_dev = NULL;
+    if (s_bus)
+    {
+        i2c_del_master_bus(s_bus);
+        s_bus = NULL;
+    }
+    mpu6050_sim_delete(s_sim);
+    s_sim = NULL;
+}
+
+// 每个采样的 gyro_z 为 k °/s，用来确认帧顺序
+static void push_numbered_samples(int first, int count)
+{
+    const mpu6050_acce_value_t acce = {.acce_x = 0.5f, .acce_y = -0.25f, .acce_z = 0.75f};
+    for (int k = first; k < first + count; k++)
+    {
+        const mpu6050_gyro_value_t gyro = {.gyro_x = 10.0f, .gyro_y = -20.0f, .gyro_z = (float)k};
+        mpu6050_sim_set_motion(s_sim, &acce, &gyro);
+        mpu6050_sim_advance(s_sim, SAMPLE_US);
+    }
+}
+
+static int gyro_z_index(const mpu6050_raw_motion_value_t *frame)
+{
+    return (int)lroundf(frame->raw_gyro.raw_gyro_z / 65.5f);
+}
+
+static void test_partial_channels_parse(void)
+{
+    // 加速度 + GYRO_Z：6 + 2 = 8 字节一帧，温度与 X/Y 轴填 0
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_start(s_dev, MPU6050_FIFO_ACCE_BIT | MPU6050_FIFO_GYRO_Z_BIT));
+    push_numbered_samples(1, 5);
+
+    uint16_t count = 0;
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_get_count(s_dev, &count));
+    TEST_ASSERT_EQUAL_INT(5 * 8, count);
+
+    mpu6050_raw_motion_value_t frames[8];
+    size_t n = 0;
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_read_frames(s_dev, frames, 8, &n, NULL));
+    TEST_ASSERT_EQUAL_INT(5, n);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(4096, frames[i].raw_acce.raw_acce_x);
+        TEST_ASSERT_EQUAL_INT(-2048, frames[i].raw_acce.raw_acce_y);
+        TEST_ASSERT_EQUAL_INT(6144, frames[i].raw_acce.raw_acce_z);
+        TEST_ASSERT_EQUAL_INT(0, frames[i].raw_temp);
+        TEST_ASSERT_EQUAL_INT(0, frames[i].raw_gyro.raw_gyro_x);
+        TEST_ASSERT_EQUAL_INT(0, frames[i].raw_gyro.raw_gyro_y);
+        TEST_ASSERT_EQUAL_INT((int)(i + 1), gyro_z_index(&frames[i]));
+    }
+}
+
+static void test_split_drain_keeps_order_and_timestamps(void)
+{
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_start(s_dev, MPU6050_FIFO_ALL_BITS));
+    push_numbered_samples(1, 10);
+
+    // 只取最旧的 4 帧：时间戳要往前推 6 个采样周期
+    mpu6050_raw_motion_value_t frames[10];
+    size_t n = 0;
+    int64_t ts_first = 0;
+    int64_t ts_second = 0;
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_read_frames(s_dev, frames, 4, &n, &ts_first));
+    TEST_ASSERT_EQUAL_INT(4, n);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_EQUAL_INT((int)(i + 1), gyro_z_index(&frames[i]));
+    }
+
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_read_frames(s_dev, frames, 10, &n, &ts_second));
+    TEST_ASSERT_EQUAL_INT(6, n);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_EQUAL_INT((int)(i + 5), gyro_z_index(&frames[i]));
+    }
+    // 两次读取之间没有新采样，最后一帧相差 6 个周期；余量留给两次读取之间的实际耗时
+    TEST_ASSERT(llabs(ts_second - ts_first - 6 * SAMPLE_US) < 5000);
+
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_read_frames(s_dev, frames, 10, &n, NULL));
+    TEST_ASSERT_EQUAL_INT(0, n);
+}
+
+static void test_overflow_resets_and_realigns(void)
+{
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_start(s_dev, MPU6050_FIFO_ALL_BITS));
+    // 1024 / 14 = 73 帧后溢出，硬件丢弃最旧字节，帧边界错位
+    push_numbered_samples(1, 80);
+    mpu6050_sim_stats_t stats;
+    mpu6050_sim_get_stats(s_sim, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.fifo_overflows);
+
+    mpu6050_raw_motion_value_t frames[16];
+    size_t n = 99;
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, mpu6050_fifo_read_frames(s_dev, frames, 16, &n, NULL));
+    TEST_ASSERT_EQUAL_INT(0, n);
+
+    // 驱动已清空 FIFO，之后的帧重新按边界对齐
+    uint16_t count = FIFO_SIZE;
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_get_count(s_dev, &count));
+    TEST_ASSERT_EQUAL_INT(0, count);
+
+    push_numbered_samples(100, 3);
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_read_frames(s_dev, frames, 16, &n, NULL));
+    TEST_ASSERT_EQUAL_INT(3, n);
+    for (size_t i = 0; i < n; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(4096, frames[i].raw_acce.raw_acce_x);
+        TEST_ASSERT_EQUAL_INT(655, frames[i].raw_gyro.raw_gyro_x);
+        TEST_ASSERT_EQUAL_INT((int)(100 + i), gyro_z_index(&frames[i]));
+    }
+}
+
+static void test_read_without_fifo(void)
+{
+    mpu6050_raw_motion_value_t frames[2];
+    size_t n = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, mpu6050_fifo_read_frames(s_dev, frames, 2, &n, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_ARG, mpu6050_fifo_read_frames(s_dev, NULL, 2, &n, NULL));
+}
+
+// 驱动写入 USER_CTRL 的值
+static uint8_t s_user_ctrl_writes[8];
+static int s_user_ctrl_count;
+
+static void record_user_ctrl(uint8_t reg, uint8_t value, void *ctx)
+{
+    if (REG_USER_CTRL == reg && s_user_ctrl_count < (int)sizeof(s_user_ctrl_writes))
+    {
+        s_user_ctrl_writes[s_user_ctrl_count++] = value;
+    }
+}
+
+static void test_shadow_drops_fifo_reset_bit(void)
+{
+    const mpu6050_dev_t *d = (const mpu6050_dev_t *)s_dev;
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_start(s_dev, MPU6050_FIFO_ACCE_BIT));
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_stop(s_dev));
+    // 器件读回时 FIFO_RST 已清零，影子与器件一致
+    TEST_ASSERT_EQUAL_INT(0, d->shadow.user_ctrl & USER_CTRL_FIFO_RST);
+    TEST_ASSERT_EQUAL_INT(mpu6050_sim_peek(s_sim, REG_USER_CTRL), d->shadow.user_ctrl);
+
+    // 再次开启：复位与使能分开写，FIFO_RST 不会和 FIFO_EN 一起写进去
+    s_user_ctrl_count = 0;
+    mpu6050_sim_set_write_callback(s_sim, record_user_ctrl, NULL);
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_start(s_dev, MPU6050_FIFO_ACCE_BIT));
+    mpu6050_sim_set_write_callback(s_sim, NULL, NULL);
+    TEST_ASSERT(s_user_ctrl_count >= 2);
+    for (int i = 0; i < s_user_ctrl_count; i++)
+    {
+        const uint8_t both = USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RST;
+        TEST_ASSERT((s_user_ctrl_writes[i] & both) != both);
+    }
+    TEST_ASSERT_EQUAL_INT(USER_CTRL_FIFO_EN, s_user_ctrl_writes[s_user_ctrl_count - 1]);
+    TEST_ASSERT_EQUAL_INT(USER_CTRL_FIFO_EN, d->shadow.user_ctrl);
+
+    // 校验模式读回的值与影子相同
+    TEST_ASSERT_ESP_OK(mpu6050_set_shadow_verify(s_dev, true));
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_stop(s_dev));
+    TEST_ASSERT_EQUAL_INT(mpu6050_sim_peek(s_sim, REG_USER_CTRL), d->shadow.user_ctrl);
+}
+
+int main(void)
+{
+    RUN_TEST(test_partial_channels_parse);
+    RUN_TEST(test_split_drain_keeps_order_and_timestamps);
+    RUN_TEST(test_overflow_resets_and_realigns);
+    RUN_TEST(test_read_without_fifo);
+    RUN_TEST(test_shadow_drops_fifo_reset_bit);
+    return TEST_END();
+}
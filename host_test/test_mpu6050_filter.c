@@ -0,0 +1,169 @@
+/**
+ * 互补滤波与双精度参考实现的对比。同一源码分别链接浮点版与定点版
+ * （CONFIG_MPU6050_FIXED_POINT_FILTER）驱动，两者都要跟住参考值。
+ */
+
+#include <math.h>
+
+#include "mpu6050.h"
+#include "mpu6050_calib.h"
+#include "test_util.h"
+
+#define RATE_HZ 100
+#define DT_US (1000000 / RATE_HZ)
+#define SECONDS 10
+#define ACCE_LSB_PER_G 16384.0 // 上电默认 ±2g
+#define GYRO_LSB_PER_DPS 131.0 // 上电默认 ±250°/s
+#define ALPHA 0.99
+
+#if CONFIG_MPU6050_FIXED_POINT_FILTER
+#define MAX_ERR_DEG 0.15 // 多项式 atan2 最大约 0.09°，经滤波平滑
+#else
+#define MAX_ERR_DEG 0.01
+#endif
+
+static mpu6050_handle_t s_dev;
+
+void setUp(void)
+{
+    s_dev = mpu6050_create(NULL, 0x68); // 离线句柄，只做换算与滤波
+    TEST_ASSERT(s_dev);
+}
+
+void tearDown(void)
+{
+    mpu6050_delete(s_dev);
+    s_dev = NULL;
+}
+
+// 横滚 ±20°/0.5Hz、俯仰 ±15°/0.3Hz 的摆动，量化为原始采样，并叠加 bias（LSB）
+static void make_sample(int k, const double acce_bias_lsb[3], const double gyro_bias_lsb[3],
+                        mpu6050_raw_motion_value_t *raw)
+{
+    const double t = (double)k / RATE_HZ;
+    const double w_r = 2 * M_PI * 0.5, w_p = 2 * M_PI * 0.3;
+    const double roll = 20 * sin(w_r * t) * M_PI / 180;
+    const double pitch = -15 * sin(w_p * t) * M_PI / 180;
+    const double roll_rate = 20 * w_r * cos(w_r * t);   // °/s
+    const double pitch_rate = -15 * w_p * cos(w_p * t); // °/s
+
+    // atan2(ay, az) = roll、atan2(ax, az) = pitch，模长不超过 1g
+    const double az = 0.8;
+    const double acce[3] = {az * tan(pitch), az * tan(roll), az};
+    const double gyro[3] = {roll_rate, pitch_rate, 0};
+
+    raw->raw_acce.raw_acce_x = (int16_t)lround(acce[0] * ACCE_LSB_PER_G + acce_bias_lsb[0]);
+    raw->raw_acce.raw_acce_y = (int16_t)lround(acce[1] * ACCE_LSB_PER_G + acce_bias_lsb[1]);
+    raw->raw_acce.raw_acce_z = (int16_t)lround(acce[2] * ACCE_LSB_PER_G + acce_bias_lsb[2]);
+    raw->raw_gyro.raw_gyro_x = (int16_t)lround(gyro[0] * GYRO_LSB_PER_DPS + gyro_bias_lsb[0]);
+    raw->raw_gyro.raw_gyro_y = (int16_t)lround(gyro[1] * GYRO_LSB_PER_DPS + gyro_bias_lsb[1]);
+    raw->raw_gyro.raw_gyro_z = (int16_t)lround(gyro[2] * GYRO_LSB_PER_DPS + gyro_bias_lsb[2]);
+    raw->raw_temp = 0;
+}
+
+// 双精度参考：与驱动相同的互补滤波公式，输入为扣除零偏后的量化数据
+typedef struct
+{
+    double roll, pitch;
+    int n;
+} ref_filter_t;
+
+static void ref_update(ref_filter_t *f, const mpu6050_raw_motion_value_t *raw,
+                       const double acce_bias_lsb[3], const double gyro_bias_lsb[3])
+{
+    const double ax = raw->raw_acce.raw_acce_x - acce_bias_lsb[0];
+    const double ay = raw->raw_acce.raw_acce_y - acce_bias_lsb[1];
+    const double az = raw->raw_acce.raw_acce_z - acce_bias_lsb[2];
+    const double acce_roll = atan2(ay, az) * 180 / M_PI;
+    const double acce_pitch = atan2(ax, az) * 180 / M_PI;
+    if (0 == f->n++)
+    {
+        f->roll = acce_roll;
+        f->pitch = acce_pitch;
+        return;
+    }
+    const double dt = DT_US * 1e-6;
+    const double gx = (raw->raw_gyro.raw_gyro_x - gyro_bias_lsb[0]) / GYRO_LSB_PER_DPS;
+    const double gy = (raw->raw_gyro.raw_gyro_y - gyro_bias_lsb[1]) / GYRO_LSB_PER_DPS;
+    f->roll = ALPHA * (f->roll + gx * dt) + (1 - ALPHA) * acce_roll;
+    f->pitch = ALPHA * (f->pitch + gy * dt) + (1 - ALPHA) * acce_pitch;
+}
+
+static void run_and_compare(bool use_raw, const double acce_bias_lsb[3], const double gyro_bias_lsb[3])
+{
+    ref_filter_t ref = {0};
+    complimentary_angle_t angle = {0};
+    double max_err = 0;
+
+    for (int k = 0; k < SECONDS * RATE_HZ; k++)
+    {
+        mpu6050_raw_motion_value_t raw;
+        make_sample(k, acce_bias_lsb, gyro_bias_lsb, &raw);
+        const int64_t ts = 1000 + (int64_t)k * DT_US;
+        if (use_raw)
+        {
+            TEST_ASSERT_ESP_OK(mpu6050_complimentory_filter_raw(s_dev, &raw, ts, &angle));
+        }
+        else
+        {
+            mpu6050_acce_value_t acce;
+            mpu6050_gyro_value_t gyro;
+            mpu6050_temp_value_t temp;
+            TEST_ASSERT_ESP_OK(mpu6050_convert_motion(s_dev, &raw, &acce, &gyro, &temp));
+            TEST_ASSERT_ESP_OK(mpu6050_complimentory_filter(s_dev, &acce, &gyro, ts, &angle));
+        }
+        ref_update(&ref, &raw, acce_bias_lsb, gyro_bias_lsb);
+        max_err = fmax(max_err, fabs(angle.roll - ref.roll));
+        max_err = fmax(max_err, fabs(angle.pitch - ref.pitch));
+    }
+    printf("  %s input: max error %.4f deg\n", use_raw ? "raw" : "float", max_err);
+    TEST_ASSERT(max_err < MAX_ERR_DEG);
+}
+
+static const double k_no_bias[3] = {0, 0, 0};
+
+static void test_float_input_tracks_reference(void)
+{
+    run_and_compare(false, k_no_bias, k_no_bias);
+}
+
+static void test_raw_input_tracks_reference(void)
+{
+    run_and_compare(true, k_no_bias, k_no_bias);
+}
+
+static void test_raw_input_applies_software_bias(void)
+{
+    // 0.02g / 0.75°/s 的软件零偏，原始数据中带同样的偏置
+    const mpu6050_calib_t calib = {
+        .acce_bias = {0.02f, -0.01f, 0.03f},
+        .gyro_bias = {0.75f, -1.5f, 0.25f},
+    };
+    TEST_ASSERT_ESP_OK(mpu6050_set_calibration(s_dev, &calib));
+    double acce_bias_lsb[3], gyro_bias_lsb[3];
+    for (int i = 0; i < 3; i++)
+    {
+        acce_bias_lsb[i] = calib.acce_bias[i] * ACCE_LSB_PER_G;
+        gyro_bias_lsb[i] = calib.gyro_bias[i] * GYRO_LSB_PER_DPS;
+    }
+    run_and_compare(true, acce_bias_lsb, gyro_bias_lsb);
+}
+
+static void test_repeated_timestamp_rejected(void)
+{
+    mpu6050_raw_motion_value_t raw;
+    complimentary_angle_t angle;
+    make_sample(0, k_no_bias, k_no_bias, &raw);
+    TEST_ASSERT_ESP_OK(mpu6050_complimentory_filter_raw(s_dev, &raw, 1000, &angle));
+    TEST_ASSERT_ESP_OK(mpu6050_complimentory_filter_raw(s_dev, &raw, 2000, &angle));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_ARG, mpu6050_complimentory_filter_raw(s_dev, &raw, 2000, &angle));
+}
+
+int main(void)
+{
+    RUN_TEST(test_float_input_tracks_reference);
+    RUN_TEST(test_raw_input_tracks_reference);
+    RUN_TEST(test_raw_input_applies_software_bias);
+    RUN_TEST(test_repeated_timestamp_rejected);
+    return TEST_END();
+}
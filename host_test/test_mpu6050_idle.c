@@ -0,0 +1,202 @@
+/**
+ * 中断采集任务的 idle 流程：静止一段时间后进入加速度计循环 + 运动检测，运动中断唤醒后
+ * 恢复 DATA_RDY 采样；以及在运动检测中断刚开启的瞬间发生的运动不会被丢弃。
+ * 采集任务是真实的（pthread）任务，INT 经 GPIO 模拟层调用驱动的 ISR。
+ */
+
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "driver/i2c_master.h"
+#include "mpu6050.h"
+#include "mpu6050_acq.h"
+#include "mpu6050_sim.h"
+#include "test_util.h"
+
+#define SIM_ADDR 0x68
+#define SIM_INT_GPIO 4
+#define SAMPLE_US 20000 // 50Hz
+#define CYCLE_US 200000 // LP_WAKE 5Hz
+#define REG_PWR_MGMT_1 0x6B
+#define REG_INT_ENABLE 0x38
+#define PWR1_CYCLE 0x20
+
+static i2c_master_bus_handle_t s_bus;
+static mpu6050_sim_handle_t s_sim;
+static mpu6050_handle_t s_dev;
+static mpu6050_acq_handle_t s_acq;
+static atomic_int s_idle_state; // on_idle 最近一次的参数，-1 表示尚未调用
+
+static const mpu6050_acce_value_t k_level = {.acce_z = 1.0f};
+static const mpu6050_acce_value_t k_moved = {.acce_x = 0.3f, .acce_z = 0.95f};
+static const mpu6050_gyro_value_t k_still = {0};
+
+static void on_idle(bool idle, void *user_ctx)
+{
+    atomic_store(&s_idle_state, idle ? 1 : 0);
+}
+
+void setUp(void)
+{
+    const mpu6050_sim_config_t sim_cfg = {.address = SIM_ADDR, .temp_c = 25.0f};
+    s_sim = mpu6050_sim_create(&sim_cfg);
+    TEST_ASSERT(s_sim);
+    TEST_ASSERT_ESP_OK(mpu6050_sim_attach(s_sim));
+    mpu6050_sim_set_motion(s_sim, &k_level, &k_still);
+    mpu6050_sim_set_int_gpio(s_sim, SIM_INT_GPIO);
+
+    const i2c_master_bus_config_t bus_cfg = {.i2c_port = I2C_NUM_0};
+    TEST_ASSERT_ESP_OK(i2c_new_master_bus(&bus_cfg, &s_bus));
+    s_dev = mpu6050_create(s_bus, SIM_ADDR);
+    TEST_ASSERT(s_dev);
+    TEST_ASSERT_ESP_OK(mpu6050_config(s_dev, ACCE_FS_4G, GYRO_FS_500DPS));
+    const mpu6050_rate_config_t rate = {.dlpf = MPU6050_DLPF_21HZ, .odr_hz = 50};
+    TEST_ASSERT_ESP_OK(mpu6050_config_rate(s_dev, &rate, NULL));
+    TEST_ASSERT_ESP_OK(mpu6050_wake_up(s_dev));
+    mpu6050_sim_advance(s_sim, SAMPLE_US / 2);
+
+    atomic_store(&s_idle_state, -1);
+    const mpu6050_acq_config_t acq_cfg = {
+        .int_config = {
+            .interrupt_pin = SIM_INT_GPIO,
+            .pin_mode = INTERRUPT_PIN_PUSH_PULL,
+            .interrupt_latch = INTERRUPT_LATCH_50US,
+            .active_level = INTERRUPT_PIN_ACTIVE_HIGH,
+            .interrupt_clear_behavior = INTERRUPT_CLEAR_ON_ANY_READ,
+        },
+        .task_priority = 5,
+        .core_id = tskNO_AFFINITY,
+        .idle_after_ms = 60,
+        .idle_gyro_dps = 1.0f,
+        .idle = {.motion_threshold = 20, .motion_duration = 1, .wake_freq = MPU6050_LP_WAKE_5HZ},
+        .on_idle = on_idle,
+    };
+    TEST_ASSERT_ESP_OK(mpu6050_acq_start(s_dev, &acq_cfg, &s_acq));
+}
+
+void tearDown(void)
+{
+    if (s_sim)
+    {
+        mpu6050_sim_set_write_callback(s_sim, NULL, NULL);
+    }
+    if (s_acq)
+    {
+        mpu6050_acq_stop(s_acq);
+        s_acq = NULL;
+    }
+    mpu6050_delete(s_dev);
+    s_dev = NULL;
+    if (s_bus)
+    {
+        i2c_del_master_bus(s_bus);
+        s_bus = NULL;
+    }
+    if (s_sim)
+    {
+        mpu6050_sim_set_int_gpio(s_sim, GPIO_NUM_NC);
+        mpu6050_sim_delete(s_sim);
+        s_sim = NULL;
+    }
+}
+
+// 等待采集任务把 idle 状态切换到 want，超时返回 false
+static bool wait_idle_state(int want, int timeout_ms)
+{
+    for (int i = 0; i < timeout_ms; i++)
+    {
+        if (atomic_load(&s_idle_state) == want)
+        {
+            return true;
+        }
+        usleep(1000);
+    }
+    return false;
+}
+
+// 按实际时间节奏产生采样（采样时间戳取自 ISR 中的真实时钟），直到进入 idle
+static void feed_until_idle(void)
+{
+    for (int i = 0; i < 50 && atomic_load(&s_idle_state) != 1; i++)
+    {
+        mpu6050_sim_advance(s_sim, SAMPLE_US);
+        usleep(SAMPLE_US);
+    }
+    TEST_ASSERT(wait_idle_state(1, 200));
+}
+
+static void test_idle_then_motion_wakes(void)
+{
+    feed_until_idle();
+    mpu6050_acq_stats_t stats;
+    TEST_ASSERT_ESP_OK(mpu6050_acq_get_stats(s_acq, &stats));
+    TEST_ASSERT_EQUAL_INT(1, stats.idle_entries);
+    TEST_ASSERT(mpu6050_sim_peek(s_sim, REG_PWR_MGMT_1) & PWR1_CYCLE);
+    TEST_ASSERT_EQUAL_INT(MPU6050_MOT_DETECT_INT_BIT, mpu6050_sim_peek(s_sim, REG_INT_ENABLE));
+
+    // 保持静止：循环采样不触发运动中断
+    mpu6050_sim_advance(s_sim, 5 * CYCLE_US);
+    TEST_ASSERT(!wait_idle_state(0, 50));
+
+    // 移动后下一个循环采样触发运动中断，任务恢复全速采样
+    mpu6050_sim_set_motion(s_sim, &k_moved, &k_still);
+    mpu6050_sim_advance(s_sim, CYCLE_US);
+    TEST_ASSERT(wait_idle_state(0, 500));
+    TEST_ASSERT_ESP_OK(mpu6050_acq_get_stats(s_acq, &stats));
+    TEST_ASSERT_EQUAL_INT(1, stats.wakeups);
+    TEST_ASSERT(!(mpu6050_sim_peek(s_sim, REG_PWR_MGMT_1) & PWR1_CYCLE));
+    TEST_ASSERT_EQUAL_INT(MPU6050_DATA_RDY_INT_BIT, mpu6050_sim_peek(s_sim, REG_INT_ENABLE));
+
+    // DATA_RDY 采样恢复
+    const uint32_t before = stats.samples;
+    for (int i = 0; i < 3; i++)
+    {
+        mpu6050_sim_advance(s_sim, SAMPLE_US);
+        usleep(5000);
+    }
+    TEST_ASSERT_ESP_OK(mpu6050_acq_get_stats(s_acq, &stats));
+    TEST_ASSERT(stats.samples >= before + 2);
+}
+
+// 驱动进入循环模式（enter_idle 的最后一次写）时立即制造运动：运动中断在
+// mpu6050_enter_idle 返回之前就已到达，不能被当作过期的 DATA_RDY 通知丢掉
+static atomic_bool s_injected;
+
+static void inject_motion_on_cycle(uint8_t reg, uint8_t value, void *ctx)
+{
+    if (REG_PWR_MGMT_1 == reg && (value & PWR1_CYCLE) && !atomic_exchange(&s_injected, true))
+    {
+        mpu6050_sim_set_motion(s_sim, &k_moved, &k_still);
+        mpu6050_sim_advance(s_sim, CYCLE_US);
+    }
+}
+
+static void test_motion_while_arming_is_not_lost(void)
+{
+    atomic_store(&s_injected, false);
+    mpu6050_sim_set_write_callback(s_sim, inject_motion_on_cycle, NULL);
+
+    // 唤醒紧跟在进入 idle 之后，按统计而不是 idle 状态判断何时停止喂数据
+    mpu6050_acq_stats_t stats = {0};
+    for (int i = 0; i < 50 && 0 == stats.idle_entries; i++)
+    {
+        mpu6050_sim_advance(s_sim, SAMPLE_US);
+        usleep(SAMPLE_US);
+        TEST_ASSERT_ESP_OK(mpu6050_acq_get_stats(s_acq, &stats));
+    }
+    TEST_ASSERT_EQUAL_INT(1, stats.idle_entries);
+    TEST_ASSERT(atomic_load(&s_injected));
+
+    TEST_ASSERT(wait_idle_state(0, 500));
+    TEST_ASSERT_ESP_OK(mpu6050_acq_get_stats(s_acq, &stats));
+    TEST_ASSERT_EQUAL_INT(1, stats.idle_entries);
+    TEST_ASSERT_EQUAL_INT(1, stats.wakeups);
+    TEST_ASSERT_EQUAL_INT(MPU6050_DATA_RDY_INT_BIT, mpu6050_sim_peek(s_sim, REG_INT_ENABLE));
+}
+
+int main(void)
+{
+    RUN_TEST(test_idle_then_motion_wakes);
+    RUN_TEST(test_motion_while_arming_is_not_lost);
+    return TEST_END();
+}
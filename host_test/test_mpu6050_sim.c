@@ -0,0 +1,184 @@
+/**
+ * 未修改的 MPU6050 驱动经 i2c_bus_mgr 与 i2c_master 模拟层访问寄存器级模拟器：
+ * 突发读、FIFO 批量读取、INT_STATUS 清除方式以及 INT 引脚到 GPIO ISR 的路由。
+ */
+
+#include "driver/i2c_master.h"
+#include "mpu6050.h"
+#include "mpu6050_sim.h"
+#include "test_util.h"
+
+#define SIM_ADDR 0x68
+#define SIM_INT_GPIO 4
+#define SAMPLE_US 20000 // 1kHz 陀螺仪时钟 / 20
+
+static i2c_master_bus_handle_t s_bus;
+static mpu6050_sim_handle_t s_sim;
+static mpu6050_handle_t s_dev;
+
+static const mpu6050_acce_value_t k_acce = {.acce_x = 0.5f, .acce_y = -0.25f, .acce_z = 0.75f};
+static const mpu6050_gyro_value_t k_gyro = {.gyro_x = 10.0f, .gyro_y = -20.0f, .gyro_z = 30.0f};
+
+// 无噪声模拟器 + 已唤醒、±4g/±500°/s、50Hz 输出的驱动
+void setUp(void)
+{
+    const mpu6050_sim_config_t sim_cfg = {.address = SIM_ADDR, .temp_c = 25.0f};
+    s_sim = mpu6050_sim_create(&sim_cfg);
+    TEST_ASSERT(s_sim);
+    TEST_ASSERT_ESP_OK(mpu6050_sim_attach(s_sim));
+    mpu6050_sim_set_motion(s_sim, &k_acce, &k_gyro);
+
+    const i2c_master_bus_config_t bus_cfg = {.i2c_port = I2C_NUM_0};
+    TEST_ASSERT_ESP_OK(i2c_new_master_bus(&bus_cfg, &s_bus));
+    s_dev = mpu6050_create(s_bus, SIM_ADDR);
+    TEST_ASSERT(s_dev);
+    TEST_ASSERT_ESP_OK(mpu6050_config(s_dev, ACCE_FS_4G, GYRO_FS_500DPS));
+    const mpu6050_rate_config_t rate = {.dlpf = MPU6050_DLPF_21HZ, .odr_hz = 50};
+    TEST_ASSERT_ESP_OK(mpu6050_config_rate(s_dev, &rate, NULL));
+    TEST_ASSERT_ESP_OK(mpu6050_wake_up(s_dev));
+    mpu6050_sim_advance(s_sim, SAMPLE_US / 2); // 唤醒时刻的第一个采样
+}
+
+void tearDown(void)
+{
+    mpu6050_delete(s_dev);
+    s_dev = NULL;
+    if (s_bus)
+    {
+        i2c_del_master_bus(s_bus);
+        s_bus = NULL;
+    }
+    mpu6050_sim_delete(s_sim);
+    s_sim = NULL;
+}
+
+static void assert_raw_matches_motion(const mpu6050_raw_motion_value_t *raw)
+{
+    TEST_ASSERT_EQUAL_INT(4096, raw->raw_acce.raw_acce_x); // 0.5g × 8192
+    TEST_ASSERT_EQUAL_INT(-2048, raw->raw_acce.raw_acce_y);
+    TEST_ASSERT_EQUAL_INT(6144, raw->raw_acce.raw_acce_z);
+    TEST_ASSERT_EQUAL_INT(655, raw->raw_gyro.raw_gyro_x); // 10°/s × 65.5
+    TEST_ASSERT_EQUAL_INT(-1310, raw->raw_gyro.raw_gyro_y);
+    TEST_ASSERT_EQUAL_INT(1965, raw->raw_gyro.raw_gyro_z);
+}
+
+static void test_burst_read_round_trip(void)
+{
+    uint8_t id = 0;
+    TEST_ASSERT_ESP_OK(mpu6050_get_deviceid(s_dev, &id));
+    TEST_ASSERT_EQUAL_INT(0x68, id);
+
+    mpu6050_sim_advance(s_sim, SAMPLE_US);
+    mpu6050_sim_reset_stats(s_sim);
+
+    mpu6050_raw_motion_value_t raw;
+    TEST_ASSERT_ESP_OK(mpu6050_get_raw_motion(s_dev, &raw));
+    assert_raw_matches_motion(&raw);
+    TEST_ASSERT_EQUAL_INT((int16_t)((25.0f - 36.53f) * 340.0f), raw.raw_temp);
+
+    // 加速度、温度、角速度一次 14 字节的事务读完
+    mpu6050_sim_stats_t stats;
+    mpu6050_sim_get_stats(s_sim, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.read_transactions);
+    TEST_ASSERT_EQUAL_INT(0, stats.write_transactions);
+    TEST_ASSERT_EQUAL_INT(14, stats.bytes_read);
+
+    mpu6050_acce_value_t acce;
+    mpu6050_gyro_value_t gyro;
+    mpu6050_temp_value_t temp;
+    TEST_ASSERT_ESP_OK(mpu6050_convert_motion(s_dev, &raw, &acce, &gyro, &temp));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.5, acce.acce_x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2, -20.0, gyro.gyro_y);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 25.0, temp.temp);
+}
+
+static void test_fifo_drain(void)
+{
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_start(s_dev, MPU6050_FIFO_ALL_BITS));
+    mpu6050_sim_advance(s_sim, 10 * SAMPLE_US);
+    mpu6050_sim_reset_stats(s_sim);
+
+    mpu6050_raw_motion_value_t frames[16];
+    size_t n = 0;
+    TEST_ASSERT_ESP_OK(mpu6050_fifo_read_frames(s_dev, frames, 16, &n, NULL));
+    TEST_ASSERT_EQUAL_INT(10, n);
+    for (size_t i = 0; i < n; i++)
+    {
+        assert_raw_matches_motion(&frames[i]);
+    }
+
+    // FIFO_COUNT 一次，10 帧 × 14 字节一次
+    mpu6050_sim_stats_t stats;
+    mpu6050_sim_get_stats(s_sim, &stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.read_transactions);
+    TEST_ASSERT_EQUAL_INT(2 + 10 * 14, stats.bytes_read);
+    TEST_ASSERT_EQUAL_INT(0, mpu6050_sim_peek(s_sim, 0x73)); // FIFO_COUNTL
+}
+
+static void test_int_status_clear_on_any_read(void)
+{
+    const mpu6050_int_config_t int_cfg = {
+        .interrupt_pin = SIM_INT_GPIO,
+        .pin_mode = INTERRUPT_PIN_PUSH_PULL,
+        .interrupt_latch = INTERRUPT_LATCH_50US,
+        .active_level = INTERRUPT_PIN_ACTIVE_HIGH,
+        .interrupt_clear_behavior = INTERRUPT_CLEAR_ON_ANY_READ,
+    };
+    TEST_ASSERT_ESP_OK(mpu6050_config_interrupts(s_dev, &int_cfg));
+    TEST_ASSERT_ESP_OK(mpu6050_enable_interrupts(s_dev, MPU6050_DATA_RDY_INT_BIT));
+
+    // 读 INT_STATUS 本身能看到 DATA_RDY，读完即清除
+    uint8_t status = 0;
+    mpu6050_sim_advance(s_sim, SAMPLE_US);
+    TEST_ASSERT_ESP_OK(mpu6050_get_interrupt_status(s_dev, &status));
+    TEST_ASSERT(mpu6050_is_data_ready_interrupt(status));
+    TEST_ASSERT_ESP_OK(mpu6050_get_interrupt_status(s_dev, &status));
+    TEST_ASSERT_EQUAL_INT(0, status);
+
+    // 读数据寄存器同样会清除
+    mpu6050_raw_motion_value_t raw;
+    mpu6050_sim_advance(s_sim, SAMPLE_US);
+    TEST_ASSERT_ESP_OK(mpu6050_get_raw_motion(s_dev, &raw));
+    TEST_ASSERT_ESP_OK(mpu6050_get_interrupt_status(s_dev, &status));
+    TEST_ASSERT_EQUAL_INT(0, status);
+}
+
+static int s_isr_calls;
+
+static void count_isr(void *arg)
+{
+    s_isr_calls++;
+}
+
+static void test_int_pin_drives_gpio_isr(void)
+{
+    const mpu6050_int_config_t int_cfg = {
+        .interrupt_pin = SIM_INT_GPIO,
+        .interrupt_clear_behavior = INTERRUPT_CLEAR_ON_ANY_READ,
+    };
+    TEST_ASSERT_ESP_OK(mpu6050_config_interrupts(s_dev, &int_cfg));
+    TEST_ASSERT_ESP_OK(gpio_install_isr_service(0));
+    TEST_ASSERT_ESP_OK(mpu6050_register_isr(s_dev, count_isr));
+    mpu6050_sim_set_int_gpio(s_sim, SIM_INT_GPIO);
+
+    // 未使能 DATA_RDY 时没有脉冲
+    s_isr_calls = 0;
+    mpu6050_sim_advance(s_sim, 3 * SAMPLE_US);
+    TEST_ASSERT_EQUAL_INT(0, s_isr_calls);
+
+    TEST_ASSERT_ESP_OK(mpu6050_enable_interrupts(s_dev, MPU6050_DATA_RDY_INT_BIT));
+    mpu6050_sim_advance(s_sim, 5 * SAMPLE_US);
+    TEST_ASSERT_EQUAL_INT(5, s_isr_calls);
+
+    gpio_isr_handler_remove(SIM_INT_GPIO);
+    mpu6050_sim_set_int_gpio(s_sim, GPIO_NUM_NC);
+}
+
+int main(void)
+{
+    RUN_TEST(test_burst_read_round_trip);
+    RUN_TEST(test_fifo_drain);
+    RUN_TEST(test_int_status_clear_on_any_read);
+    RUN_TEST(test_int_pin_drives_gpio_isr);
+    return TEST_END();
+}
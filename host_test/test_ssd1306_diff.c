@@ -0,0 +1,199 @@
+/**
+ * ssd1306 差分刷新的线上字节数：首帧整屏发送；只改一个数字时只发送该字符的几列；
+ * 清屏后重画相同内容不发送任何数据。对照组为不开差分时清屏重画整屏重发。
+ * 测试自己提供 ssd1306_bind_i2c()，装上计数用的总线虚函数表，并按控制器的水平寻址模式
+ * 把数据写进一块模拟的显存，每次刷新后与帧缓冲区比较。
+ */
+
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_font.h"
+#include "ssd1306_private.h"
+#include "test_util.h"
+
+#define WIDTH 128
+#define HEIGHT 64
+#define PAGES (HEIGHT / 8)
+#define FB_BYTES (WIDTH * PAGES)
+#define TX_OVERHEAD 2 // 每个事务的地址字节与控制字节
+
+typedef struct
+{
+    int cmd_tx;
+    int data_tx;
+    size_t payload;
+    size_t wire;
+    uint8_t panel[FB_BYTES];
+    int col0, col1, page0, page1; // 当前窗口
+    int col, page;                // 写指针
+} counting_bus_t;
+
+static counting_bus_t s_bus;
+
+static esp_err_t count_cmd(void *ctx, const uint8_t *cmd, size_t n)
+{
+    counting_bus_t *b = ctx;
+    b->cmd_tx++;
+    b->wire += n + TX_OVERHEAD;
+    // set_window()：COLUMNADDR + PAGEADDR，写指针回到窗口起点
+    if (6 == n && 0x21 == cmd[0] && 0x22 == cmd[3])
+    {
+        b->col = b->col0 = cmd[1];
+        b->col1 = cmd[2];
+        b->page = b->page0 = cmd[4];
+        b->page1 = cmd[5];
+    }
+    return ESP_OK;
+}
+
+static esp_err_t count_data(void *ctx, const uint8_t *data, size_t n)
+{
+    counting_bus_t *b = ctx;
+    b->data_tx++;
+    b->payload += n;
+    b->wire += n + TX_OVERHEAD;
+    for (size_t i = 0; i < n; i++)
+    {
+        b->panel[b->page * WIDTH + b->col] = data[i];
+        if (++b->col > b->col1)
+        {
+            b->col = b->col0;
+            b->page = b->page < b->page1 ? b->page + 1 : b->page0;
+        }
+    }
+    return ESP_OK;
+}
+
+static const ssd1306_bus_vt_t s_counting_vt = {
+    .send_cmd = count_cmd,
+    .send_data = count_data,
+    .reset = NULL,
+};
+
+esp_err_t ssd1306_bind_i2c(i2c_master_bus_handle_t bus, struct ssd1306_t *d, i2c_port_num_t port,
+                           uint8_t addr, gpio_num_t rst_gpio, bool zero_copy, uint16_t max_chunk)
+{
+    d->vt = &s_counting_vt;
+    d->bus_ctx = &s_bus;
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_unbind_i2c(struct ssd1306_t *d)
+{
+    d->vt = NULL;
+    d->bus_ctx = NULL;
+    return ESP_OK;
+}
+
+static ssd1306_handle_t s_disp;
+
+static void open_display(bool diff_flush)
+{
+    const ssd1306_config_t cfg = {
+        .width = WIDTH,
+        .height = HEIGHT,
+        .port = I2C_NUM_0,
+        .rst_gpio = GPIO_NUM_NC,
+        .addr = 0x3C,
+        .diff_flush = diff_flush,
+    };
+    TEST_ASSERT_ESP_OK(ssd1306_connect_i2c(NULL, &cfg, &s_disp));
+}
+
+void setUp(void)
+{
+    memset(&s_bus, 0, sizeof(s_bus));
+    s_disp = NULL;
+}
+
+void tearDown(void)
+{
+    if (s_disp)
+    {
+        ssd1306_del(s_disp);
+    }
+}
+
+static void reset_counters(void)
+{
+    s_bus.cmd_tx = s_bus.data_tx = 0;
+    s_bus.payload = s_bus.wire = 0;
+}
+
+// 刷新一帧，检查显存与帧缓冲区一致，返回线上字节数
+static size_t display(void)
+{
+    reset_counters();
+    TEST_ASSERT_ESP_OK(ssd1306_display(s_disp));
+    TEST_ASSERT(0 == memcmp(s_bus.panel, s_disp->fb, FB_BYTES));
+    return s_bus.wire;
+}
+
+// 典型的状态页：边框、标题、时间与一个进度条
+static void draw_ui(const char *clock, int progress)
+{
+    TEST_ASSERT_ESP_OK(ssd1306_clear(s_disp));
+    TEST_ASSERT_ESP_OK(ssd1306_draw_rect(s_disp, 0, 0, WIDTH, HEIGHT, false));
+    TEST_ASSERT_ESP_OK(ssd1306_draw_text(s_disp, 4, 4, "SR-NB CAR", true));
+    TEST_ASSERT_ESP_OK(ssd1306_draw_text(s_disp, 4, 16, clock, true)); // 整个落在第 2 页
+    TEST_ASSERT_ESP_OK(ssd1306_draw_rect(s_disp, 4, 40, progress, 8, true));
+}
+
+static void test_first_frame_sends_everything(void)
+{
+    open_display(true);
+    draw_ui("12:34", 60);
+    // 影子缓冲区无效，整屏一个窗口
+    TEST_ASSERT_EQUAL_INT(6 + TX_OVERHEAD + FB_BYTES + TX_OVERHEAD, display());
+    TEST_ASSERT_EQUAL_INT(1, s_bus.cmd_tx);
+    TEST_ASSERT_EQUAL_INT(FB_BYTES, s_bus.payload);
+}
+
+static void test_one_digit_changed(void)
+{
+    open_display(true);
+    draw_ui("12:34", 60);
+    display();
+
+    draw_ui("12:35", 60);
+    const size_t wire = display();
+    // 只有最后一个字符的几列：一个窗口，负载不超过字宽
+    TEST_ASSERT_EQUAL_INT(1, s_bus.cmd_tx);
+    TEST_ASSERT_EQUAL_INT(1, s_bus.data_tx);
+    TEST_ASSERT(s_bus.payload > 0 && s_bus.payload <= ssd1306_font5x7.width);
+    TEST_ASSERT(wire <= 6 + TX_OVERHEAD + ssd1306_font5x7.width + TX_OVERHEAD);
+}
+
+static void test_identical_redraw_sends_nothing(void)
+{
+    open_display(true);
+    draw_ui("12:34", 60);
+    display();
+
+    // clear 把整屏标脏，但内容与面板相同
+    draw_ui("12:34", 60);
+    TEST_ASSERT_EQUAL_INT(0, display());
+    TEST_ASSERT_EQUAL_INT(0, s_bus.cmd_tx + s_bus.data_tx);
+}
+
+static void test_without_diff_redraw_resends_screen(void)
+{
+    open_display(false);
+    draw_ui("12:34", 60);
+    display();
+
+    draw_ui("12:34", 60);
+    const size_t wire = display();
+    TEST_ASSERT_EQUAL_INT(FB_BYTES, s_bus.payload);
+    TEST_ASSERT(wire >= FB_BYTES + 6 + 2 * TX_OVERHEAD);
+}
+
+int main(void)
+{
+    RUN_TEST(test_first_frame_sends_everything);
+    RUN_TEST(test_one_digit_changed);
+    RUN_TEST(test_identical_redraw_sends_nothing);
+    RUN_TEST(test_without_diff_redraw_resends_screen);
+    return TEST_END();
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @brief 主机测试的断言与计时工具
+ *
+ * 用法与 Unity 相同：每个测试程序定义 setUp()/tearDown()，把若干 static void test_xxx(void)
+ * 交给 RUN_TEST()，main 返回 TEST_END()。断言失败只结束当前用例，tearDown() 仍会执行，
+ * 其余用例继续。
+ */
+
+#pragma once
+
+#include <math.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static int s_test_failures __attribute__((unused));
+static jmp_buf s_test_abort __attribute__((unused));
+
+#define TEST_FAIL_MSG(...)                                          \
+    do                                                              \
+    {                                                               \
+        fprintf(stderr, "%s:%d: ", __FILE__, __LINE__);             \
+        fprintf(stderr, __VA_ARGS__);                               \
+        fprintf(stderr, "\n");                                      \
+        longjmp(s_test_abort, 1);                                   \
+    } while (0)
+
+#define TEST_ASSERT(cond)                                           \
+    do                                                              \
+    {                                                               \
+        if (!(cond))                                                \
+            TEST_FAIL_MSG("assertion failed: %s", #cond);           \
+    } while (0)
+
+#define TEST_ASSERT_EQUAL_INT(expected, actual)                                             \
+    do                                                                                      \
+    {                                                                                       \
+        const long long e_ = (long long)(expected), a_ = (long long)(actual);               \
+        if (e_ != a_)                                                                       \
+            TEST_FAIL_MSG("%s: expected %lld, got %lld", #actual, e_, a_);                  \
+    } while (0)
+
+#define TEST_ASSERT_FLOAT_WITHIN(delta, expected, actual)                                   \
+    do                                                                                      \
+    {                                                                                       \
+        const double e_ = (expected), a_ = (actual);                                        \
+        if (!(fabs(e_ - a_) <= (delta)))                                                    \
+            TEST_FAIL_MSG("%s: expected %g +/- %g, got %g", #actual, e_, (double)(delta), a_); \
+    } while (0)
+
+#define TEST_ASSERT_ESP_OK(x) TEST_ASSERT_EQUAL_INT(ESP_OK, (x))
+
+void setUp(void);
+void tearDown(void);
+
+#define RUN_TEST(fn)                                  \
+    do                                                \
+    {                                                 \
+        if (0 == setjmp(s_test_abort))                \
+        {                                             \
+            setUp();                                  \
+            fn();                                     \
+            printf("PASS %s\n", #fn);                 \
+        }                                             \
+        else                                          \
+        {                                             \
+            s_test_failures++;                        \
+            printf("FAIL %s\n", #fn);                 \
+        }                                             \
+        tearDown();                                   \
+    } while (0)
+
+#define TEST_END() (s_test_failures ? 1 : 0)
+
+// 基准计时（纳秒，单调时钟）
+static inline int64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// 防止被测结果被优化掉
+static volatile uint32_t s_bench_sink;
+#define BENCH_SINK(x) (s_bench_sink += (uint32_t)(x))
@@ -0,0 +1,136 @@
+/**
+ * vibration 对已知单频信号的分析结果：主频所在的频点、幅值、RMS 与频带能量。
+ * 覆盖大幅值（块浮点右移）与微小振动（左移）两种归一化方向，以及分级执行与一次做完结果一致。
+ * 主机工程对本组件开启了 -fsanitize=shift，移位量为负时测试直接失败。
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "test_util.h"
+#include "vibration.h"
+
+#define FS_HZ 1000.0f
+#define SENS 8192.0f // ±4g
+#define BIN_HZ (FS_HZ / VIB_FFT_SIZE)
+
+static vib_handle_t s_vib;
+
+static const vib_config_t s_config = {
+    .sample_rate_hz = FS_HZ,
+    .acce_sensitivity = SENS,
+    .axis = VIB_AXIS_Z,
+    .band_count = 3,
+    .band_edges_hz = {0.0f, 40.0f, 100.0f, 500.0f},
+};
+
+void setUp(void)
+{
+    s_vib = vib_create(&s_config);
+    TEST_ASSERT(s_vib);
+}
+
+void tearDown(void)
+{
+    vib_delete(s_vib);
+    s_vib = NULL;
+}
+
+// 在 Z 轴 1g 重力上叠加单频振动，送入一整窗
+static void push_tone(float freq_hz, float amp_g)
+{
+    mpu6050_sample_t samples[VIB_FFT_SIZE];
+    memset(samples, 0, sizeof(samples));
+    for (int n = 0; n < VIB_FFT_SIZE; n++)
+    {
+        const float g = 1.0f + amp_g * sinf(2.0f * (float)M_PI * freq_hz * n / FS_HZ);
+        samples[n].timestamp_us = n * 1000;
+        samples[n].raw.raw_acce.raw_acce_z = (int16_t)lroundf(g * SENS);
+        samples[n].raw.raw_acce.raw_acce_x = 1000; // 其他轴不参与
+    }
+    TEST_ASSERT_ESP_OK(vib_push(s_vib, samples, VIB_FFT_SIZE));
+}
+
+static void process_all(vib_result_t *out)
+{
+    bool ready = false;
+    TEST_ASSERT_ESP_OK(vib_process(s_vib, VIB_FFT_STAGES, &ready));
+    TEST_ASSERT(ready);
+    TEST_ASSERT_ESP_OK(vib_get_result(s_vib, out));
+}
+
+static void test_loud_tone_on_bin(void)
+{
+    // 第 20 个频点（78.125Hz），0.9g 时加窗后的峰值超过 2^14，归一化需要右移
+    push_tone(20 * BIN_HZ, 0.9f);
+    vib_result_t r;
+    process_all(&r);
+
+    TEST_ASSERT_EQUAL_INT(1, r.seq);
+    TEST_ASSERT_EQUAL_INT(255000, r.timestamp_us);
+    TEST_ASSERT_FLOAT_WITHIN(0.1 * BIN_HZ, 20 * BIN_HZ, r.dominant_hz);
+    TEST_ASSERT_FLOAT_WITHIN(0.02 * 0.9, 0.9, r.dominant_amp_g);
+    TEST_ASSERT_FLOAT_WITHIN(0.02 * 0.9 / M_SQRT2, 0.9 / M_SQRT2, r.rms_g);
+    // 能量几乎全部落在 [40, 100) Hz
+    TEST_ASSERT(r.band_energy[1] > 0.98f * r.rms_g * r.rms_g);
+    TEST_ASSERT(r.band_energy[0] < 0.001f * r.band_energy[1]);
+}
+
+static void test_quiet_tone_between_bins(void)
+{
+    // 2mg（16 LSB）的微小振动，归一化需要左移；频率落在两个频点之间
+    push_tone(50.0f, 0.002f);
+    vib_result_t r;
+    process_all(&r);
+
+    TEST_ASSERT_EQUAL_INT(13, (int)lroundf(50.0f / BIN_HZ));
+    TEST_ASSERT_FLOAT_WITHIN(0.25 * BIN_HZ, 50.0, r.dominant_hz);
+    // 偏离频点中心时 Hann 窗的扇贝损失约 5%，再加上 1 LSB 的量化
+    TEST_ASSERT_FLOAT_WITHIN(0.15 * 0.002, 0.002, r.dominant_amp_g);
+    TEST_ASSERT_FLOAT_WITHIN(0.1 * 0.002 / M_SQRT2, 0.002 / M_SQRT2, r.rms_g);
+    TEST_ASSERT(r.band_energy[1] > 0.9f * r.rms_g * r.rms_g);
+}
+
+static void test_staged_matches_single_call(void)
+{
+    push_tone(123.0f, 0.3f);
+    vib_result_t once;
+    process_all(&once);
+
+    // 同一窗口每次只做一级
+    vib_delete(s_vib);
+    s_vib = vib_create(&s_config);
+    TEST_ASSERT(s_vib);
+    push_tone(123.0f, 0.3f);
+    bool ready = false;
+    for (int i = 0; i < VIB_FFT_STAGES; i++)
+    {
+        TEST_ASSERT(!ready);
+        TEST_ASSERT_ESP_OK(vib_process(s_vib, 1, &ready));
+    }
+    TEST_ASSERT(ready);
+    vib_result_t staged;
+    TEST_ASSERT_ESP_OK(vib_get_result(s_vib, &staged));
+    TEST_ASSERT(once.dominant_hz == staged.dominant_hz);
+    TEST_ASSERT(once.dominant_amp_g == staged.dominant_amp_g);
+    TEST_ASSERT(once.rms_g == staged.rms_g);
+    TEST_ASSERT_FLOAT_WITHIN(0.1 * BIN_HZ, 123.0, staged.dominant_hz);
+}
+
+static void test_flat_window_has_no_tone(void)
+{
+    push_tone(50.0f, 0.0f);
+    vib_result_t r;
+    process_all(&r);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.0, r.rms_g);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.0, r.dominant_amp_g);
+}
+
+int main(void)
+{
+    RUN_TEST(test_loud_tone_on_bin);
+    RUN_TEST(test_quiet_tone_between_bins);
+    RUN_TEST(test_staged_matches_single_call);
+    RUN_TEST(test_flat_window_has_no_tone);
+    return TEST_END();
+}
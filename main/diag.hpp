@@ -0,0 +1,112 @@
+#include <math.h>
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "ahrs.h"
+#include "mpu6050.h"
+
+// ================== 板上诊断 ==================
+#if CONFIG_APP_AHRS_CYCLE_BENCH
+
+#define CYCLE_BENCH_SAMPLES 1000
+#define CYCLE_BENCH_DT_US 1000
+
+typedef struct
+{
+    uint32_t min;
+    uint64_t total;
+} cycle_stat_t;
+
+static mpu6050_acce_value_t cycle_bench_acce[CYCLE_BENCH_SAMPLES];
+static mpu6050_gyro_value_t cycle_bench_gyro[CYCLE_BENCH_SAMPLES];
+
+static void cycle_stat_add(cycle_stat_t *stat, uint32_t cycles)
+{
+    stat->min = cycles < stat->min ? cycles : stat->min;
+    stat->total += cycles;
+}
+
+static void cycle_stat_log(const char *name, const cycle_stat_t *stat, uint32_t overhead)
+{
+    const uint32_t avg = (uint32_t)(stat->total / CYCLE_BENCH_SAMPLES);
+    ESP_LOGI("CYCLES", "%-10s avg %5lu  min %5lu cycles/update", name, (unsigned long)(avg - overhead),
+             (unsigned long)(stat->min - overhead));
+}
+
+// 输入与 host_test/bench_ahrs.c 相同：带噪声的小幅摆动，1 kHz
+static void cycle_bench_fill(void)
+{
+    for (int k = 0; k < CYCLE_BENCH_SAMPLES; k++)
+    {
+        const float t = k * (CYCLE_BENCH_DT_US * 1e-6f);
+        cycle_bench_acce[k].acce_x = 0.1f * sinf(2 * (float)M_PI * 3 * t);
+        cycle_bench_acce[k].acce_y = 0.2f * cosf(2 * (float)M_PI * 2 * t);
+        cycle_bench_acce[k].acce_z = 0.97f;
+        cycle_bench_gyro[k].gyro_x = 15.0f * cosf(2 * (float)M_PI * 3 * t);
+        cycle_bench_gyro[k].gyro_y = -10.0f * sinf(2 * (float)M_PI * 2 * t);
+        cycle_bench_gyro[k].gyro_z = 0.5f;
+    }
+}
+
+static void cycle_bench_ahrs(const char *name, const ahrs_config_t *cfg, uint32_t overhead)
+{
+    ahrs_handle_t ahrs = ahrs_create(cfg);
+    if (!ahrs)
+    {
+        ESP_LOGE("CYCLES", "ahrs_create failed");
+        return;
+    }
+    cycle_stat_t stat = {.min = UINT32_MAX};
+    for (int k = 0; k < CYCLE_BENCH_SAMPLES; k++)
+    {
+        const uint32_t c0 = esp_cpu_get_cycle_count();
+        ahrs_update(ahrs, &cycle_bench_acce[k], &cycle_bench_gyro[k], CYCLE_BENCH_DT_US * 1e-6f);
+        cycle_stat_add(&stat, esp_cpu_get_cycle_count() - c0);
+    }
+    ahrs_delete(ahrs);
+    cycle_stat_log(name, &stat, overhead);
+}
+
+static void cycle_bench_filter(uint32_t overhead)
+{
+    mpu6050_handle_t sensor = mpu6050_create(NULL, 0); // 离线句柄，只用滤波器状态
+    if (!sensor)
+    {
+        ESP_LOGE("CYCLES", "mpu6050_create failed");
+        return;
+    }
+    complimentary_angle_t angle = {0};
+    cycle_stat_t stat = {.min = UINT32_MAX};
+    for (int k = 0; k < CYCLE_BENCH_SAMPLES; k++)
+    {
+        const int64_t ts = (int64_t)(k + 1) * CYCLE_BENCH_DT_US;
+        const uint32_t c0 = esp_cpu_get_cycle_count();
+        mpu6050_complimentory_filter(sensor, &cycle_bench_acce[k], &cycle_bench_gyro[k], ts, &angle);
+        cycle_stat_add(&stat, esp_cpu_get_cycle_count() - c0);
+    }
+    mpu6050_delete(sensor);
+    cycle_stat_log("cf", &stat, overhead);
+}
+
+// 在创建任务之前运行，避免被其他任务抢占；中断仍可能拉高平均值，min 更接近纯计算开销
+static void ahrs_cycle_bench(void)
+{
+    cycle_bench_fill();
+
+    // 两次读取周期计数本身的开销，从结果中扣除
+    uint32_t overhead = UINT32_MAX;
+    for (int i = 0; i < 16; i++)
+    {
+        const uint32_t c0 = esp_cpu_get_cycle_count();
+        const uint32_t c1 = esp_cpu_get_cycle_count();
+        overhead = (c1 - c0) < overhead ? (c1 - c0) : overhead;
+    }
+
+    ESP_LOGI("CYCLES", "%d updates each, counter overhead %lu cycles", CYCLE_BENCH_SAMPLES, (unsigned long)overhead);
+    const ahrs_config_t madgwick = {.algorithm = AHRS_ALGO_MADGWICK, .beta = 0.05f};
+    const ahrs_config_t mahony = {.algorithm = AHRS_ALGO_MAHONY, .kp = 1.0f, .ki = 0.01f};
+    cycle_bench_ahrs("madgwick", &madgwick, overhead);
+    cycle_bench_ahrs("mahony", &mahony, overhead);
+    cycle_bench_filter(overhead);
+}
+
+#endif /* CONFIG_APP_AHRS_CYCLE_BENCH */
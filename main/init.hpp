@@ -3,8 +3,16 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/i2c_master.h"
+#include "i2c_bus_mgr.h"
 #include "esp_log.h"
 #include "mpu6050.h"
+#include "mpu6050_acq.h"
+#include "mpu6050_group.h"
+#include "mpu6050_calib.h"
+#include "nvs_flash.h"
+#include "imu_snapshot.h"
+#include "imu_ring.h"
+#include "vibration.h"
 #include "ssd1306.h"
 #include "bottom.h"
 #include "ws2812_rmt.h"
@@ -18,19 +26,27 @@
 #define I2C_MASTER_SDA_IO 21     // I2C 数据线 SDA 连接到 GPIO21
 #define I2C_MASTER_NUM I2C_NUM_0 // 使用 I2C 控制器 0
 #define MPU6050_I2C_ADDRESS 0x68u
+#define MPU6050_REAR_I2C_ADDRESS 0x69u // 后轴 IMU（AD0 接高），未焊接时自动跳过
+#define MPU6050_ODR_HZ 50u // MPU6050 输出数据率，与采样消费速率一致，避免过采样占用总线
+#define MPU6050_INT_PIN GPIO_NUM_NC // MPU6050 INT 引脚，接线后填写 GPIO 号即改用 DATA_RDY 中断采集
 #define SSD1306_I2C_ADDRESS 0x3C
+#define I2C_BUS_LOG_PERIOD_MS 10000u // 总线占用统计打印周期
 static i2c_master_bus_handle_t i2c_bus = NULL; // 总线句柄
 static mpu6050_handle_t mpu6050 = NULL;
+static mpu6050_acq_handle_t mpu6050_acq = NULL;
+static mpu6050_handle_t mpu6050_rear = NULL;          // 后轴 IMU，不存在时为 NULL
+static mpu6050_group_handle_t mpu6050_group = NULL;    // 前后轴同步采样
 static ssd1306_handle_t oled = NULL;
 static bottom_handle_t left_bottom = NULL;
 static bottom_handle_t right_bottom = NULL;
 
 // ================== 全局状态 ==================
 
-mpu6050_acce_value_t mpu6050_acce;
-mpu6050_gyro_value_t mpu6050_gyro;
-complimentary_angle_t mpu6050_angle = {0}; // 初始化为0
-mpu6050_temp_value_t mpu6050_temp;
+complimentary_angle_t mpu6050_angle = {0};                     // 滤波器状态，仅采样任务访问
+complimentary_angle_t mpu6050_rear_angle = {0};                // 后轴滤波器状态
+static imu_snapshot_channel_t imu_state = IMU_SNAPSHOT_CHANNEL_INIT; // 采样任务发布，显示等任务无锁读取
+static imu_ring_t imu_ring = IMU_RING_INIT;                          // 完整采样流，各消费者用独立游标读取
+static imu_snapshot_channel_t imu_rear_state = IMU_SNAPSHOT_CHANNEL_INIT; // 后轴 IMU 状态
 
 // 从 ESP-IDF 5.0 开始，I²C 要先“安装总线”拿到一条
 // i2c_master_bus_handle_t，再往这条总线上“挂设备”
@@ -45,13 +61,78 @@ static void i2c_bus_init(void)
         .flags.enable_internal_pullup = true,
     };
     i2c_new_master_bus(&bus_cfg, &i2c_bus);
+    // 各设备的事务数、字节数与占用率，用于判断显示刷新是否挤占 IMU 读取
+    i2c_mgr_start_log(I2C_BUS_LOG_PERIOD_MS);
+}
+
+// NVS 保存标定结果
+static void nvs_init(void)
+{
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND)
+    {
+        nvs_flash_erase();
+        err = nvs_flash_init();
+    }
+    if (err != ESP_OK)
+        ESP_LOGE("NVS", "init failed: %s", esp_err_to_name(err));
+}
+
+// 优先使用 NVS 中保存的零偏；没有时上电静止标定一次并保存，之后启动不再等待
+static void mpu6050_load_or_calibrate(mpu6050_handle_t sensor, const char *key)
+{
+    const mpu6050_calib_store_t *store = mpu6050_calib_nvs_store();
+    mpu6050_calib_t calib;
+    if (mpu6050_calib_load(store, key, &calib) == ESP_OK &&
+        mpu6050_set_calibration(sensor, &calib) == ESP_OK)
+        return;
+
+    mpu6050_calib_config_t calib_cfg = {
+        .samples = 128, // 50Hz 下约 2.6s
+        .gravity = MPU6050_CALIB_GRAVITY_Z_POS,
+        .max_gyro_spread_dps = 3.0f,
+        .write_hw_offsets = false,
+    };
+    if (mpu6050_calibrate(sensor, &calib_cfg, &calib) == ESP_OK)
+        mpu6050_calib_save(store, key, &calib);
+    else
+        ESP_LOGW("MPU6050", "%s calibration skipped", key);
+}
+
+// 按统一的量程与输出率配置一个 MPU6050
+static void mpu6050_apply_config(mpu6050_handle_t sensor)
+{
+    mpu6050_config(sensor, ACCE_FS_4G, GYRO_FS_500DPS);
+    // 低通带宽取在奈奎斯特频率（ODR/2）以下
+    mpu6050_rate_config_t rate_cfg = {
+        .dlpf = MPU6050_DLPF_21HZ,
+        .odr_hz = MPU6050_ODR_HZ,
+    };
+    float odr_hz = 0;
+    if (mpu6050_config_rate(sensor, &rate_cfg, &odr_hz) == ESP_OK)
+        ESP_LOGI("MPU6050", "ODR %.1f Hz", odr_hz);
+    mpu6050_wake_up(sensor);
 }
 
 static void i2c_sensor_mpu6050_init(void)
 {
     mpu6050 = mpu6050_create(i2c_bus, MPU6050_I2C_ADDRESS);
-    mpu6050_config(mpu6050, ACCE_FS_4G, GYRO_FS_500DPS);
-    mpu6050_wake_up(mpu6050);
+    mpu6050_apply_config(mpu6050);
+    mpu6050_load_or_calibrate(mpu6050, "imu_front");
+
+    // 后轴 IMU 可选：读不到 WHO_AM_I 说明没有接
+    uint8_t id = 0;
+    mpu6050_rear = mpu6050_create(i2c_bus, MPU6050_REAR_I2C_ADDRESS);
+    if (mpu6050_rear && mpu6050_get_deviceid(mpu6050_rear, &id) != ESP_OK)
+    {
+        mpu6050_delete(mpu6050_rear);
+        mpu6050_rear = NULL;
+    }
+    if (mpu6050_rear)
+    {
+        mpu6050_apply_config(mpu6050_rear);
+        mpu6050_load_or_calibrate(mpu6050_rear, "imu_rear");
+    }
 }
 
 static void i2c_sensor_ssd1306_init(void)
@@ -67,6 +148,10 @@ static void i2c_sensor_ssd1306_init(void)
         .port = I2C_NUM_0,
         .addr = SSD1306_I2C_ADDRESS, // typical SSD1306 I2C address
         .rst_gpio = GPIO_NUM_NC,     // no reset pin
+        .diff_flush = true,          // UI 每帧清屏重画，只发送实际变化的字节
+        .i2c_zero_copy = true,
+        .i2c_max_chunk = 64, // 64 字节约 1.5ms，IMU 读取最多等这么久
+        .async_flush = true, // 发送上一帧时即可绘制下一帧
     };
     ssd1306_connect_i2c(i2c_bus, &cfg, &oled);
 }
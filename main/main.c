@@ -1,20 +1,27 @@
 #include <stdio.h>
 #include "task.hpp"
+#include "diag.hpp"
 
 // ================== 主程序入口 ==================
 void app_main(void)
 {
     // 初始化
+    nvs_init();
     i2c_bus_init();
     i2c_sensor_mpu6050_init();
     i2c_sensor_ssd1306_init();
     bottom_init();
     RGB_init();
+#if CONFIG_APP_AHRS_CYCLE_BENCH
+    ahrs_cycle_bench();
+#endif
     // // //任务函数
-    xTaskCreate(task_mpu6050GetParam, "mpu6050_task", 2048, NULL, 5, NULL);
+    if (!mpu6050_group_acquisition_start() && !mpu6050_acquisition_start())
+        xTaskCreate(task_mpu6050GetParam, "mpu6050_task", 2048, NULL, 5, NULL);
     // xTaskCreate(task_oledDisplay_mpu6050, "oled_test_task", 2048, NULL, 5, NULL);
     // xTaskCreate(task_ssd1306_animator, "oled_test_task", 2048, NULL, 5, NULL);
     xTaskCreate(bottom_driver_task, "oled_test_task", 2048, NULL, 5, NULL);
     xTaskCreate(task_oled_display_fancy_ui_enhanced, "oled_test_task", 2048, NULL, 5, NULL);
+    xTaskCreate(task_vibration, "vibration_task", 4096, NULL, 3, NULL);
     xTaskCreate(RGB_task, "oled_test_task", 2048, NULL, 5, NULL);
 }
\ No newline at end of file
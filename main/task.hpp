@@ -2,17 +2,171 @@
 #include <math.h>
 
 // ================== 任务函数 ==================
+// 解算姿态并发布快照，轮询与中断两种采集方式共用
+static void mpu6050_process_sample(const mpu6050_sample_t *sample)
+{
+    mpu6050_complimentory_filter(mpu6050, &sample->acce, &sample->gyro, sample->timestamp_us, &mpu6050_angle);
+
+    imu_snapshot_t snap = {
+        .timestamp_us = sample->timestamp_us,
+        .acce = sample->acce,
+        .gyro = sample->gyro,
+        .temp = sample->temp,
+        .angle = mpu6050_angle,
+    };
+    imu_snapshot_publish(&imu_state, &snap);
+    imu_ring_push(&imu_ring, sample);
+}
+
 void task_mpu6050GetParam(void *pvParameter)
 {
+    mpu6050_sample_t sample;
+
     while (1)
     {
-        // 读取原始传感器数据
-        mpu6050_get_acce(mpu6050, &mpu6050_acce);
-        mpu6050_get_gyro(mpu6050, &mpu6050_gyro);
-        mpu6050_get_temp(mpu6050, &mpu6050_temp);
-        mpu6050_complimentory_filter(mpu6050, &mpu6050_acce, &mpu6050_gyro, &mpu6050_angle);
+        // 读取带时间戳的传感器数据
+        if (mpu6050_get_sample(mpu6050, &sample) == ESP_OK)
+        {
+            mpu6050_process_sample(&sample);
+        }
         // ESP_LOGI("MPU6050", "Roll: %.3f°, Pitch: %.3f°", mpu6050_angle.roll, mpu6050_angle.pitch);
-        vTaskDelay(pdMS_TO_TICKS(20)); // 建议 ≤50ms，滤波需要高频采样
+        vTaskDelay(pdMS_TO_TICKS(1000 / MPU6050_ODR_HZ)); // 建议 ≤50ms，滤波需要高频采样
+    }
+}
+
+// DATA_RDY 中断采集回调，运行在采集任务中
+static void mpu6050_on_sample(const mpu6050_sample_t *sample, void *user_ctx)
+{
+    mpu6050_process_sample(sample);
+}
+
+// INT 引脚已接线时启动中断采集，返回 false 表示需退回 task_mpu6050GetParam 轮询
+static bool mpu6050_acquisition_start(void)
+{
+    if (MPU6050_INT_PIN == GPIO_NUM_NC)
+        return false;
+
+    mpu6050_acq_config_t acq_cfg = {
+        .int_config = {
+            .interrupt_pin = MPU6050_INT_PIN,
+            .active_level = INTERRUPT_PIN_ACTIVE_HIGH,
+            .pin_mode = INTERRUPT_PIN_PUSH_PULL,
+            .interrupt_latch = INTERRUPT_LATCH_50US,
+            .interrupt_clear_behavior = INTERRUPT_CLEAR_ON_ANY_READ,
+        },
+        .task_priority = 10, // 高于显示、按键等任务
+        .task_stack_size = 3072,
+        .core_id = tskNO_AFFINITY,
+        .on_sample = mpu6050_on_sample,
+        .user_ctx = NULL,
+        // 停车静止 5s 后进入 idle，空出 I2C 总线给显示；约 40mg 的晃动即可唤醒
+        .idle_after_ms = 5000,
+        .idle_gyro_dps = 2.0f,
+        .idle = {
+            .motion_threshold = 20,
+            .motion_duration = 1,
+            .wake_freq = MPU6050_LP_WAKE_5HZ,
+        },
+        .on_idle = NULL,
+    };
+    esp_err_t err = mpu6050_acq_start(mpu6050, &acq_cfg, &mpu6050_acq);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE("MPU6050", "DATA_RDY acquisition failed (%s), fallback to polling", esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+// 前后轴组采样回调：前轴沿用单传感器流水线，后轴单独解算并发布
+static void mpu6050_on_group_frame(const mpu6050_group_frame_t *frame, void *user_ctx)
+{
+    if (frame->valid_mask & BIT0)
+        mpu6050_process_sample(&frame->samples[0]);
+
+    if (frame->valid_mask & BIT1)
+    {
+        const mpu6050_sample_t *rear = &frame->samples[1];
+        mpu6050_complimentory_filter(mpu6050_rear, &rear->acce, &rear->gyro, rear->timestamp_us, &mpu6050_rear_angle);
+        imu_snapshot_t snap = {
+            .timestamp_us = rear->timestamp_us,
+            .acce = rear->acce,
+            .gyro = rear->gyro,
+            .temp = rear->temp,
+            .angle = mpu6050_rear_angle,
+        };
+        imu_snapshot_publish(&imu_rear_state, &snap);
+    }
+}
+
+// 后轴 IMU 存在时用组调度在同一时隙读取前后轴，返回 false 表示只有前轴
+static bool mpu6050_group_acquisition_start(void)
+{
+    if (mpu6050_rear == NULL)
+        return false;
+
+    const mpu6050_handle_t sensors[] = {mpu6050, mpu6050_rear};
+    mpu6050_group_config_t group_cfg = {
+        .sensors = sensors,
+        .sensor_count = 2,
+        .period_us = 1000000 / MPU6050_ODR_HZ,
+        .task_priority = 10, // 高于显示、按键等任务
+        .task_stack_size = 3072,
+        .core_id = tskNO_AFFINITY,
+        .on_frame = mpu6050_on_group_frame,
+        .user_ctx = NULL,
+    };
+    esp_err_t err = mpu6050_group_start(&group_cfg, &mpu6050_group);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE("MPU6050", "group acquisition failed (%s)", esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+// 车体振动分析：从采样环形缓冲区取数据，FFT 分级执行，不影响采集任务
+void task_vibration(void *arg)
+{
+    float acce_sensitivity = 0;
+    mpu6050_get_acce_sensitivity(mpu6050, &acce_sensitivity);
+    vib_config_t vib_cfg = {
+        .sample_rate_hz = MPU6050_ODR_HZ,
+        .acce_sensitivity = acce_sensitivity,
+        .axis = VIB_AXIS_Z,
+        .hop = VIB_FFT_SIZE / 2, // 50% 重叠
+        .band_count = 4,
+        .band_edges_hz = {0.5f, 2.0f, 5.0f, 10.0f, MPU6050_ODR_HZ / 2.0f},
+    };
+    vib_handle_t vib = vib_create(&vib_cfg);
+    if (vib == NULL)
+    {
+        ESP_LOGE("VIB", "create failed");
+        vTaskDelete(NULL);
+        return;
+    }
+
+    imu_ring_reader_t reader;
+    imu_ring_reader_init(&reader, &imu_ring);
+    mpu6050_sample_t batch[16];
+    while (1)
+    {
+        size_t n;
+        while ((n = imu_ring_read(&reader, batch, sizeof(batch) / sizeof(batch[0]))) > 0)
+            vib_push(vib, batch, n);
+
+        // 每轮只做两级蝶形运算，把一次变换分散到多个调度周期
+        bool ready = false;
+        vib_process(vib, 2, &ready);
+        if (ready)
+        {
+            vib_result_t res;
+            vib_get_result(vib, &res);
+            ESP_LOGI("VIB", "rms %.3fg, peak %.1fHz %.3fg, bands %.4f %.4f %.4f %.4f g^2",
+                     res.rms_g, res.dominant_hz, res.dominant_amp_g,
+                     res.band_energy[0], res.band_energy[1], res.band_energy[2], res.band_energy[3]);
+        }
+        vTaskDelay(pdMS_TO_TICKS(100));
     }
 }
 
@@ -47,31 +201,39 @@ void task_oled_display_fancy_ui_enhanced(void *pvParameter)
     char roll_str[16];
     char pitch_str[16];
     char temp_str[16];
+    imu_snapshot_t imu = {0};
 
     while (1)
     {
+        // 整帧绘制只取一次显示锁，期间使用 _nolock 接口
+        if (ssd1306_begin_frame(oled) != ESP_OK)
+        {
+            vTaskDelay(pdMS_TO_TICKS(20));
+            continue;
+        }
+
         // 1. 清除整个屏幕
-        ssd1306_clear(oled);
+        ssd1306_clear_nolock(oled);
 
         // 2. 绘制静态元素（每次循环都重新绘制）
         // 绘制标题和装饰线
-        ssd1306_draw_text(oled, 2, 4, "MPU6050", true);
-        ssd1306_draw_rect(oled, 0, 0, 127, 15, false);
+        ssd1306_draw_text_nolock(oled, 2, 4, "MPU6050", true);
+        ssd1306_draw_rect_nolock(oled, 0, 0, 127, 15, false);
 
         // 绘制区域分隔线
-        ssd1306_draw_line(oled, 68, 15, 68, 63, true); // 垂直线分隔左右
+        ssd1306_draw_line_nolock(oled, 68, 15, 68, 63, true); // 垂直线分隔左右
 
         // 左侧数值区域装饰
-        ssd1306_draw_rect(oled, 2, 17, 65, 50, false);
-        ssd1306_draw_text(oled, 5, 20, "Angle Data", true);
-        ssd1306_draw_line(oled, 5, 30, 55, 30, true); // 标题下划线
+        ssd1306_draw_rect_nolock(oled, 2, 17, 65, 50, false);
+        ssd1306_draw_text_nolock(oled, 5, 20, "Angle Data", true);
+        ssd1306_draw_line_nolock(oled, 5, 30, 55, 30, true); // 标题下划线
 
         // 绘制右侧静态水平仪元素
         // 绘制外圆
-        ssd1306_draw_circle(oled, center_x, center_y, outer_radius, false);
+        ssd1306_draw_circle_nolock(oled, center_x, center_y, outer_radius, false);
 
         // 绘制内圆网格
-        ssd1306_draw_circle(oled, center_x, center_y, inner_radius, false);
+        ssd1306_draw_circle_nolock(oled, center_x, center_y, inner_radius, false);
 
         // 绘制网格线
         for (int i = 0; i < 4; i++)
@@ -79,29 +241,29 @@ void task_oled_display_fancy_ui_enhanced(void *pvParameter)
             float angle = i * M_PI / 2.0f;
             int x1 = center_x + (int)(inner_radius * cos(angle));
             int y1 = center_y + (int)(inner_radius * sin(angle));
-            ssd1306_draw_line(oled, center_x, center_y, x1, y1, true);
+            ssd1306_draw_line_nolock(oled, center_x, center_y, x1, y1, true);
         }
 
         // 绘制中心参考点
-        ssd1306_draw_circle(oled, center_x, center_y, dot_radius, true);
+        ssd1306_draw_circle_nolock(oled, center_x, center_y, dot_radius, true);
 
-        // 3. 获取MPU6050数据并绘制动态元素
-        mpu6050_complimentory_filter(mpu6050, &mpu6050_acce, &mpu6050_gyro, &mpu6050_angle);
+        // 3. 获取MPU6050数据并绘制动态元素（姿态由采样任务解算，这里只读取一致的快照）
+        imu_snapshot_read(&imu_state, &imu);
 
         // 显示左侧数值
-        snprintf(roll_str, sizeof(roll_str), "Roll: %.1f", mpu6050_angle.roll);
-        snprintf(pitch_str, sizeof(pitch_str), "Pitch: %.1f", mpu6050_angle.pitch);
-        snprintf(temp_str, sizeof(temp_str), "Temp: %.1f", mpu6050_temp.temp / 340.0 + 36.53);
+        snprintf(roll_str, sizeof(roll_str), "Roll: %.1f", imu.angle.roll);
+        snprintf(pitch_str, sizeof(pitch_str), "Pitch: %.1f", imu.angle.pitch);
+        snprintf(temp_str, sizeof(temp_str), "Temp: %.1f", imu.temp.temp);
 
         // 显示新数据
-        ssd1306_draw_text(oled, 5, 33, roll_str, true);
-        ssd1306_draw_text(oled, 5, 43, pitch_str, true);
-        ssd1306_draw_text(oled, 5, 53, temp_str, true);
+        ssd1306_draw_text_nolock(oled, 5, 33, roll_str, true);
+        ssd1306_draw_text_nolock(oled, 5, 43, pitch_str, true);
+        ssd1306_draw_text_nolock(oled, 5, 53, temp_str, true);
 
         // 计算水平仪小球位置
         // 限制角度范围在±30度内
-        float limited_roll = mpu6050_angle.roll;
-        float limited_pitch = mpu6050_angle.pitch;
+        float limited_roll = imu.angle.roll;
+        float limited_pitch = imu.angle.pitch;
         if (limited_roll > 30.0f)
             limited_roll = 30.0f;
         if (limited_roll < -30.0f)
@@ -141,14 +303,16 @@ void task_oled_display_fancy_ui_enhanced(void *pvParameter)
                 int trail_size = 2 - (i / 2); // 递减大小
                 if (trail_size > 0)
                 {
-                    ssd1306_draw_circle(oled, history_x[idx], history_y[idx], trail_size, true);
+                    ssd1306_draw_circle_nolock(oled, history_x[idx], history_y[idx], trail_size, true);
                 }
             }
         }
 
         // 绘制当前小球
-        ssd1306_draw_circle(oled, ball_x, ball_y, dot_radius + 1, false); // 外圈
-        ssd1306_draw_circle(oled, ball_x, ball_y, dot_radius, true);      // 填充内圈
+        ssd1306_draw_circle_nolock(oled, ball_x, ball_y, dot_radius + 1, false); // 外圈
+        ssd1306_draw_circle_nolock(oled, ball_x, ball_y, dot_radius, true);      // 填充内圈
+
+        ssd1306_end_frame(oled);
 
         // 4. 刷新显示
         ssd1306_display(oled);